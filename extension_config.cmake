@@ -8,7 +8,8 @@ duckdb_extension_load(markdown
     # target_link_libraries / INTERFACE_LINK_LIBRARIES), so cmark-gfm must be listed
     # explicitly or the .wasm loads with stub imports that throw on first call (issue #19).
     # Order mirrors the native link (extensions depend on core, so core comes last).
-    LINKED_LIBS "$<TARGET_FILE:libcmark-gfm-extensions_static>;$<TARGET_FILE:libcmark-gfm_static>"
+    # md4c has no dependencies of its own and goes last.
+    LINKED_LIBS "$<TARGET_FILE:libcmark-gfm-extensions_static>;$<TARGET_FILE:libcmark-gfm_static>;$<TARGET_FILE:md4c::md4c>"
 )
 
 # Any extra extensions that should be built
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+namespace duckdb {
+
+/**
+ * @brief Transaction-paired progress log behind the readers' `checkpoint_file` option
+ *
+ * A checkpoint file lists, one path per line, the input files whose rows a
+ * read_markdown* scan emitted in full within a transaction that committed. A
+ * re-run with the same checkpoint file skips those files, so an interrupted
+ * `INSERT ... SELECT` resumes where its last commit left off. Completed files
+ * are staged per connection and only appended (and synced) once the
+ * transaction has committed, so the log never runs ahead of the target table;
+ * a rollback discards them.
+ */
+class MarkdownCheckpoint : public ClientContextState {
+public:
+	/**
+	 * @brief Drop files already recorded in a checkpoint file
+	 *
+	 * @param context Client context for file operations
+	 * @param checkpoint_file Checkpoint file (a missing file means nothing is complete yet)
+	 * @param batch_size Keep at most this many remaining files (0 = all)
+	 * @param files Sorted input files, filtered in place
+	 */
+	static void SkipCompleted(ClientContext &context, const string &checkpoint_file, idx_t batch_size,
+	                          vector<string> &files);
+
+	/**
+	 * @brief Record that every row of a file has been emitted
+	 *
+	 * The file is written to the checkpoint when the current transaction commits.
+	 *
+	 * @param context Client context of the scan
+	 * @param checkpoint_file Checkpoint file to append to
+	 * @param file_path Input file that was fully emitted
+	 */
+	static void MarkCompleted(ClientContext &context, const string &checkpoint_file, const string &file_path);
+
+	void TransactionCommit(MetaTransaction &transaction, ClientContext &context) override;
+	void TransactionRollback(MetaTransaction &transaction, ClientContext &context) override;
+	void QueryEnd(ClientContext &context) override;
+
+private:
+	//! Files recorded in a checkpoint file; a torn last line (no '\n') is ignored
+	static std::unordered_set<string> LoadCompleted(ClientContext &context, const string &checkpoint_file);
+
+	//! Append the committed files and sync each checkpoint file
+	void Flush(ClientContext &context);
+
+	std::mutex lock;
+	// checkpoint file -> files completed in the open transaction
+	std::map<string, vector<string>> staged;
+	// checkpoint file -> files whose transaction committed, not yet written
+	std::map<string, vector<string>> committed;
+};
+
+} // namespace duckdb
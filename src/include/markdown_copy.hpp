@@ -14,11 +14,13 @@ namespace duckdb {
 
 struct WriteMarkdownBindData : public FunctionData {
 	// Mode (explicit, no auto-detect)
-	enum class MarkdownMode { TABLE, DOCUMENT, BLOCKS };
+	enum class MarkdownMode { TABLE, DOCUMENT, BLOCKS, RAW };
 	MarkdownMode markdown_mode = MarkdownMode::TABLE;
 
 	// Common options
 	string null_value = "";
+	//! Output compression (AUTO_DETECT infers it from a .gz / .zst file extension)
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
 
 	// Table mode options
 	bool header = true;
@@ -42,6 +44,7 @@ struct WriteMarkdownBindData : public FunctionData {
 	// Resolved schema info
 	idx_t level_col_idx = DConstants::INVALID_INDEX;
 	idx_t title_col_idx = DConstants::INVALID_INDEX;
+	//! Raw mode writes this column (content_column, or the only column) verbatim, e.g. md_render() output
 	idx_t content_col_idx = DConstants::INVALID_INDEX;
 	// Blocks mode column indices
 	idx_t kind_col_idx = DConstants::INVALID_INDEX;
@@ -51,6 +54,9 @@ struct WriteMarkdownBindData : public FunctionData {
 	vector<string> alignments; // Per-column alignment for table mode
 	vector<string> column_names;
 	vector<LogicalType> column_types;
+	//! Sink writes a thread's buffer out once it holds this many bytes (0 = the default 1 MiB);
+	//! set from FILE_SIZE_BYTES so that buffering cannot run far past the rotation limit
+	idx_t flush_size = 0;
 
 public:
 	unique_ptr<FunctionData> Copy() const override;
@@ -70,6 +76,10 @@ struct WriteMarkdownGlobalState : public GlobalFunctionData {
 	bool header_written = false;
 	//! Whether frontmatter has been written (document mode)
 	bool frontmatter_written = false;
+	//! Compression of the open file (never AUTO_DETECT)
+	FileCompressionType compression = FileCompressionType::UNCOMPRESSED;
+	//! Markdown bytes written to this file before compression (drives FILE_SIZE_BYTES rotation)
+	idx_t bytes_written = 0;
 };
 
 //===--------------------------------------------------------------------===//
@@ -117,7 +127,23 @@ public:
 	//! Copy options registration
 	static void CopyOptions(ClientContext &context, CopyOptionsInput &input);
 
+	//! Bytes written to the current file, for FILE_SIZE_BYTES
+	static idx_t FileSize(GlobalFunctionData &gstate);
+
+	//! Whether the copy rotates files by size (ROWS_PER_FILE rotation needs no support here)
+	static bool RotateFiles(FunctionData &bind_data, const optional_idx &file_size_bytes);
+
+	//! Whether the current file has reached FILE_SIZE_BYTES
+	static bool RotateNextFile(GlobalFunctionData &gstate, FunctionData &bind_data, const optional_idx &file_size_bytes);
+
 private:
+	//! Write the table header / frontmatter if this file has none yet, then the local buffer
+	static void FlushBuffer(const WriteMarkdownBindData &bind_data, WriteMarkdownGlobalState &gstate,
+	                        WriteMarkdownLocalState &lstate);
+
+	//! Write to the current file and count the bytes
+	static void WriteToFile(WriteMarkdownGlobalState &gstate, const string &data);
+
 	//===--------------------------------------------------------------------===//
 	// Table Mode Helpers
 	//===--------------------------------------------------------------------===//
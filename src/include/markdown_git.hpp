@@ -0,0 +1,95 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "markdown_lru_cache.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duckdb {
+
+namespace markdown_git {
+
+//===--------------------------------------------------------------------===//
+// Git Object Database (read-only)
+//===--------------------------------------------------------------------===//
+// Reads objects straight from a local repository's object database - loose
+// objects and version 2 pack indexes/packfiles, including OFS/REF deltas - so
+// any revision can be read without a checkout. Only what read_markdown_git needs
+// is implemented: commits, trees, blobs and annotated tags.
+
+enum class GitObjectType : uint8_t { NONE = 0, COMMIT = 1, TREE = 2, BLOB = 3, TAG = 4, OFS_DELTA = 6, REF_DELTA = 7 };
+
+struct GitObject {
+	GitObjectType type = GitObjectType::NONE;
+	std::string data;
+};
+
+struct GitTreeEntry {
+	std::string path;    // Repository-relative path ("docs/guide/intro.md")
+	std::string blob_id; // Hex object id of the blob
+};
+
+// A binary 20-byte object id in hex (40 chars)
+std::string OidToHex(const uint8_t *oid);
+// Parse 40 hex chars into 20 bytes; returns false if not a full hex id
+bool HexToOid(const std::string &hex, uint8_t *oid);
+
+// Glob match for repository paths: `*` and `?` stay within one path component,
+// `**/` matches zero or more directories, `[...]` is a character class.
+bool GitGlobMatch(const std::string &pattern, const std::string &path);
+
+class GitRepository {
+public:
+	/**
+	 * @brief Open a repository: a working tree (with .git directory or gitfile) or a bare repository
+	 *
+	 * @param fs File system used for all reads
+	 * @param repo_path Path to the working tree or bare repository
+	 * @param delta_cache_size Bytes of reconstructed delta bases kept in the LRU cache
+	 */
+	GitRepository(FileSystem &fs, const std::string &repo_path, idx_t delta_cache_size);
+	~GitRepository();
+
+	// Resolve a revision (full/abbreviated id, HEAD, branch, tag, remote ref, with ~N / ^N suffixes)
+	// to the hex id of a commit
+	std::string ResolveCommit(const std::string &rev);
+
+	// Read any object by hex id; throws if it does not exist
+	GitObject ReadObject(const std::string &oid_hex);
+
+	// List every blob reachable from a commit's root tree whose path matches glob
+	std::vector<GitTreeEntry> ListFiles(const std::string &commit_id, const std::string &glob);
+
+private:
+	struct PackFile;
+
+	std::string ReadFileToString(const std::string &path);
+	bool TryReadLooseObject(const std::string &oid_hex, GitObject &result);
+	bool TryReadPackedObject(const uint8_t *oid, GitObject &result);
+	void LoadPacks();
+	GitObject ReadPackedObjectAt(idx_t pack_idx, idx_t offset);
+	std::string InflatePackData(PackFile &pack, idx_t offset, idx_t expected_size);
+	std::string ResolveRefName(const std::string &name);
+	std::string ReadRef(const std::string &ref_name, idx_t depth);
+	void LoadPackedRefs();
+	std::string ExpandAbbreviatedId(const std::string &prefix);
+	std::string PeelToCommit(std::string oid_hex);
+	void WalkTree(const std::string &tree_id, const std::string &prefix, const std::string &glob,
+	              std::vector<GitTreeEntry> &result);
+
+	FileSystem &fs;
+	std::string git_dir;    // Per-worktree dir (HEAD)
+	std::string common_dir; // Shared dir (objects, refs, packed-refs)
+	bool packs_loaded = false;
+	std::vector<unique_ptr<PackFile>> packs;
+	bool packed_refs_loaded = false;
+	std::unordered_map<std::string, std::string> packed_refs; // refname -> hex id
+	// Reconstructed delta bases keyed by "<pack index>:<offset>"
+	MarkdownLRUCache<std::string, GitObject> delta_base_cache;
+};
+
+} // namespace markdown_git
+
+} // namespace duckdb
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace duckdb {
+
+namespace markdown_utils {
+
+//===--------------------------------------------------------------------===//
+// Frontmatter Bounds
+//===--------------------------------------------------------------------===//
+
+// Result of locating a leading YAML-style frontmatter block.
+struct FrontmatterMatch {
+	bool found = false;
+	size_t body_start = 0;  // offset of first byte of the frontmatter body
+	size_t body_len = 0;    // length of the body (delimiters excluded)
+	size_t after_close = 0; // offset just past the closing "---"
+};
+
+// Faithful linear replacement for R"(^---\r?\n([\s\S]*?)\r?\n---)".
+// Requires the string to begin with "---" then \r?\n, then finds the earliest
+// following "\r?\n---". Returns the body between the delimiters. O(n), no
+// recursion, and it stops at the closing delimiter.
+FrontmatterMatch FindFrontmatter(const char *data, size_t size);
+
+inline FrontmatterMatch FindFrontmatter(const std::string &s) {
+	return FindFrontmatter(s.data(), s.size());
+}
+
+//===--------------------------------------------------------------------===//
+// Newline Index
+//===--------------------------------------------------------------------===//
+// Start offset of every line, built once per document (popcount sizes the table,
+// then one 16-byte sweep fills it). Byte offsets map to line and column by binary
+// search, so callers holding a pointer into the buffer never rescan it.
+
+class NewlineIndex {
+public:
+	NewlineIndex() = default;
+	NewlineIndex(const char *data, size_t size);
+	explicit NewlineIndex(const std::string &markdown_str) : NewlineIndex(markdown_str.data(), markdown_str.size()) {
+	}
+
+	//! Number of lines ('\n' count + 1; a trailing '\n' ends with an empty line)
+	idx_t LineCount() const {
+		return line_starts.size();
+	}
+	size_t LineStart(idx_t line) const {
+		return line_starts[line];
+	}
+	//! End of the line, excluding its '\n'
+	size_t LineEnd(idx_t line) const {
+		return line + 1 < line_starts.size() ? line_starts[line + 1] - 1 : size;
+	}
+	//! 0-based line holding the byte at offset (a '\n' belongs to the line it ends)
+	idx_t LineIndex(size_t offset) const {
+		auto it = std::upper_bound(line_starts.begin(), line_starts.end(), offset);
+		return static_cast<idx_t>(it - line_starts.begin()) - 1;
+	}
+	//! 1-based line number of the byte at offset
+	idx_t LineOf(size_t offset) const {
+		return LineIndex(offset) + 1;
+	}
+	//! 1-based byte column of offset within its line
+	idx_t ColumnOf(size_t offset) const {
+		return offset - line_starts[LineIndex(offset)] + 1;
+	}
+
+private:
+	friend class StructuralIndex;
+
+	size_t size = 0;
+	std::vector<size_t> line_starts {0};
+};
+
+//===--------------------------------------------------------------------===//
+// Structural Index
+//===--------------------------------------------------------------------===//
+// Line-level structure of a document, computed once so that the linear scanners
+// (stats, tables, reference definitions, tags, wikilinks) do not each re-split
+// and re-classify the same bytes. Stage 1 sweeps the buffer in 16-byte blocks
+// (see markdown_simd.hpp) and records line starts together with per-line "has
+// '#'" / "has '[['" bits; stage 2 classifies each line from its first and last
+// bytes only.
+
+enum StructuralLineFlag : uint16_t {
+	LINE_FENCE = 1 << 0,        // ``` or ~~~ fence; a closing one repeats the opening character at least as often
+	LINE_FENCE_OPEN = 1 << 1,   // A fence line that opens a block
+	LINE_IN_FENCE = 1 << 2,     // Strictly inside a fenced block
+	LINE_ATX_HEADING = 1 << 3,  // 1-6 '#' at column 0, then a space or tab
+	LINE_PIPE_TABLE = 1 << 4,   // GFM pipe-table row: '|' first, last non-blank '|', two or more pipes
+	LINE_BRACKET = 1 << 5,      // First non-blank byte is '[' (reference definition candidate)
+	LINE_FRONTMATTER = 1 << 6,  // Inside the leading frontmatter block, delimiters included
+	LINE_HAS_HASH = 1 << 7,     // Contains a '#'
+	LINE_HAS_WIKILINK = 1 << 8, // Contains "[["
+};
+
+class StructuralIndex {
+public:
+	StructuralIndex(const char *data, size_t size);
+	explicit StructuralIndex(const std::string &markdown_str)
+	    : StructuralIndex(markdown_str.data(), markdown_str.size()) {
+	}
+
+	//! Line starts of the document, for offset -> line / column lookups
+	const NewlineIndex &Lines() const {
+		return lines;
+	}
+	idx_t LineCount() const {
+		return lines.LineCount();
+	}
+	size_t LineStart(idx_t line) const {
+		return lines.LineStart(line);
+	}
+	size_t LineEnd(idx_t line) const {
+		return lines.LineEnd(line);
+	}
+	const char *LineData(idx_t line) const {
+		return data + lines.LineStart(line);
+	}
+	size_t LineLength(idx_t line) const {
+		return LineEnd(line) - LineStart(line);
+	}
+	std::string Line(idx_t line) const {
+		return std::string(LineData(line), LineLength(line));
+	}
+	uint16_t Flags(idx_t line) const {
+		return line_flags[line];
+	}
+	bool HasFlag(idx_t line, uint16_t flag) const {
+		return (line_flags[line] & flag) != 0;
+	}
+	//! Fence lines and the lines between them
+	bool InCode(idx_t line) const {
+		return HasFlag(line, LINE_FENCE | LINE_IN_FENCE);
+	}
+	const FrontmatterMatch &Frontmatter() const {
+		return frontmatter;
+	}
+
+private:
+	void FindLines();
+	void ClassifyLines();
+
+	const char *data;
+	size_t size;
+	NewlineIndex lines;
+	std::vector<uint16_t> line_flags;
+	FrontmatterMatch frontmatter;
+};
+
+} // namespace markdown_utils
+
+} // namespace duckdb
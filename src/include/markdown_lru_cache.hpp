@@ -0,0 +1,95 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include <list>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Byte-bounded least-recently-used map
+ *
+ * Values are held by shared_ptr so a caller can keep using an entry after it has
+ * been evicted. Sizes are caller-estimated bytes; an entry larger than the whole
+ * capacity is not stored. Not thread-safe - owners serialize access.
+ */
+template <class KEY, class VALUE, class HASH = std::hash<KEY>>
+class MarkdownLRUCache {
+public:
+	explicit MarkdownLRUCache(idx_t capacity_bytes) : capacity(capacity_bytes) {
+	}
+
+	//! Look up a key; a hit becomes the most recently used entry. Returns nullptr on a miss.
+	shared_ptr<VALUE> Get(const KEY &key) {
+		auto entry = index.find(key);
+		if (entry == index.end()) {
+			return nullptr;
+		}
+		entries.splice(entries.begin(), entries, entry->second);
+		return entry->second->value;
+	}
+
+	//! Insert or replace a key, evicting least recently used entries to stay within capacity
+	void Put(const KEY &key, shared_ptr<VALUE> value, idx_t size) {
+		auto existing = index.find(key);
+		if (existing != index.end()) {
+			used -= existing->second->size;
+			entries.erase(existing->second);
+			index.erase(existing);
+		}
+		if (size > capacity) {
+			return;
+		}
+		entries.push_front(Entry {key, std::move(value), size});
+		index[key] = entries.begin();
+		used += size;
+		Evict();
+	}
+
+	//! Change the capacity, evicting as needed
+	void SetCapacity(idx_t capacity_bytes) {
+		capacity = capacity_bytes;
+		Evict();
+	}
+
+	void Clear() {
+		entries.clear();
+		index.clear();
+		used = 0;
+	}
+
+	idx_t Capacity() const {
+		return capacity;
+	}
+
+	idx_t UsedBytes() const {
+		return used;
+	}
+
+	idx_t Count() const {
+		return entries.size();
+	}
+
+private:
+	struct Entry {
+		KEY key;
+		shared_ptr<VALUE> value;
+		idx_t size;
+	};
+
+	void Evict() {
+		while (used > capacity && !entries.empty()) {
+			auto &last = entries.back();
+			used -= last.size;
+			index.erase(last.key);
+			entries.pop_back();
+		}
+	}
+
+	std::list<Entry> entries; // Front is the most recently used
+	std::unordered_map<KEY, typename std::list<Entry>::iterator, HASH> index;
+	idx_t capacity;
+	idx_t used = 0;
+};
+
+} // namespace duckdb
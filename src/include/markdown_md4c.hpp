@@ -0,0 +1,29 @@
+#pragma once
+
+#include "markdown_utils.hpp"
+#include <string>
+#include <vector>
+
+namespace duckdb {
+
+namespace markdown_md4c {
+
+//===--------------------------------------------------------------------===//
+// md4c Parser Backend
+//===--------------------------------------------------------------------===//
+// Tree-free versions of the flat extractors, driven by md4c's enter/leave/text
+// callbacks in CommonMark mode (matching the cmark-gfm extractors, which attach
+// no GFM extensions). Results follow markdown_utils field for field. md4c reports
+// no source positions, so line numbers are recovered from the text pointers it
+// hands back into the input buffer.
+
+std::vector<markdown_utils::CodeBlock> ExtractCodeBlocks(const std::string &markdown_str,
+                                                         const std::string &language_filter = "");
+
+std::vector<markdown_utils::MarkdownLink> ExtractLinks(const std::string &markdown_str);
+
+std::vector<markdown_utils::MarkdownImage> ExtractImages(const std::string &markdown_str);
+
+} // namespace markdown_md4c
+
+} // namespace duckdb
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "markdown_lru_cache.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace duckdb {
+
+// Scalar functions whose results can be memoized
+enum class MarkdownMemoFunction : uint8_t { TO_HTML = 1, EXTRACT_SECTIONS = 2, STATS = 3 };
+
+//! Snapshot of the memo cache, as returned by markdown_memo_cache_stats()
+struct MarkdownMemoCacheStats {
+	idx_t capacity = 0;
+	idx_t used_bytes = 0;
+	idx_t entries = 0;
+	idx_t hits = 0;
+	idx_t misses = 0;
+};
+
+/**
+ * @brief Content-addressed result cache for the expensive md_* scalar functions
+ *
+ * Keyed by (function, hash of the markdown input) and bounded by the
+ * `markdown_memo_cache_size` setting (bytes, 0 = disabled). One cache lives in
+ * each database instance's ObjectCache, shared by all connections. Entries keep
+ * a copy of their input so a hash collision can never return a wrong result.
+ * The entries are split over SHARD_COUNT independently locked LRU shards,
+ * picked by the top bits of the hash, so threads rarely wait on each other.
+ */
+class MarkdownMemoCache : public ObjectCacheEntry {
+public:
+	static constexpr const char *SETTING_NAME = "markdown_memo_cache_size";
+	static constexpr idx_t SHARD_COUNT = 16;
+
+	struct Key {
+		MarkdownMemoFunction function;
+		hash_t hash;
+
+		bool operator==(const Key &other) const {
+			return function == other.function && hash == other.hash;
+		}
+	};
+
+	explicit MarkdownMemoCache(idx_t capacity_bytes);
+
+	/**
+	 * @brief Get the instance's cache sized to the current setting
+	 *
+	 * @param context Client context of the executing query
+	 * @return The cache, or nullptr when memoization is disabled
+	 */
+	static shared_ptr<MarkdownMemoCache> Get(ClientContext &context);
+
+	//! Register the markdown_memo_cache_size setting and markdown_memo_cache_stats()
+	static void Register(ExtensionLoader &loader);
+
+	/**
+	 * @brief Look up a result
+	 *
+	 * @param function Function the result belongs to
+	 * @param input Markdown input
+	 * @param key Set to the input's key, to pass to Store on a miss
+	 * @param result Set to the cached result on a hit
+	 * @return Whether the result was cached
+	 */
+	bool Lookup(MarkdownMemoFunction function, const string_t &input, Key &key, Value &result);
+
+	//! Store a result computed for input under the key Lookup returned for it
+	void Store(const Key &key, const string_t &input, const Value &result);
+
+	//! Current size and hit/miss counts since the cache was created
+	MarkdownMemoCacheStats GetStats() const;
+
+	static string ObjectType();
+	string GetObjectType() override;
+	optional_idx GetEstimatedCacheMemory() const override;
+
+private:
+	struct KeyHash {
+		size_t operator()(const Key &key) const {
+			return static_cast<size_t>(CombineHash(key.hash, static_cast<hash_t>(key.function)));
+		}
+	};
+	struct Entry {
+		string input;
+		Value result;
+	};
+	struct Shard {
+		mutable std::mutex lock;
+		MarkdownLRUCache<Key, Entry, KeyHash> cache {0};
+	};
+
+	void Resize(idx_t capacity_bytes);
+	Shard &GetShard(const Key &key);
+
+	//! Capacity (bytes) of the whole cache; each shard holds an equal part
+	std::atomic<idx_t> capacity;
+	std::atomic<idx_t> hits {0};
+	std::atomic<idx_t> misses {0};
+	Shard shards[SHARD_COUNT];
+};
+
+} // namespace duckdb
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include <map>
+#include <unordered_map>
+
+namespace duckdb {
+
+/**
+ * @brief Splits a Pandoc JSON document into its top-level pieces while reading it
+ *
+ * A Pandoc AST is `{"pandoc-api-version": [...], "meta": {...}, "blocks": [...]}`.
+ * The file is read in fixed-size chunks and only the JSON text of one piece (the
+ * meta object, or one element of the blocks array) is held at a time, so memory is
+ * bounded by the largest top-level block rather than by the document.
+ */
+class PandocJsonStream {
+public:
+	enum class ItemType : uint8_t { META, BLOCK };
+
+	explicit PandocJsonStream(unique_ptr<FileHandle> handle);
+
+	//! Next piece of the document as JSON text; false after the closing brace
+	bool Next(ItemType &type, string &json);
+
+	//! Bytes read from the file so far
+	idx_t BytesRead() const {
+		return bytes_read;
+	}
+
+private:
+	enum class State : uint8_t { DOCUMENT, KEY, BLOCKS, DONE };
+
+	//! Append the next chunk (dropping everything before pos); false at the end of the file
+	bool Refill();
+	//! Move pos to the next non-whitespace byte; false at the end of the file
+	bool SkipWhitespace();
+	//! The complete JSON value starting at pos
+	void ReadValue(string &json);
+
+	unique_ptr<FileHandle> handle;
+	string buffer;
+	idx_t pos = 0;
+	idx_t bytes_read = 0;
+	bool eof = false;
+	State state = State::DOCUMENT;
+};
+
+//! One duck_block row (kind, element_type, content, level, encoding, attributes, element_order)
+struct PandocRow {
+	string kind;
+	string element_type;
+	string content;
+	int32_t level = 1;
+	string encoding = "text";
+	std::map<string, string> attributes;
+	int32_t element_order = 0;
+};
+
+/**
+ * @brief Turns Pandoc meta and block JSON into duck_block rows
+ *
+ * Blocks follow read_markdown_blocks: headings, paragraphs, code, blockquotes, lists
+ * and tables (JSON encoded), hr, html / raw, and a yaml `frontmatter` row for the meta.
+ * Div and Figure containers are flattened into their blocks. With inlines, each block
+ * row is followed by one `inline` row per inline element of the block, in document
+ * order, with level the nesting depth (1 for the block's own inlines).
+ */
+class PandocConverter {
+public:
+	explicit PandocConverter(bool inlines) : inlines(inlines) {
+	}
+
+	//! Rows of the meta object (a frontmatter row, if the meta has any field)
+	void AddMeta(const string &json, vector<PandocRow> &rows);
+	//! Rows of one top-level block
+	void AddBlock(const string &json, vector<PandocRow> &rows);
+
+private:
+	bool inlines;
+	int32_t next_order = 1;
+	//! Heading IDs seen so far in the document, for the suffixes of generated IDs
+	std::unordered_map<string, int32_t> id_counts;
+};
+
+} // namespace duckdb
@@ -14,12 +14,17 @@
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/parser/parsed_data/create_pragma_function_info.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "markdown_scan_report.hpp"
 #include "markdown_utils.hpp"
 
 namespace duckdb {
 
 class TableRef;
 struct ReplacementScanData;
+struct MarkdownReadSectionBindData;
+struct MarkdownReadBlocksBindData;
+struct MarkdownFileScanGlobalState;
 
 /**
  * @brief Markdown Reader class for handling Markdown files in DuckDB
@@ -40,9 +45,21 @@ public:
 		idx_t maximum_file_size = 16777216; // 16MB default maximum file size
 		markdown_utils::MarkdownFlavor flavor = markdown_utils::MarkdownFlavor::GFM;
 
+		// Optional normalization steps applied when normalize_content is set
+		markdown_utils::NormalizeOptions normalize;
+
+		// Deterministic partition of the file list across independent scans (shard_index of shard_count)
+		idx_t shard_index = 0;
+		idx_t shard_count = 1;
+
+		// Resumable scans: skip files recorded in checkpoint_file, record fully emitted files on commit
+		std::string checkpoint_file = "";
+		idx_t checkpoint_batch = 0; // Files per scan (0 = all remaining)
+
 		// Column inclusion options
 		bool include_filepath = false;   // Whether to include file_path column
 		bool content_as_varchar = false; // Whether content should be varchar instead of markdown
+		bool lead_only = false;          // Emit title and summary columns instead of content (read_markdown)
 
 		// Optional add-on extractors enabled via the `extract_extensions` named param.
 		// When set, the reader appends LIST<STRUCT> columns populated from each row's
@@ -64,6 +81,16 @@ public:
 		idx_t max_content_length = 0;         // For smart mode (0 = auto, uses 2000 chars)
 		std::string section_filter = "";      // Fragment filter (#section-id)
 
+		// Trigram index (markdown_build_trigram_index) consulted for pushed-down content filters
+		std::string trigram_index = "";
+
+		// Stream reader specific
+		std::string separator = std::string(1, '\0'); // Document delimiter (default NUL, like `git log -z`)
+
+		// Git reader specific
+		idx_t delta_cache_size = 33554432; // 32MB of reconstructed delta bases
+		idx_t parse_cache_size = 67108864; // 64MB of parsed blobs shared across revisions
+
 		// User-specified column types
 		vector<string> column_names;      // User-provided column names
 		vector<LogicalType> column_types; // User-provided column types
@@ -139,6 +166,21 @@ private:
 	 */
 	static void MarkdownReadSectionsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
 
+	/**
+	 * @brief Parse the next file of a read_markdown_sections scan
+	 *
+	 * Queues the previous file for the checkpoint (if any), since all its rows were emitted.
+	 * A file whose path fails the pushed-down file_path filter is skipped without being read,
+	 * as are files and sections the trigram index rules out for a pushed-down content filter.
+	 *
+	 * @param context Client context
+	 * @param bind_data Scan state to load the file's sections into
+	 * @param scan_state Pushed-down filters, trigram index and checkpoint queue of the scan
+	 * @return false once every file has been consumed
+	 */
+	static bool LoadNextSectionFile(ClientContext &context, MarkdownReadSectionBindData &bind_data,
+	                                MarkdownFileScanGlobalState &scan_state);
+
 	/**
 	 * @brief Bind function for read_markdown_blocks
 	 *
@@ -162,15 +204,400 @@ private:
 	 */
 	static void MarkdownReadBlocksFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
 
+	/**
+	 * @brief Parse the next file of a read_markdown_blocks scan
+	 *
+	 * Queues the previous file for the checkpoint (if any), since all its rows were emitted.
+	 * A file whose path fails the pushed-down file_path filter is skipped without being read.
+	 *
+	 * @param context Client context
+	 * @param bind_data Scan state to load the file's blocks into
+	 * @param scan_state Pushed-down filters and checkpoint queue of the scan
+	 * @return false once every file has been consumed
+	 */
+	static bool LoadNextBlocksFile(ClientContext &context, MarkdownReadBlocksBindData &bind_data,
+	                               MarkdownFileScanGlobalState &scan_state);
+
+	/**
+	 * @brief Bind function for read_markdown_stream
+	 *
+	 * Returns one row per document split off a single stream file or FIFO
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownReadStreamBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                       vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for read_markdown_stream (opens the stream once, shared by all threads)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownReadStreamInitGlobal(ClientContext &context,
+	                                                                         TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for read_markdown_stream (per-thread batch of split-off documents)
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownReadStreamInitLocal(ExecutionContext &context,
+	                                                                       TableFunctionInitInput &input,
+	                                                                       GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for read_markdown_stream
+	 *
+	 * Documents are split off the stream under the global lock and parsed outside it,
+	 * so parsing runs in parallel while reading stays sequential.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownReadStreamFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register read_markdown_stream
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterStreamFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for markdown_lint
+	 *
+	 * Returns one row per lint issue of every matching file
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownLintBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                 vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for markdown_lint (shared file cursor)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownLintInitGlobal(ClientContext &context,
+	                                                                   TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for markdown_lint (issues of the file a thread is emitting)
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownLintInitLocal(ExecutionContext &context,
+	                                                                 TableFunctionInitInput &input,
+	                                                                 GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for markdown_lint
+	 *
+	 * Each thread claims whole files and reads and lints them in parallel with the others.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownLintFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register markdown_lint
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterLintFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for markdown_term_stats
+	 *
+	 * Returns one row per distinct term of the matching files, with its total count (tf)
+	 * and the number of files it appears in (df)
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownTermStatsBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                      vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for markdown_term_stats (file cursor and merged term counts)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownTermStatsInitGlobal(ClientContext &context,
+	                                                                        TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for markdown_term_stats (a thread's own term counts)
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownTermStatsInitLocal(ExecutionContext &context,
+	                                                                      TableFunctionInitInput &input,
+	                                                                      GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for markdown_term_stats
+	 *
+	 * Threads claim whole files and count terms into their own maps; when the files run out
+	 * each merges its map into the global one, and the last thread to merge emits the result.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownTermStatsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register markdown_term_stats
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterTermStatsFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for markdown_pagerank
+	 *
+	 * Returns one row per matching file with its PageRank over the graph of resolved
+	 * wikilinks and relative markdown links, and its in- and out-degree
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters (path, iterations, damping)
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownPageRankBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                     vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for markdown_pagerank (file cursor, link graph and rank vectors)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownPageRankInitGlobal(ClientContext &context,
+	                                                                       TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for markdown_pagerank
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownPageRankInitLocal(ExecutionContext &context,
+	                                                                     TableFunctionInitInput &input,
+	                                                                     GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for markdown_pagerank
+	 *
+	 * Threads extract links from whole files, then share the blocks of each iteration's
+	 * sparse matrix-vector product, then emit chunks of the result.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownPageRankFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register markdown_pagerank
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterPageRankFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for markdown_build_trigram_index
+	 *
+	 * Returns one summary row for the index written to the index file
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters (path, index_file)
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownTrigramBuildBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                         vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for markdown_build_trigram_index (file cursor, previous index and per-file slots)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownTrigramBuildInitGlobal(ClientContext &context,
+	                                                                           TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for markdown_build_trigram_index
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownTrigramBuildInitLocal(ExecutionContext &context,
+	                                                                         TableFunctionInitInput &input,
+	                                                                         GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for markdown_build_trigram_index
+	 *
+	 * Threads claim whole files and index them in parallel; unchanged files keep their
+	 * entries from the previous index. The last thread to finish writes the index.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownTrigramBuildFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register markdown_build_trigram_index
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterTrigramIndexFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for read_pandoc_json
+	 *
+	 * Returns duck_block rows (the read_markdown_blocks columns) for Pandoc JSON ASTs
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters (path, include_filepath, inlines)
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownReadPandocBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                       vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for read_pandoc_json (shared file cursor)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownReadPandocInitGlobal(ClientContext &context,
+	                                                                         TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for read_pandoc_json
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownReadPandocInitLocal(ExecutionContext &context,
+	                                                                       TableFunctionInitInput &input,
+	                                                                       GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for read_pandoc_json
+	 *
+	 * Threads claim whole files; each file is read in chunks and converted one
+	 * top-level block at a time.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownReadPandocFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register read_pandoc_json
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterPandocFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for read_markdown_anchors
+	 *
+	 * Returns one row per heading anchor (file_path, anchor_id, level, line) of every matching file
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters (path, maximum_file_size)
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownAnchorsBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                    vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for read_markdown_anchors (shared file cursor)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownAnchorsInitGlobal(ClientContext &context,
+	                                                                      TableFunctionInitInput &input);
+
+	/**
+	 * @brief Local state init for read_markdown_anchors
+	 */
+	static unique_ptr<LocalTableFunctionState> MarkdownAnchorsInitLocal(ExecutionContext &context,
+	                                                                    TableFunctionInitInput &input,
+	                                                                    GlobalTableFunctionState *global_state);
+
+	/**
+	 * @brief Execution function for read_markdown_anchors
+	 *
+	 * Threads claim whole files and scan their headings in parallel.
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownAnchorsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register read_markdown_anchors
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterAnchorsFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Bind function for read_markdown_git
+	 *
+	 * Returns one row per section of every matching blob at each requested revision
+	 *
+	 * @param context Client context for the query
+	 * @param input Bind input parameters
+	 * @param return_types Types of columns to return
+	 * @param names Names of columns to return
+	 * @return Function data for execution
+	 */
+	static unique_ptr<FunctionData> MarkdownReadGitBind(ClientContext &context, TableFunctionBindInput &input,
+	                                                    vector<LogicalType> &return_types, vector<string> &names);
+
+	/**
+	 * @brief Global state init for read_markdown_git (opens the object database)
+	 */
+	static unique_ptr<GlobalTableFunctionState> MarkdownReadGitInitGlobal(ClientContext &context,
+	                                                                      TableFunctionInitInput &input);
+
+	/**
+	 * @brief Execution function for read_markdown_git
+	 *
+	 * @param context Client context
+	 * @param input Execution input data
+	 * @param output Output chunk to write results to
+	 */
+	static void MarkdownReadGitFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output);
+
+	/**
+	 * @brief Register read_markdown_git
+	 *
+	 * @param loader The extension loader to register the function with
+	 */
+	static void RegisterGitFunction(ExtensionLoader &loader);
+
+	/**
+	 * @brief Parse the named parameters shared by the read_markdown* table functions
+	 *
+	 * @param input Bind input parameters
+	 * @param options Markdown read options to fill in
+	 */
+	static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReadOptions &options);
+
 	/**
 	 * @brief Get file paths from various input types (single file, list, glob, directory)
 	 *
 	 * @param context Client context for file operations
 	 * @param path_value The input value containing file path(s)
 	 * @param ignore_errors Whether to ignore missing files
+	 * @param shard_index Shard to keep (0-based)
+	 * @param shard_count Number of shards the files are split into (1 = no sharding)
+	 * @param directory_patterns Globs a directory argument expands to
 	 * @return vector<string> List of resolved file paths
 	 */
-	static vector<string> GetFiles(ClientContext &context, const Value &path_value, bool ignore_errors);
+	static vector<string> GetFiles(ClientContext &context, const Value &path_value, bool ignore_errors,
+	                               idx_t shard_index = 0, idx_t shard_count = 1,
+	                               const vector<string> &directory_patterns = {"*.md", "*.markdown"});
 
 	/**
 	 * @brief Get files from glob pattern with cross-filesystem support
@@ -181,15 +608,50 @@ private:
 	 */
 	static vector<string> GetGlobFiles(ClientContext &context, const string &pattern);
 
+	/**
+	 * @brief Get one shard of a glob's files, listing only the top-level directories in that shard
+	 *
+	 * Files are assigned by a stable hash of their first path component below the glob's literal
+	 * base directory, so every scan that uses the same pattern and shard_count agrees on the split.
+	 * The granularity is that component: files directly in the base spread one by one, but all
+	 * files below one top-level directory share a shard, however many there are.
+	 *
+	 * @param context Client context for file operations
+	 * @param pattern Glob pattern to match
+	 * @param shard_index Shard to keep (0-based)
+	 * @param shard_count Number of shards
+	 * @return vector<string> Files of the shard matching the pattern
+	 */
+	static vector<string> GetShardedGlobFiles(ClientContext &context, const string &pattern, idx_t shard_index,
+	                                          idx_t shard_count);
+
 	/**
 	 * @brief Read a Markdown file and parse it
 	 *
 	 * @param context Client context for file operations
 	 * @param file_path Path to the Markdown file
 	 * @param options Markdown read options
+	 * @param stats If set, receives the file size and read time for the scan report
 	 * @return string The file content
 	 */
-	static string ReadMarkdownFile(ClientContext &context, const string &file_path, const MarkdownReadOptions &options);
+	static string ReadMarkdownFile(ClientContext &context, const string &file_path, const MarkdownReadOptions &options,
+	                               MarkdownFileScanStats *stats = nullptr);
+
+	/**
+	 * @brief Read a Markdown file's title and lead paragraph (lead_only mode)
+	 *
+	 * Reads a 4KB prefix, doubled while the lead paragraph has not ended, so that a
+	 * listing costs one small read per typical file.
+	 *
+	 * @param context Client context for file operations
+	 * @param file_path Path to the Markdown file
+	 * @param options Markdown read options (normalization and maximum_file_size apply)
+	 * @param stats If set, receives the file size and read time for the scan report
+	 * @return markdown_utils::MarkdownLead The title and summary found
+	 */
+	static markdown_utils::MarkdownLead ReadMarkdownLead(ClientContext &context, const string &file_path,
+	                                                     const MarkdownReadOptions &options,
+	                                                     MarkdownFileScanStats *stats = nullptr);
 
 	/**
 	 * @brief Process a Markdown document into sections
@@ -201,6 +663,15 @@ private:
 	static vector<markdown_utils::MarkdownSection> ProcessSections(const string &content,
 	                                                               const MarkdownReadOptions &options);
 
+	/**
+	 * @brief Build the special level-0 section holding a document's raw frontmatter
+	 *
+	 * @param content The Markdown content
+	 * @param section Section to fill in
+	 * @return true if the document has frontmatter
+	 */
+	static bool ExtractFrontmatterSection(const string &content, markdown_utils::MarkdownSection &section);
+
 	/**
 	 * @brief Bind the columns parameter for explicit type specification
 	 *
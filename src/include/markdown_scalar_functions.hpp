@@ -11,8 +11,8 @@ namespace duckdb {
  * This class provides scalar functions for:
  * - Converting Markdown to HTML (md_to_html)
  * - Converting Markdown to plain text (md_to_text)
- * - Converting values to Markdown (value_to_md)
- * - Validating Markdown syntax (md_valid)
+ * - Converting values to Markdown (value_to_md) and rendering templates (md_render)
+ * - Validating Markdown syntax (md_valid) and linting it (md_lint)
  * - Extracting metadata (md_extract_metadata)
  * - Calculating statistics (md_stats)
  */
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include <mutex>
+
+namespace duckdb {
+
+//! Measurements for one file of a read_markdown* scan
+struct MarkdownFileScanStats {
+	string file_path;
+	idx_t file_size = 0;
+	double read_seconds = 0;   // Open, read and normalize
+	double parse_seconds = 0;  // Section / block / metadata extraction
+	optional_idx section_count; // Unset for readers that do not split sections
+	optional_idx block_count;   // Unset for readers that do not split blocks
+	string error;               // Empty when the file was read and parsed
+
+	double TotalSeconds() const {
+		return read_seconds + parse_seconds;
+	}
+};
+
+/**
+ * @brief Per-file diagnostics of the most recent read_markdown* scan on a connection
+ *
+ * Readers record every file they touch; the report keeps the
+ * `markdown_scan_report_size` slowest files (default 100, 0 disables it) plus up
+ * to as many failed files, including ones the section and block readers skip.
+ * The first reader bound by a query starts a new report, and
+ * `markdown_last_scan_report()` returns it slowest first.
+ */
+class MarkdownScanReport : public ClientContextState {
+public:
+	static constexpr const char *SETTING_NAME = "markdown_scan_report_size";
+
+	/**
+	 * @brief Start a report for the current query (no-op for the second reader of the same query)
+	 *
+	 * @param context Client context of the binding reader
+	 */
+	static void BeginScan(ClientContext &context);
+
+	/**
+	 * @brief Add one file's measurements to the current report
+	 *
+	 * @param context Client context of the scan
+	 * @param stats Measurements of the file
+	 */
+	static void Record(ClientContext &context, MarkdownFileScanStats stats);
+
+	//! Register markdown_last_scan_report() and the markdown_scan_report_size setting
+	static void Register(ExtensionLoader &loader);
+
+	//! Retained files, slowest first
+	vector<MarkdownFileScanStats> Snapshot();
+
+	void QueryBegin(ClientContext &context) override;
+
+private:
+	static idx_t Capacity(ClientContext &context);
+
+	std::mutex lock;
+	bool new_query = true;
+	idx_t capacity = 0;
+	// Min-heap on total time, so the fastest retained file is evicted first
+	vector<MarkdownFileScanStats> slowest;
+	vector<MarkdownFileScanStats> errors;
+};
+
+} // namespace duckdb
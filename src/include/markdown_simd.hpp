@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Byte-scanning kernels shared by the normalizer and the linear scanners.
+// Each kernel processes 16-byte blocks as a bitmask (bit i = byte i matched):
+// SSE2 on x86-64, NEON on AArch64, and a portable scalar fallback elsewhere.
+#if !defined(MARKDOWN_SIMD_DISABLE) &&                                                                              \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MARKDOWN_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined(MARKDOWN_SIMD_DISABLE) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MARKDOWN_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace duckdb {
+
+namespace markdown_simd {
+
+static constexpr size_t BLOCK_SIZE = 16;
+
+inline uint32_t CountTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<uint32_t>(index);
+#else
+	return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
+
+inline uint32_t PopCount(uint32_t mask) {
+#ifdef _MSC_VER
+	return static_cast<uint32_t>(__popcnt(mask));
+#else
+	return static_cast<uint32_t>(__builtin_popcount(mask));
+#endif
+}
+
+// One 16-byte block; every comparison yields a 16-bit mask
+struct ByteBlock {
+#if defined(MARKDOWN_SIMD_SSE2)
+	__m128i v;
+
+	static ByteBlock Load(const char *ptr) {
+		return ByteBlock {_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr))};
+	}
+	uint32_t Eq(char c) const {
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c))));
+	}
+	// Bytes >= 0x80 (non-ASCII)
+	uint32_t HighBit() const {
+		return static_cast<uint32_t>(_mm_movemask_epi8(v));
+	}
+#elif defined(MARKDOWN_SIMD_NEON)
+	uint8x16_t v;
+
+	static uint32_t Movemask(uint8x16_t lanes) {
+		// Lanes are 0x00/0xFF: keep one distinct bit per lane and add each half horizontally
+		static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+		uint8x16_t masked = vandq_u8(lanes, vld1q_u8(bits));
+		return static_cast<uint32_t>(vaddv_u8(vget_low_u8(masked))) |
+		       (static_cast<uint32_t>(vaddv_u8(vget_high_u8(masked))) << 8);
+	}
+	static ByteBlock Load(const char *ptr) {
+		return ByteBlock {vld1q_u8(reinterpret_cast<const uint8_t *>(ptr))};
+	}
+	uint32_t Eq(char c) const {
+		return Movemask(vceqq_u8(v, vdupq_n_u8(static_cast<uint8_t>(c))));
+	}
+	uint32_t HighBit() const {
+		return Movemask(vcgeq_u8(v, vdupq_n_u8(0x80)));
+	}
+#else
+	const char *ptr;
+
+	static ByteBlock Load(const char *ptr) {
+		return ByteBlock {ptr};
+	}
+	uint32_t Eq(char c) const {
+		uint32_t mask = 0;
+		for (size_t i = 0; i < BLOCK_SIZE; i++) {
+			mask |= static_cast<uint32_t>(ptr[i] == c) << i;
+		}
+		return mask;
+	}
+	uint32_t HighBit() const {
+		uint32_t mask = 0;
+		for (size_t i = 0; i < BLOCK_SIZE; i++) {
+			mask |= static_cast<uint32_t>((static_cast<uint8_t>(ptr[i]) & 0x80) != 0) << i;
+		}
+		return mask;
+	}
+#endif
+};
+
+// Position of the first '\n' or '\r' at or after pos, or size if there is none
+inline size_t FindLineBreak(const char *data, size_t size, size_t pos) {
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		auto block = ByteBlock::Load(data + pos);
+		auto mask = block.Eq('\n') | block.Eq('\r');
+		if (mask) {
+			return pos + CountTrailingZeros(mask);
+		}
+	}
+	for (; pos < size; pos++) {
+		if (data[pos] == '\n' || data[pos] == '\r') {
+			return pos;
+		}
+	}
+	return size;
+}
+
+inline bool ContainsByte(const char *data, size_t size, char c) {
+	return size > 0 && memchr(data, c, size) != nullptr;
+}
+
+inline size_t CountByte(const char *data, size_t size, char c) {
+	size_t count = 0;
+	size_t pos = 0;
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		count += PopCount(ByteBlock::Load(data + pos).Eq(c));
+	}
+	for (; pos < size; pos++) {
+		count += data[pos] == c;
+	}
+	return count;
+}
+
+inline bool IsASCII(const char *data, size_t size) {
+	size_t pos = 0;
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		if (ByteBlock::Load(data + pos).HighBit()) {
+			return false;
+		}
+	}
+	for (; pos < size; pos++) {
+		if (static_cast<uint8_t>(data[pos]) & 0x80) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// True if any line ends in a space or tab (before '\n' / '\r', or at the end of the buffer)
+inline bool HasTrailingWhitespace(const char *data, size_t size) {
+	if (size == 0) {
+		return false;
+	}
+	if (data[size - 1] == ' ' || data[size - 1] == '\t') {
+		return true;
+	}
+	uint32_t carry = 0; // Last byte of the previous block was a blank
+	size_t pos = 0;
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		auto block = ByteBlock::Load(data + pos);
+		auto blank = block.Eq(' ') | block.Eq('\t');
+		auto line_break = block.Eq('\n') | block.Eq('\r');
+		if (((blank << 1) | carry) & line_break) {
+			return true;
+		}
+		carry = (blank >> (BLOCK_SIZE - 1)) & 1;
+	}
+	bool prev_blank = carry != 0;
+	for (; pos < size; pos++) {
+		char c = data[pos];
+		if ((c == '\n' || c == '\r') && prev_blank) {
+			return true;
+		}
+		prev_blank = c == ' ' || c == '\t';
+	}
+	return false;
+}
+
+} // namespace markdown_simd
+
+} // namespace duckdb
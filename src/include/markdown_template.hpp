@@ -0,0 +1,75 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+struct RecursiveUnifiedVectorFormat;
+
+/**
+ * @brief A md_render template, compiled once against the type of the rows it renders
+ *
+ * The syntax is a Jinja subset: {{ field }} and {{ field.child }} placeholders,
+ * {% for item in list_field %}...{% endfor %} loops (with loop.index, loop.index0,
+ * loop.first, loop.last and loop.length), {% if [not] field %}...{% elif %}...{% else %}
+ * ...{% endif %} conditionals and {# comments #}. A block tag or comment alone on its line
+ * removes the whole line, so loops and conditionals do not leave blank lines behind.
+ *
+ * Field names are resolved to struct child indexes when the template is compiled, and
+ * rows are rendered from a unified view of their vectors with every leaf cast to VARCHAR
+ * (RenderType()), so rendering never builds a Value.
+ */
+class MarkdownTemplate {
+public:
+	MarkdownTemplate(const string &source, const LogicalType &row_type);
+
+	//! The type rows are cast to before rendering: the row type with every leaf as VARCHAR
+	const LogicalType &RenderType() const {
+		return render_type;
+	}
+
+	//! Render count rows of type RenderType() into a VARCHAR result; NULL rows give NULL
+	void Render(Vector &rows, idx_t count, Vector &result) const;
+
+private:
+	enum class NodeType : uint8_t { TEXT, VALUE, FOR, IF };
+	enum class LoopAttribute : uint8_t { NONE, INDEX, INDEX0, FIRST, LAST, LENGTH };
+
+	//! A value reached from the row (scope 0) or a loop variable (scope n = n-th enclosing loop)
+	struct Path {
+		idx_t scope = 0;
+		vector<idx_t> fields;
+		LoopAttribute loop_attribute = LoopAttribute::NONE;
+		//! Type of the value before the render cast, for truthiness
+		LogicalType type;
+	};
+
+	struct Node {
+		NodeType type;
+		string text;
+		Path path;
+		bool negate = false;
+		vector<Node> body;
+		vector<Node> else_body;
+	};
+
+	struct Frame {
+		const RecursiveUnifiedVectorFormat *format;
+		idx_t row;
+		idx_t index;
+		idx_t length;
+	};
+
+	struct Parser;
+
+	//! Walk a path to its value's format and index; false if the value or one on the way is NULL
+	static bool Resolve(const Path &path, const vector<Frame> &frames, const RecursiveUnifiedVectorFormat *&format,
+	                    idx_t &index);
+	static bool IsTruthy(const Path &path, const vector<Frame> &frames);
+	static void RenderNodes(const vector<Node> &nodes, vector<Frame> &frames, string &out);
+
+	vector<Node> nodes;
+	LogicalType render_type;
+};
+
+} // namespace duckdb
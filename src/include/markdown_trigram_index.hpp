@@ -0,0 +1,121 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/planner/table_filter.hpp"
+
+namespace duckdb {
+
+/**
+ * @brief Trigrams a pushed-down content filter requires, as an AND / OR tree
+ *
+ * Built from LIKE, ILIKE, contains, prefix and suffix calls (and equality) on the
+ * content column. Every literal run of three or more bytes between wildcards adds
+ * its trigrams; anything the tree cannot express is ALL, which rules nothing out.
+ */
+struct TrigramQuery {
+	enum class Type : uint8_t { ALL, TRIGRAMS, AND, OR };
+
+	Type type = Type::ALL;
+	//! TRIGRAMS: sorted, every one must be present
+	vector<uint32_t> trigrams;
+	//! AND / OR operands; never ALL
+	vector<TrigramQuery> children;
+
+	//! Whether the query can rule out any text at all
+	bool CanPrune() const {
+		return type != Type::ALL;
+	}
+
+	static TrigramQuery FromFilter(const TableFilter &filter);
+};
+
+/**
+ * @brief Persisted trigram -> (file, segment) postings of a set of markdown files
+ *
+ * Written by markdown_build_trigram_index() and consulted by read_markdown and
+ * read_markdown_sections (`trigram_index := ...`) to skip files and sections whose
+ * content cannot satisfy a pushed-down LIKE / ILIKE filter. Segment 0 of a file is
+ * the whole document as read_markdown returns it; the following segments are its
+ * sections as read_markdown_sections returns them with content_mode 'minimal',
+ * keyed by start_line (0 for the frontmatter row).
+ *
+ * Trigrams are taken over text folded to lower case (ASCII, plus the two non-ASCII
+ * letters whose lower case is ASCII), so one index answers LIKE and ILIKE. Each
+ * file's modification time and size are stored, and a file that changed since the
+ * index was built is read as if it were not indexed.
+ */
+class MarkdownTrigramIndex {
+public:
+	struct IndexedFile {
+		string path;
+		int64_t modified = 0;
+		idx_t size = 0;
+		//! start_line of the section in segment i + 1
+		vector<idx_t> section_lines;
+	};
+
+	struct Posting {
+		uint32_t trigram;
+		uint32_t file;
+		uint32_t segment;
+
+		bool operator<(const Posting &other) const {
+			if (trigram != other.trigram) {
+				return trigram < other.trigram;
+			}
+			if (file != other.file) {
+				return file < other.file;
+			}
+			return segment < other.segment;
+		}
+	};
+
+	//! Normalization the indexed content was read with; the index only applies to scans that match
+	uint64_t options_signature = 0;
+	vector<IndexedFile> files;
+	//! Sorted by (trigram, file, segment)
+	vector<Posting> postings;
+
+	//! Signature of the read options that shape file content
+	static uint64_t OptionsSignature(bool normalize_content, bool trim_trailing_whitespace, idx_t expand_tabs,
+	                                 bool unicode_nfc);
+
+	//! Distinct trigrams of text after case folding, appended to out (sorted and unique)
+	static void ExtractTrigrams(const string &text, vector<uint32_t> &out);
+
+	//! Modification time (microseconds since the epoch) and size of a file
+	static void FileVersion(ClientContext &context, const string &path, int64_t &modified, idx_t &size);
+
+	//! Read an index file
+	static unique_ptr<MarkdownTrigramIndex> Load(ClientContext &context, const string &path);
+
+	//! Write the index to path (through a temporary file, so readers never see a partial index)
+	void Write(ClientContext &context, const string &path) const;
+
+	//! Number of distinct trigrams
+	idx_t TrigramCount() const;
+
+	/**
+	 * @brief Segments of an indexed file whose text can match query
+	 *
+	 * @param context Client context, to check the file is unchanged
+	 * @param path File path as the reader lists it
+	 * @param query Trigram query of the content filter
+	 * @param file Set to the index entry of the file
+	 * @param segments Set to one flag per segment (document first)
+	 * @return false if the file is not indexed or changed since, so nothing can be ruled out
+	 */
+	bool MatchSegments(ClientContext &context, const string &path, const TrigramQuery &query,
+	                   const IndexedFile *&file, vector<bool> &segments) const;
+
+	//! Segment of a file's section (by start_line, 0 for frontmatter); INVALID_INDEX if not indexed
+	static idx_t SectionSegment(const IndexedFile &file, idx_t start_line);
+
+private:
+	void MatchQuery(uint32_t file_id, const TrigramQuery &query, vector<bool> &segments) const;
+
+	//! File path -> position in files, built on load
+	unordered_map<string, idx_t> file_ids;
+};
+
+} // namespace duckdb
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "duckdb.hpp"
+#include <set>
 #include <string>
 #include <vector>
 
@@ -8,6 +9,8 @@ namespace duckdb {
 
 namespace markdown_utils {
 
+class StructuralIndex; // markdown_index.hpp
+
 //===--------------------------------------------------------------------===//
 // Markdown Flavor Settings
 //===--------------------------------------------------------------------===//
@@ -18,6 +21,21 @@ enum class MarkdownFlavor {
 	MULTIMARKDOWN // Extended features
 };
 
+//===--------------------------------------------------------------------===//
+// Parser Backends
+//===--------------------------------------------------------------------===//
+
+// cmark-gfm builds a node tree and is used everywhere. md4c is a callback (SAX)
+// parser that builds no tree; it can serve the flat extractors (code blocks,
+// links, images) that neither mutate nor re-render the document.
+enum class MarkdownParser {
+	CMARK, // cmark-gfm (default)
+	MD4C   // md4c event stream
+};
+
+// Parse a `markdown_parser` setting value ('cmark' or 'md4c'); throws on anything else
+MarkdownParser ParseMarkdownParser(const std::string &name);
+
 //===--------------------------------------------------------------------===//
 // Section Structure
 //===--------------------------------------------------------------------===//
@@ -32,6 +50,12 @@ struct MarkdownSection {
 	idx_t position;           // Position within parent
 	idx_t start_line;         // Starting line number
 	idx_t end_line;           // Ending line number
+	// Nested-set numbering over the extracted sections of a document: a section's
+	// descendants are exactly those whose tree_lo lies in [tree_lo + 1, tree_hi]
+	idx_t tree_lo = 0;            // Pre-order number (1-based)
+	idx_t tree_hi = 0;            // Pre-order number of the last descendant (tree_lo if none)
+	int32_t depth = 0;            // 1 for sections without a parent
+	idx_t subtree_word_count = 0; // Words from the heading to the end of the last subsection
 };
 
 struct MarkdownMetadata {
@@ -62,6 +86,9 @@ std::string MarkdownToHTML(const std::string &markdown_str, MarkdownFlavor flavo
 // Convert Markdown to plain text (for FTS)
 std::string MarkdownToText(const std::string &markdown_str);
 
+// Convert Markdown to mdast JSON (the syntax tree remark produces), with source positions
+std::string MarkdownToMdast(const char *data, size_t size);
+
 // Extract frontmatter metadata
 MarkdownMetadata ExtractMetadata(const std::string &markdown_str);
 
@@ -79,6 +106,29 @@ Value MetadataToMap(const MarkdownMetadata &metadata);
 // Calculate document statistics
 MarkdownStats CalculateStats(const std::string &markdown_str);
 
+// This and the extractor overloads below that take a StructuralIndex reuse one built over the
+// same markdown_str, so a reader running several of these scans sweeps each document once
+MarkdownStats CalculateStats(const std::string &markdown_str, const StructuralIndex &index);
+
+// STRUCT type of the `stats` column / md_stats result, and its value builder
+LogicalType StatsStructType();
+Value StatsToStruct(const MarkdownStats &stats);
+
+// Part of a document whose terms CountTerms collects
+enum class TermScope {
+	TEXT,    // Everything but frontmatter, headings and fenced code; code spans and link targets dropped
+	CODE,    // Lines inside fenced code blocks
+	HEADINGS // ATX heading text, link targets dropped
+};
+
+// Parse a term scope name ('text', 'code' or 'headings'); throws on anything else
+TermScope ParseTermScope(const std::string &name);
+
+// Add the document's terms in one scope to term_counts. Terms are the whitespace-separated
+// words CalculateStats counts, split further at punctuation (except inner apostrophes, and
+// underscores in code) and lowercased, so "Token," and "token" are the same term.
+void CountTerms(const std::string &markdown_str, TermScope scope, std::unordered_map<std::string, idx_t> &term_counts);
+
 //===--------------------------------------------------------------------===//
 // Section Parsing
 //===--------------------------------------------------------------------===//
@@ -169,7 +219,8 @@ struct MarkdownTable {
 };
 
 // Extract code blocks
-std::vector<CodeBlock> ExtractCodeBlocks(const std::string &markdown_str, const std::string &language_filter = "");
+std::vector<CodeBlock> ExtractCodeBlocks(const std::string &markdown_str, const std::string &language_filter = "",
+                                         MarkdownParser parser = MarkdownParser::CMARK);
 
 // Extract sections using cmark-gfm AST (replacement for regex-based ParseSections)
 std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, int32_t min_level = 1,
@@ -177,20 +228,28 @@ std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, in
                                              const std::string &content_mode = "minimal", idx_t max_content_length = 0);
 
 // Extract links
-std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str);
+std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str, MarkdownParser parser = MarkdownParser::CMARK);
+
+// URLs of reference link definitions ([id]: url "title"), used to flag reference-style links
+std::set<std::string> ExtractReferenceUrls(const std::string &markdown_str);
+std::set<std::string> ExtractReferenceUrls(const std::string &markdown_str, const StructuralIndex &index);
 
 // Extract images
-std::vector<MarkdownImage> ExtractImages(const std::string &markdown_str);
+std::vector<MarkdownImage> ExtractImages(const std::string &markdown_str,
+                                         MarkdownParser parser = MarkdownParser::CMARK);
 
 // Extract Obsidian/wiki-style links: [[target]], [[target|alias]], [[target#heading]],
 // [[target^block]], and embeds ![[...]]. Linear scan, line-by-line (no std::regex).
 std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str);
+std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str, const StructuralIndex &index);
 
 // Extract inline #tags (including #nested/tags), skipping fenced code blocks and inline code.
 std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str);
+std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str, const StructuralIndex &index);
 
 // Extract tables
 std::vector<MarkdownTable> ExtractTables(const std::string &markdown_str);
+std::vector<MarkdownTable> ExtractTables(const std::string &markdown_str, const StructuralIndex &index);
 
 // Extract headings for TOC
 std::vector<MarkdownSection> ExtractHeadings(const std::string &markdown_str, int32_t max_level = 6);
@@ -209,8 +268,90 @@ std::string GenerateBreadcrumb(const std::string &markdown_content, const std::s
 // Validate internal links
 bool ValidateInternalLink(const std::string &markdown_str, const std::string &link_target);
 
-// Normalize Markdown content
-std::string NormalizeMarkdown(const std::string &markdown_str);
+// Optional normalization steps (line endings and a UTF-8 BOM are always normalized)
+struct NormalizeOptions {
+	bool trim_trailing_whitespace = false; // Strip trailing blanks outside code fences, keeping 2-space hard breaks
+	idx_t expand_tabs = 0;                 // Expand tabs to this tab stop (0 = keep tabs)
+	bool unicode_nfc = false;              // Compose to Unicode NFC
+};
+
+// Normalize Markdown content in place: strip a UTF-8 BOM, turn CRLF/CR into LF, then apply
+// the optional steps. Single pass over the buffer; an already clean buffer is not written.
+void NormalizeMarkdownInPlace(std::string &markdown_str, const NormalizeOptions &options = NormalizeOptions());
+
+// Normalize Markdown content (copying wrapper around NormalizeMarkdownInPlace)
+std::string NormalizeMarkdown(const std::string &markdown_str, const NormalizeOptions &options = NormalizeOptions());
+
+//===--------------------------------------------------------------------===//
+// Linting
+//===--------------------------------------------------------------------===//
+
+// Lint rules, as bits of a rule mask
+enum MarkdownLintRule : uint32_t {
+	LINT_HEADING_INCREMENT = 1 << 0,   // 'heading-increment': a heading skips a level (## after #### is fine)
+	LINT_DUPLICATE_HEADING = 1 << 1,   // 'duplicate-heading': two headings share an anchor ID
+	LINT_UNCLOSED_FENCE = 1 << 2,      // 'unclosed-fence': a code fence runs to the end of the document
+	LINT_BROKEN_REFERENCE = 1 << 3,    // 'broken-reference': undefined [text][label], or a definition without URL
+	LINT_BROKEN_ANCHOR = 1 << 4,       // 'broken-anchor': a (#fragment) link that matches no heading
+	LINT_TRAILING_WHITESPACE = 1 << 5, // 'trailing-whitespace': trailing blanks other than a 2-space hard break
+	LINT_ALL_RULES = (1 << 6) - 1
+};
+
+struct MarkdownLintIssue {
+	std::string rule; // Rule name, e.g. "heading-increment"
+	idx_t line;       // 1-based line number in the document
+	std::string message;
+};
+
+// Rule mask for a list of rule names; throws on unknown names
+uint32_t ParseLintRules(const std::vector<std::string> &names);
+
+// Check the enabled rules in one pass over the document's lines (frontmatter is skipped, and
+// code blocks are only checked for closing fences). Headings and their anchor IDs are those
+// of ExtractAnchors (ATX and setext, GitHub's -1, -2 suffixes for repeats). Issues come by line.
+std::vector<MarkdownLintIssue> LintMarkdown(const std::string &markdown_str, uint32_t rules = LINT_ALL_RULES);
+
+// STRUCT(rule, line, message) type of one lint issue, and the LIST value of a document's issues
+LogicalType LintIssueStructType();
+Value LintIssuesToList(const std::vector<MarkdownLintIssue> &issues);
+
+//===--------------------------------------------------------------------===//
+// Lead Extraction
+//===--------------------------------------------------------------------===//
+
+// What a listing page shows for a document
+struct MarkdownLead {
+	bool has_title = false;
+	std::string title; // Frontmatter `title`, else the first H1
+	bool has_summary = false;
+	std::string summary; // Text of the first paragraph of prose, on one line
+};
+
+// Find a document's title and lead paragraph, looking no further than the first paragraph
+// after the first heading (or the lead paragraph, once the title is known). Skips frontmatter, headings, code, lists, quotes, tables, HTML and paragraphs
+// with no text outside images (badges). Only whole lines are read: when data is a prefix of
+// the document (at_eof false) and the lead may lie beyond it, returns false so the caller
+// can supply a longer prefix.
+bool ExtractLead(const char *data, size_t size, bool at_eof, MarkdownLead &lead);
+
+// STRUCT(title, summary) type of md_lead, and its value builder (NULL fields when not found)
+LogicalType LeadStructType();
+Value LeadToStruct(const MarkdownLead &lead);
+
+//===--------------------------------------------------------------------===//
+// Heading Anchors
+//===--------------------------------------------------------------------===//
+
+struct MarkdownAnchor {
+	std::string id; // GitHub-style anchor ID, unique within the document
+	int32_t level;  // Heading level (1-6)
+	idx_t line;     // 1-based line of the heading (the text line of a setext heading)
+};
+
+// Anchor IDs of a document's ATX and setext headings, in document order, from one pass over
+// its lines with no rendering. Frontmatter and code blocks are skipped. IDs follow
+// GenerateSectionId and repeats get GitHub's -1, -2 suffixes; headings without an ID are left out.
+std::vector<MarkdownAnchor> ExtractAnchors(const std::string &markdown_str);
 
 } // namespace markdown_utils
 
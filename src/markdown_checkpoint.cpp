@@ -0,0 +1,99 @@
+#include "markdown_checkpoint.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+static constexpr const char *MARKDOWN_CHECKPOINT_KEY = "markdown_checkpoint";
+
+std::unordered_set<string> MarkdownCheckpoint::LoadCompleted(ClientContext &context, const string &checkpoint_file) {
+	std::unordered_set<string> completed;
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.FileExists(checkpoint_file)) {
+		return completed;
+	}
+	auto handle = fs.OpenFile(checkpoint_file, FileOpenFlags::FILE_FLAGS_READ);
+	auto file_size = fs.GetFileSize(*handle);
+	string content;
+	content.resize(file_size);
+	fs.Read(*handle, reinterpret_cast<void *>(content.data()), file_size);
+
+	idx_t line_start = 0;
+	while (line_start < content.size()) {
+		auto line_end = content.find('\n', line_start);
+		if (line_end == string::npos) {
+			break; // Torn write: the line never made it to disk in full
+		}
+		if (line_end > line_start) {
+			completed.insert(content.substr(line_start, line_end - line_start));
+		}
+		line_start = line_end + 1;
+	}
+	return completed;
+}
+
+void MarkdownCheckpoint::SkipCompleted(ClientContext &context, const string &checkpoint_file, idx_t batch_size,
+                                       vector<string> &files) {
+	auto completed = LoadCompleted(context, checkpoint_file);
+	vector<string> remaining;
+	for (auto &file : files) {
+		if (completed.find(file) != completed.end()) {
+			continue;
+		}
+		if (batch_size > 0 && remaining.size() >= batch_size) {
+			break;
+		}
+		remaining.push_back(file);
+	}
+	files = std::move(remaining);
+}
+
+void MarkdownCheckpoint::MarkCompleted(ClientContext &context, const string &checkpoint_file,
+                                       const string &file_path) {
+	auto state = context.registered_state->GetOrCreate<MarkdownCheckpoint>(MARKDOWN_CHECKPOINT_KEY);
+	std::lock_guard<std::mutex> guard(state->lock);
+	state->staged[checkpoint_file].push_back(file_path);
+}
+
+void MarkdownCheckpoint::TransactionCommit(MetaTransaction &transaction, ClientContext &context) {
+	std::lock_guard<std::mutex> guard(lock);
+	for (auto &entry : staged) {
+		auto &files = committed[entry.first];
+		files.insert(files.end(), entry.second.begin(), entry.second.end());
+	}
+	staged.clear();
+}
+
+void MarkdownCheckpoint::TransactionRollback(MetaTransaction &transaction, ClientContext &context) {
+	// Also reached when the commit itself fails after TransactionCommit ran
+	std::lock_guard<std::mutex> guard(lock);
+	staged.clear();
+	committed.clear();
+}
+
+void MarkdownCheckpoint::QueryEnd(ClientContext &context) {
+	// The transaction's outcome is settled by the end of the query that committed it
+	Flush(context);
+}
+
+void MarkdownCheckpoint::Flush(ClientContext &context) {
+	std::lock_guard<std::mutex> guard(lock);
+	if (committed.empty()) {
+		return;
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	for (auto &entry : committed) {
+		string lines;
+		for (auto &file : entry.second) {
+			lines += file;
+			lines += '\n';
+		}
+		auto handle = fs.OpenFile(entry.first, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE |
+		                                           FileOpenFlags::FILE_FLAGS_APPEND);
+		handle->Write(lines.data(), lines.size());
+		handle->Sync();
+	}
+	committed.clear();
+}
+
+} // namespace duckdb
@@ -7,6 +7,9 @@
 
 namespace duckdb {
 
+//! Local buffers larger than this are written out during Sink rather than at Combine
+static constexpr idx_t WRITE_BUFFER_FLUSH_SIZE = 1 << 20;
+
 //===--------------------------------------------------------------------===//
 // WriteMarkdownBindData
 //===--------------------------------------------------------------------===//
@@ -15,6 +18,7 @@ unique_ptr<FunctionData> WriteMarkdownBindData::Copy() const {
 	auto result = make_uniq<WriteMarkdownBindData>();
 	result->markdown_mode = markdown_mode;
 	result->null_value = null_value;
+	result->compression = compression;
 	result->header = header;
 	result->escape_pipes = escape_pipes;
 	result->escape_newlines = escape_newlines;
@@ -24,6 +28,7 @@ unique_ptr<FunctionData> WriteMarkdownBindData::Copy() const {
 	result->level_column = level_column;
 	result->content_mode = content_mode;
 	result->blank_lines = blank_lines;
+	result->flush_size = flush_size;
 	result->kind_column = kind_column;
 	result->element_type_column = element_type_column;
 	result->encoding_column = encoding_column;
@@ -43,7 +48,8 @@ unique_ptr<FunctionData> WriteMarkdownBindData::Copy() const {
 
 bool WriteMarkdownBindData::Equals(const FunctionData &other_p) const {
 	auto &other = other_p.Cast<WriteMarkdownBindData>();
-	return markdown_mode == other.markdown_mode && null_value == other.null_value && header == other.header &&
+	return markdown_mode == other.markdown_mode && null_value == other.null_value && compression == other.compression &&
+	       header == other.header &&
 	       escape_pipes == other.escape_pipes && escape_newlines == other.escape_newlines &&
 	       frontmatter == other.frontmatter && content_column == other.content_column &&
 	       title_column == other.title_column && level_column == other.level_column &&
@@ -65,6 +71,9 @@ void MarkdownCopyFunction::Register(ExtensionLoader &loader) {
 	func.copy_to_combine = Combine;
 	func.copy_to_finalize = Finalize;
 	func.copy_options = CopyOptions;
+	func.file_size_bytes = FileSize;
+	func.rotate_files = RotateFiles;
+	func.rotate_next_file = RotateNextFile;
 
 	loader.RegisterFunction(func);
 }
@@ -77,6 +86,7 @@ void MarkdownCopyFunction::CopyOptions(ClientContext &context, CopyOptionsInput
 	// Core options
 	input.options["markdown_mode"] = CopyOption(LogicalType::VARCHAR);
 	input.options["null_value"] = CopyOption(LogicalType::VARCHAR);
+	input.options["compression"] = CopyOption(LogicalType::VARCHAR);
 
 	// Table mode options
 	input.options["header"] = CopyOption(LogicalType::BOOLEAN);
@@ -124,12 +134,17 @@ unique_ptr<FunctionData> MarkdownCopyFunction::Bind(ClientContext &context, Copy
 				result->markdown_mode = WriteMarkdownBindData::MarkdownMode::DOCUMENT;
 			} else if (mode_str == "blocks" || mode_str == "duck_block") {
 				result->markdown_mode = WriteMarkdownBindData::MarkdownMode::BLOCKS;
+			} else if (mode_str == "raw") {
+				result->markdown_mode = WriteMarkdownBindData::MarkdownMode::RAW;
 			} else {
 				throw InvalidInputException(
-				    "Invalid markdown_mode: '%s'. Expected 'table', 'document', 'blocks', or 'duck_block'", mode_str);
+				    "Invalid markdown_mode: '%s'. Expected 'table', 'document', 'blocks', 'duck_block', or 'raw'",
+				    mode_str);
 			}
 		} else if (loption == "null_value") {
 			result->null_value = StringValue::Get(value[0]);
+		} else if (loption == "compression") {
+			result->compression = FileCompressionTypeFromString(StringValue::Get(value[0]));
 		} else if (loption == "header") {
 			result->header = BooleanValue::Get(value[0]);
 		} else if (loption == "escape_pipes") {
@@ -189,6 +204,21 @@ unique_ptr<FunctionData> MarkdownCopyFunction::Bind(ClientContext &context, Copy
 		// content_column is optional - sections can have empty content
 	}
 
+	// For raw mode, the content column; a single column needs no name (e.g. with PARTITION_BY)
+	if (result->markdown_mode == WriteMarkdownBindData::MarkdownMode::RAW) {
+		for (idx_t i = 0; i < names.size(); i++) {
+			if (StringUtil::Lower(names[i]) == StringUtil::Lower(result->content_column)) {
+				result->content_col_idx = i;
+			}
+		}
+		if (result->content_col_idx == DConstants::INVALID_INDEX && names.size() == 1) {
+			result->content_col_idx = 0;
+		}
+		if (result->content_col_idx == DConstants::INVALID_INDEX) {
+			throw InvalidInputException("Raw mode requires a '%s' column", result->content_column);
+		}
+	}
+
 	// For blocks mode, resolve column indices (uses duck_block naming)
 	if (result->markdown_mode == WriteMarkdownBindData::MarkdownMode::BLOCKS) {
 		for (idx_t i = 0; i < names.size(); i++) {
@@ -227,12 +257,25 @@ unique_ptr<FunctionData> MarkdownCopyFunction::Bind(ClientContext &context, Copy
 
 unique_ptr<GlobalFunctionData> MarkdownCopyFunction::InitializeGlobal(ClientContext &context, FunctionData &bind_data,
                                                                       const string &file_path) {
+	auto &markdown_data = bind_data.Cast<WriteMarkdownBindData>();
 	auto result = make_uniq<WriteMarkdownGlobalState>();
 	auto &fs = FileSystem::GetFileSystem(context);
 
-	// Open file for writing
-	result->handle =
-	    fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	result->compression = markdown_data.compression;
+	if (result->compression == FileCompressionType::AUTO_DETECT) {
+		auto lower_path = StringUtil::Lower(file_path);
+		if (StringUtil::EndsWith(lower_path, ".gz")) {
+			result->compression = FileCompressionType::GZIP;
+		} else if (StringUtil::EndsWith(lower_path, ".zst")) {
+			result->compression = FileCompressionType::ZSTD;
+		} else {
+			result->compression = FileCompressionType::UNCOMPRESSED;
+		}
+	}
+
+	// Open file for writing; compressed files are compressed as they are streamed out
+	result->handle = fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW |
+	                                            result->compression);
 
 	return std::move(result);
 }
@@ -261,6 +304,20 @@ void MarkdownCopyFunction::Sink(ExecutionContext &context, FunctionData &bind_da
 		for (idx_t row_idx = 0; row_idx < input.size(); row_idx++) {
 			lstate.buffer += RenderTableRow(input, row_idx, bind_data);
 		}
+	} else if (bind_data.markdown_mode == WriteMarkdownBindData::MarkdownMode::RAW) {
+		// Raw mode: each value as-is, ending in a newline
+		auto &content_vector = input.data[bind_data.content_col_idx];
+		for (idx_t row_idx = 0; row_idx < input.size(); row_idx++) {
+			auto content_val = content_vector.GetValue(row_idx);
+			auto content = content_val.IsNull() ? bind_data.null_value : content_val.ToString();
+			if (content.empty()) {
+				continue;
+			}
+			lstate.buffer += content;
+			if (content.back() != '\n') {
+				lstate.buffer += '\n';
+			}
+		}
 	} else if (bind_data.markdown_mode == WriteMarkdownBindData::MarkdownMode::DOCUMENT) {
 		// Document mode: render sections
 		for (idx_t row_idx = 0; row_idx < input.size(); row_idx++) {
@@ -358,6 +415,13 @@ void MarkdownCopyFunction::Sink(ExecutionContext &context, FunctionData &bind_da
 			lstate.last_was_inline = is_inline;
 		}
 	}
+
+	// Stream large outputs instead of holding a thread's whole share in memory
+	auto flush_size = bind_data.flush_size > 0 ? bind_data.flush_size : WRITE_BUFFER_FLUSH_SIZE;
+	if (lstate.buffer.size() >= flush_size) {
+		lock_guard<mutex> lock(gstate.write_lock);
+		FlushBuffer(bind_data, gstate, lstate);
+	}
 }
 
 //===--------------------------------------------------------------------===//
@@ -375,28 +439,36 @@ void MarkdownCopyFunction::Combine(ExecutionContext &context, FunctionData &bind
 	}
 
 	lock_guard<mutex> lock(gstate.write_lock);
+	FlushBuffer(bind_data, gstate, lstate);
+}
 
-	// Write header/frontmatter if not yet written
+void MarkdownCopyFunction::FlushBuffer(const WriteMarkdownBindData &bind_data, WriteMarkdownGlobalState &gstate,
+                                       WriteMarkdownLocalState &lstate) {
+	// Write header/frontmatter if not yet written; every rotated file gets its own
 	if (bind_data.markdown_mode == WriteMarkdownBindData::MarkdownMode::TABLE) {
 		if (!gstate.header_written && bind_data.header) {
 			string header_content = RenderTableHeader(bind_data);
 			header_content += RenderTableSeparator(bind_data);
-			gstate.handle->Write(header_content.data(), header_content.size());
+			WriteToFile(gstate, header_content);
 			gstate.header_written = true;
 		}
 	} else {
 		if (!gstate.frontmatter_written && !bind_data.frontmatter.empty()) {
-			string fm_content = RenderFrontmatter(bind_data);
-			gstate.handle->Write(fm_content.data(), fm_content.size());
+			WriteToFile(gstate, RenderFrontmatter(bind_data));
 			gstate.frontmatter_written = true;
 		}
 	}
 
 	// Write buffered data
-	gstate.handle->Write(lstate.buffer.data(), lstate.buffer.size());
+	WriteToFile(gstate, lstate.buffer);
 	lstate.buffer.clear();
 }
 
+void MarkdownCopyFunction::WriteToFile(WriteMarkdownGlobalState &gstate, const string &data) {
+	gstate.handle->Write(const_cast<char *>(data.data()), data.size());
+	gstate.bytes_written += data.size();
+}
+
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
@@ -410,20 +482,47 @@ void MarkdownCopyFunction::Finalize(ClientContext &context, FunctionData &bind_d
 		if (!gstate.header_written && bind_data.header) {
 			string header_content = RenderTableHeader(bind_data);
 			header_content += RenderTableSeparator(bind_data);
-			gstate.handle->Write(header_content.data(), header_content.size());
+			WriteToFile(gstate, header_content);
 		}
 	} else {
 		if (!gstate.frontmatter_written && !bind_data.frontmatter.empty()) {
-			string fm_content = RenderFrontmatter(bind_data);
-			gstate.handle->Write(fm_content.data(), fm_content.size());
+			WriteToFile(gstate, RenderFrontmatter(bind_data));
 		}
 	}
 
-	// Sync and close
-	gstate.handle->Sync();
+	// Sync and close (closing a compressed file flushes the compressor's tail)
+	if (gstate.compression == FileCompressionType::UNCOMPRESSED) {
+		gstate.handle->Sync();
+	}
 	gstate.handle->Close();
 }
 
+//===--------------------------------------------------------------------===//
+// File Rotation
+//===--------------------------------------------------------------------===//
+
+idx_t MarkdownCopyFunction::FileSize(GlobalFunctionData &gstate_p) {
+	auto &gstate = gstate_p.Cast<WriteMarkdownGlobalState>();
+	lock_guard<mutex> lock(gstate.write_lock);
+	return gstate.bytes_written;
+}
+
+bool MarkdownCopyFunction::RotateFiles(FunctionData &bind_data_p, const optional_idx &file_size_bytes) {
+	if (!file_size_bytes.IsValid()) {
+		return false;
+	}
+	// FileSize only sees flushed bytes, so a file could otherwise grow by a whole
+	// 1 MiB buffer per thread past the limit before the next rotation check
+	auto &bind_data = bind_data_p.Cast<WriteMarkdownBindData>();
+	bind_data.flush_size = MaxValue<idx_t>(MinValue<idx_t>(file_size_bytes.GetIndex(), WRITE_BUFFER_FLUSH_SIZE), 1);
+	return true;
+}
+
+bool MarkdownCopyFunction::RotateNextFile(GlobalFunctionData &gstate_p, FunctionData &bind_data,
+                                          const optional_idx &file_size_bytes) {
+	return file_size_bytes.IsValid() && FileSize(gstate_p) > file_size_bytes.GetIndex();
+}
+
 //===--------------------------------------------------------------------===//
 // Table Mode Helpers
 //===--------------------------------------------------------------------===//
@@ -13,6 +13,8 @@
 #include "markdown_scalar_functions.hpp"
 #include "markdown_extraction_functions.hpp"
 #include "duck_block_functions.hpp"
+#include "markdown_memo_cache.hpp"
+#include "markdown_scan_report.hpp"
 
 namespace duckdb {
 
@@ -34,6 +36,12 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	// Register Markdown copy functions
 	RegisterMarkdownCopyFunctions(loader);
+
+	// Register the result memo cache setting and markdown_memo_cache_stats()
+	MarkdownMemoCache::Register(loader);
+
+	// Register per-file scan diagnostics
+	MarkdownScanReport::Register(loader);
 }
 
 void MarkdownExtension::Load(ExtensionLoader &loader) {
@@ -1,6 +1,7 @@
 #include "markdown_extraction_functions.hpp"
 #include "markdown_types.hpp"
 #include "markdown_utils.hpp"
+#include "markdown_memo_cache.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/common/exception.hpp"
@@ -8,9 +9,32 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/common/vector_operations/unary_executor.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
 
 namespace duckdb {
 
+//===--------------------------------------------------------------------===//
+// Parser Backend Selection
+//===--------------------------------------------------------------------===//
+// The flat extractors (code blocks, links, images) can run on md4c instead of
+// cmark-gfm; `SET markdown_parser = 'md4c'` selects it for the session.
+
+static constexpr const char *MARKDOWN_PARSER_SETTING = "markdown_parser";
+
+static markdown_utils::MarkdownParser GetMarkdownParser(ExpressionState &state) {
+	Value setting;
+	if (!state.GetContext().TryGetCurrentSetting(MARKDOWN_PARSER_SETTING, setting) || setting.IsNull()) {
+		return markdown_utils::MarkdownParser::CMARK;
+	}
+	return markdown_utils::ParseMarkdownParser(setting.ToString());
+}
+
+// Set callback of markdown_parser: reject an unknown backend in the SET itself
+static void ValidateMarkdownParser(ClientContext &context, SetScope scope, Value &parameter) {
+	markdown_utils::ParseMarkdownParser(parameter.ToString());
+}
+
 //===--------------------------------------------------------------------===//
 // Code Block Extraction - Scalar Function
 //===--------------------------------------------------------------------===//
@@ -18,10 +42,11 @@ namespace duckdb {
 static void CodeBlockExtractionFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &input_vector = args.data[0];
 	auto count = args.size();
+	auto parser = GetMarkdownParser(state);
 
 	for (idx_t i = 0; i < count; i++) {
 		auto markdown_str = input_vector.GetValue(i).ToString();
-		auto code_blocks = markdown_utils::ExtractCodeBlocks(markdown_str, ""); // No language filter
+		auto code_blocks = markdown_utils::ExtractCodeBlocks(markdown_str, "", parser); // No language filter
 
 		vector<Value> struct_values;
 		for (const auto &block : code_blocks) {
@@ -50,10 +75,11 @@ static void LinkExtractionFunction(DataChunk &args, ExpressionState &state, Vect
 	auto &input_vector = args.data[0];
 
 	auto count = args.size();
+	auto parser = GetMarkdownParser(state);
 
 	for (idx_t i = 0; i < count; i++) {
 		auto markdown_str = input_vector.GetValue(i).ToString();
-		auto links = markdown_utils::ExtractLinks(markdown_str);
+		auto links = markdown_utils::ExtractLinks(markdown_str, parser);
 
 		vector<Value> struct_values;
 		for (const auto &link : links) {
@@ -83,10 +109,11 @@ static void ImageExtractionFunction(DataChunk &args, ExpressionState &state, Vec
 	auto &input_vector = args.data[0];
 
 	auto count = args.size();
+	auto parser = GetMarkdownParser(state);
 
 	for (idx_t i = 0; i < count; i++) {
 		auto markdown_str = input_vector.GetValue(i).ToString();
-		auto images = markdown_utils::ExtractImages(markdown_str);
+		auto images = markdown_utils::ExtractImages(markdown_str, parser);
 
 		vector<Value> struct_values;
 		for (const auto &image : images) {
@@ -233,117 +260,205 @@ static void TableRowExtractionFunction(DataChunk &args, ExpressionState &state,
 // Section Extraction - Scalar Function
 //===--------------------------------------------------------------------===//
 
+static Value SectionsToValue(const vector<markdown_utils::MarkdownSection> &sections) {
+	vector<Value> struct_values;
+	for (const auto &section : sections) {
+		child_list_t<Value> struct_children;
+		struct_children.push_back({"section_id", Value(section.id)});
+		struct_children.push_back({"section_path", Value(section.section_path)});
+		struct_children.push_back({"level", Value::INTEGER(section.level)});
+		struct_children.push_back({"title", Value(section.title)});
+		struct_children.push_back({"content", Value(section.content)});
+		struct_children.push_back(
+		    {"parent_id", section.parent_id.empty() ? Value(LogicalType::VARCHAR) : Value(section.parent_id)});
+		struct_children.push_back({"start_line", Value::BIGINT(static_cast<int64_t>(section.start_line))});
+		struct_children.push_back({"end_line", Value::BIGINT(static_cast<int64_t>(section.end_line))});
+		struct_children.push_back({"tree_lo", Value::BIGINT(static_cast<int64_t>(section.tree_lo))});
+		struct_children.push_back({"tree_hi", Value::BIGINT(static_cast<int64_t>(section.tree_hi))});
+		struct_children.push_back({"depth", Value::INTEGER(section.depth)});
+		struct_children.push_back(
+		    {"subtree_word_count", Value::BIGINT(static_cast<int64_t>(section.subtree_word_count))});
+		struct_values.push_back(Value::STRUCT(struct_children));
+	}
+
+	// For empty lists, we need to specify the type - use a simple empty list
+	if (struct_values.empty()) {
+		return Value::LIST(LogicalType::LIST(LogicalType::STRUCT({})), {});
+	}
+	return Value::LIST(struct_values);
+}
+
 static void SectionExtractionFunction(DataChunk &args, ExpressionState &state, Vector &result) {
 	auto &input_vector = args.data[0];
 	auto count = args.size();
 
+	auto memo = MarkdownMemoCache::Get(state.GetContext());
+
 	for (idx_t i = 0; i < count; i++) {
-		auto markdown_str = input_vector.GetValue(i).ToString();
+		auto input_value = input_vector.GetValue(i);
+		if (input_value.IsNull()) {
+			result.SetValue(i, Value());
+			continue;
+		}
+		auto markdown_str = input_value.ToString();
+		string_t memo_input(markdown_str);
+		MarkdownMemoCache::Key memo_key;
+		Value cached;
+		if (memo && memo->Lookup(MarkdownMemoFunction::EXTRACT_SECTIONS, memo_input, memo_key, cached)) {
+			result.SetValue(i, cached);
+			continue;
+		}
 		auto sections = markdown_utils::ExtractSections(markdown_str, 1, 6, true); // Extract all sections with content
-
-		vector<Value> struct_values;
-		for (const auto &section : sections) {
-			child_list_t<Value> struct_children;
-			struct_children.push_back({"section_id", Value(section.id)});
-			struct_children.push_back({"section_path", Value(section.section_path)});
-			struct_children.push_back({"level", Value::INTEGER(section.level)});
-			struct_children.push_back({"title", Value(section.title)});
-			struct_children.push_back({"content", Value(section.content)});
-			struct_children.push_back(
-			    {"parent_id", section.parent_id.empty() ? Value(LogicalType::VARCHAR) : Value(section.parent_id)});
-			struct_children.push_back({"start_line", Value::BIGINT(static_cast<int64_t>(section.start_line))});
-			struct_children.push_back({"end_line", Value::BIGINT(static_cast<int64_t>(section.end_line))});
-			struct_values.push_back(Value::STRUCT(struct_children));
+		auto list_value = SectionsToValue(sections);
+		if (memo) {
+			memo->Store(memo_key, memo_input, list_value);
 		}
+		result.SetValue(i, list_value);
+	}
+}
 
-		if (struct_values.empty()) {
-			// For empty lists, we need to specify the type - use a simple empty list
-			result.SetValue(i, Value::LIST(LogicalType::LIST(LogicalType::STRUCT({})), {}));
-		} else {
-			result.SetValue(i, Value::LIST(struct_values));
-		}
+// Options of the (md, min_level, max_level[, content_mode]) overloads. Constant
+// arguments are folded here at bind time; the rest are read per row.
+struct SectionExtractionBindData : public FunctionData {
+	bool min_level_constant = false;
+	bool max_level_constant = false;
+	bool content_mode_constant = false;
+	int32_t min_level = 1;
+	int32_t max_level = 6;
+	string content_mode = "minimal";
+
+	bool AllConstant() const {
+		return min_level_constant && max_level_constant && content_mode_constant;
 	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<SectionExtractionBindData>(*this);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SectionExtractionBindData>();
+		return min_level_constant == other.min_level_constant && max_level_constant == other.max_level_constant &&
+		       content_mode_constant == other.content_mode_constant && min_level == other.min_level &&
+		       max_level == other.max_level && content_mode == other.content_mode;
+	}
+};
+
+static int32_t LevelOrDefault(const Value &value, int32_t default_level) {
+	return value.IsNull() ? default_level : value.GetValue<int32_t>();
 }
 
-static void SectionExtractionFunctionWithLevels(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &input_vector = args.data[0];
-	auto &min_level_vector = args.data[1];
-	auto &max_level_vector = args.data[2];
+static string ContentModeOrDefault(const Value &value) {
+	return value.IsNull() ? string("minimal") : value.ToString();
+}
+
+// Markdown column only; min_level, max_level and content_mode were all folded
+static void SectionExtractionConstantFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<SectionExtractionBindData>();
 	auto count = args.size();
 
-	for (idx_t i = 0; i < count; i++) {
-		auto markdown_str = input_vector.GetValue(i).ToString();
-		auto min_level = static_cast<int32_t>(min_level_vector.GetValue(i).GetValue<int32_t>());
-		auto max_level = static_cast<int32_t>(max_level_vector.GetValue(i).GetValue<int32_t>());
-		auto sections = markdown_utils::ExtractSections(markdown_str, min_level, max_level, true);
+	UnifiedVectorFormat input_data;
+	args.data[0].ToUnifiedFormat(count, input_data);
+	auto inputs = UnifiedVectorFormat::GetData<string_t>(input_data);
 
-		vector<Value> struct_values;
-		for (const auto &section : sections) {
-			child_list_t<Value> struct_children;
-			struct_children.push_back({"section_id", Value(section.id)});
-			struct_children.push_back({"section_path", Value(section.section_path)});
-			struct_children.push_back({"level", Value::INTEGER(section.level)});
-			struct_children.push_back({"title", Value(section.title)});
-			struct_children.push_back({"content", Value(section.content)});
-			struct_children.push_back(
-			    {"parent_id", section.parent_id.empty() ? Value(LogicalType::VARCHAR) : Value(section.parent_id)});
-			struct_children.push_back({"start_line", Value::BIGINT(static_cast<int64_t>(section.start_line))});
-			struct_children.push_back({"end_line", Value::BIGINT(static_cast<int64_t>(section.end_line))});
-			struct_values.push_back(Value::STRUCT(struct_children));
-		}
-
-		if (struct_values.empty()) {
-			// For empty lists, we need to specify the type - use a simple empty list
-			result.SetValue(i, Value::LIST(LogicalType::LIST(LogicalType::STRUCT({})), {}));
-		} else {
-			result.SetValue(i, Value::LIST(struct_values));
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = input_data.sel->get_index(i);
+		if (!input_data.validity.RowIsValid(idx)) {
+			result.SetValue(i, Value());
+			continue;
 		}
+		auto sections = markdown_utils::ExtractSections(inputs[idx].GetString(), bind_data.min_level,
+		                                                bind_data.max_level, true, bind_data.content_mode);
+		result.SetValue(i, SectionsToValue(sections));
 	}
 }
 
-// Version with content_mode parameter
-static void SectionExtractionFunctionWithContentMode(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &input_vector = args.data[0];
-	auto &min_level_vector = args.data[1];
-	auto &max_level_vector = args.data[2];
-	auto &content_mode_vector = args.data[3];
+// At least one option varies per row; folded options are still taken from the bind data
+static void SectionExtractionVaryingFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<SectionExtractionBindData>();
 	auto count = args.size();
+	bool has_content_mode = args.ColumnCount() > 3;
+
+	UnifiedVectorFormat input_data;
+	args.data[0].ToUnifiedFormat(count, input_data);
+	auto inputs = UnifiedVectorFormat::GetData<string_t>(input_data);
+
+	UnifiedVectorFormat min_level_data;
+	UnifiedVectorFormat max_level_data;
+	UnifiedVectorFormat content_mode_data;
+	if (!bind_data.min_level_constant) {
+		args.data[1].ToUnifiedFormat(count, min_level_data);
+	}
+	if (!bind_data.max_level_constant) {
+		args.data[2].ToUnifiedFormat(count, max_level_data);
+	}
+	if (has_content_mode && !bind_data.content_mode_constant) {
+		args.data[3].ToUnifiedFormat(count, content_mode_data);
+	}
 
 	for (idx_t i = 0; i < count; i++) {
-		auto markdown_str = input_vector.GetValue(i).ToString();
-		auto min_level = static_cast<int32_t>(min_level_vector.GetValue(i).GetValue<int32_t>());
-		auto max_level = static_cast<int32_t>(max_level_vector.GetValue(i).GetValue<int32_t>());
+		auto idx = input_data.sel->get_index(i);
+		if (!input_data.validity.RowIsValid(idx)) {
+			result.SetValue(i, Value());
+			continue;
+		}
 
-		std::string content_mode = "minimal";
-		auto mode_value = content_mode_vector.GetValue(i);
-		if (!mode_value.IsNull()) {
-			content_mode = mode_value.ToString();
+		auto min_level = bind_data.min_level;
+		if (!bind_data.min_level_constant) {
+			auto level_idx = min_level_data.sel->get_index(i);
+			if (min_level_data.validity.RowIsValid(level_idx)) {
+				min_level = UnifiedVectorFormat::GetData<int32_t>(min_level_data)[level_idx];
+			}
+		}
+		auto max_level = bind_data.max_level;
+		if (!bind_data.max_level_constant) {
+			auto level_idx = max_level_data.sel->get_index(i);
+			if (max_level_data.validity.RowIsValid(level_idx)) {
+				max_level = UnifiedVectorFormat::GetData<int32_t>(max_level_data)[level_idx];
+			}
+		}
+		string varying_mode;
+		const string *content_mode = &bind_data.content_mode;
+		if (has_content_mode && !bind_data.content_mode_constant) {
+			auto mode_idx = content_mode_data.sel->get_index(i);
+			if (content_mode_data.validity.RowIsValid(mode_idx)) {
+				varying_mode = UnifiedVectorFormat::GetData<string_t>(content_mode_data)[mode_idx].GetString();
+				content_mode = &varying_mode;
+			}
 		}
 
-		auto sections = markdown_utils::ExtractSections(markdown_str, min_level, max_level, true, content_mode);
+		auto sections =
+		    markdown_utils::ExtractSections(inputs[idx].GetString(), min_level, max_level, true, *content_mode);
+		result.SetValue(i, SectionsToValue(sections));
+	}
+}
 
-		vector<Value> struct_values;
-		for (const auto &section : sections) {
-			child_list_t<Value> struct_children;
-			struct_children.push_back({"section_id", Value(section.id)});
-			struct_children.push_back({"section_path", Value(section.section_path)});
-			struct_children.push_back({"level", Value::INTEGER(section.level)});
-			struct_children.push_back({"title", Value(section.title)});
-			struct_children.push_back({"content", Value(section.content)});
-			struct_children.push_back(
-			    {"parent_id", section.parent_id.empty() ? Value(LogicalType::VARCHAR) : Value(section.parent_id)});
-			struct_children.push_back({"start_line", Value::BIGINT(static_cast<int64_t>(section.start_line))});
-			struct_children.push_back({"end_line", Value::BIGINT(static_cast<int64_t>(section.end_line))});
-			struct_values.push_back(Value::STRUCT(struct_children));
-		}
+static unique_ptr<FunctionData> SectionExtractionBind(ClientContext &context, ScalarFunction &bound_function,
+                                                      vector<unique_ptr<Expression>> &arguments) {
+	auto result = make_uniq<SectionExtractionBindData>();
+	if (arguments[1]->IsFoldable()) {
+		result->min_level = LevelOrDefault(ExpressionExecutor::EvaluateScalar(context, *arguments[1]), 1);
+		result->min_level_constant = true;
+	}
+	if (arguments[2]->IsFoldable()) {
+		result->max_level = LevelOrDefault(ExpressionExecutor::EvaluateScalar(context, *arguments[2]), 6);
+		result->max_level_constant = true;
+	}
+	if (arguments.size() < 4) {
+		result->content_mode_constant = true;
+	} else if (arguments[3]->IsFoldable()) {
+		result->content_mode = ContentModeOrDefault(ExpressionExecutor::EvaluateScalar(context, *arguments[3]));
+		result->content_mode_constant = true;
+	}
 
-		if (struct_values.empty()) {
-			// For empty lists, we need to specify the type - use a simple empty list
-			result.SetValue(i, Value::LIST(LogicalType::LIST(LogicalType::STRUCT({})), {}));
-		} else {
-			result.SetValue(i, Value::LIST(struct_values));
-		}
+	// Pick the kernel once; constant default options are the memoized one-argument form
+	if (!result->AllConstant()) {
+		bound_function.function = SectionExtractionVaryingFunction;
+	} else if (result->min_level == 1 && result->max_level == 6 && result->content_mode == "minimal") {
+		bound_function.function = SectionExtractionFunction;
+	} else {
+		bound_function.function = SectionExtractionConstantFunction;
 	}
+	return std::move(result);
 }
 
 //===--------------------------------------------------------------------===//
@@ -416,6 +531,12 @@ static void TableJSONExtractionFunction(DataChunk &args, ExpressionState &state,
 //===--------------------------------------------------------------------===//
 
 void MarkdownExtractionFunctions::Register(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(MARKDOWN_PARSER_SETTING,
+	                          "Parser backend of md_extract_code_blocks/md_extract_links/md_extract_images: "
+	                          "'cmark' (cmark-gfm node tree) or 'md4c' (tree-free event stream)",
+	                          LogicalType::VARCHAR, Value("cmark"), ValidateMarkdownParser);
+
 	// Define return types for scalar functions
 	auto code_block_struct_type = LogicalType::STRUCT({{"language", LogicalType(LogicalTypeId::VARCHAR)},
 	                                                   {"code", LogicalType(LogicalTypeId::VARCHAR)},
@@ -502,7 +623,11 @@ void MarkdownExtractionFunctions::Register(ExtensionLoader &loader) {
 	                                                       {"content", MarkdownTypes::MarkdownType()},
 	                                                       {"parent_id", LogicalType::VARCHAR},
 	                                                       {"start_line", LogicalType::BIGINT},
-	                                                       {"end_line", LogicalType::BIGINT}});
+	                                                       {"end_line", LogicalType::BIGINT},
+	                                                       {"tree_lo", LogicalType::BIGINT},
+	                                                       {"tree_hi", LogicalType::BIGINT},
+	                                                       {"depth", LogicalType::INTEGER},
+	                                                       {"subtree_word_count", LogicalType::BIGINT}});
 
 	// Register main function with MARKDOWN type
 	ScalarFunction sections_func("md_extract_sections", {MarkdownTypes::MarkdownType()},
@@ -510,15 +635,15 @@ void MarkdownExtractionFunctions::Register(ExtensionLoader &loader) {
 	loader.RegisterFunction(sections_func);
 
 	// Register overload for VARCHAR with level filtering
-	ScalarFunction sections_levels_func("md_extract_sections",
-	                                    {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::INTEGER},
-	                                    LogicalType::LIST(section_struct_type), SectionExtractionFunctionWithLevels);
+	ScalarFunction sections_levels_func(
+	    "md_extract_sections", {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::INTEGER},
+	    LogicalType::LIST(section_struct_type), SectionExtractionVaryingFunction, SectionExtractionBind);
 	loader.RegisterFunction(sections_levels_func);
 
 	// Register overload for VARCHAR with level filtering and content_mode
 	ScalarFunction sections_content_mode_func(
 	    "md_extract_sections", {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::VARCHAR},
-	    LogicalType::LIST(section_struct_type), SectionExtractionFunctionWithContentMode);
+	    LogicalType::LIST(section_struct_type), SectionExtractionVaryingFunction, SectionExtractionBind);
 	loader.RegisterFunction(sections_content_mode_func);
 }
 
@@ -0,0 +1,927 @@
+#include "markdown_git.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "miniz.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+namespace markdown_git {
+
+static constexpr idx_t GIT_OID_SIZE = 20;
+static constexpr idx_t GIT_OID_HEX_SIZE = 40;
+// Guards against corrupt or cyclic delta chains (git itself defaults to depth 50)
+static constexpr idx_t GIT_MAX_DELTA_CHAIN = 10000;
+static constexpr idx_t GIT_MAX_REF_DEPTH = 10;
+static constexpr idx_t GIT_PACK_READ_CHUNK = 1 << 16;
+
+//===--------------------------------------------------------------------===//
+// Object Id / Byte Helpers
+//===--------------------------------------------------------------------===//
+
+std::string OidToHex(const uint8_t *oid) {
+	static const char *digits = "0123456789abcdef";
+	std::string result(GIT_OID_HEX_SIZE, '0');
+	for (idx_t i = 0; i < GIT_OID_SIZE; i++) {
+		result[i * 2] = digits[oid[i] >> 4];
+		result[i * 2 + 1] = digits[oid[i] & 0x0F];
+	}
+	return result;
+}
+
+static int HexDigitValue(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+static bool IsHexString(const std::string &str) {
+	for (char c : str) {
+		if (HexDigitValue(c) < 0) {
+			return false;
+		}
+	}
+	return !str.empty();
+}
+
+bool HexToOid(const std::string &hex, uint8_t *oid) {
+	if (hex.size() != GIT_OID_HEX_SIZE) {
+		return false;
+	}
+	for (idx_t i = 0; i < GIT_OID_SIZE; i++) {
+		int hi = HexDigitValue(hex[i * 2]);
+		int lo = HexDigitValue(hex[i * 2 + 1]);
+		if (hi < 0 || lo < 0) {
+			return false;
+		}
+		oid[i] = static_cast<uint8_t>((hi << 4) | lo);
+	}
+	return true;
+}
+
+static uint32_t ReadBE32(const uint8_t *data) {
+	return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+	       (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+static uint64_t ReadBE64(const uint8_t *data) {
+	return (static_cast<uint64_t>(ReadBE32(data)) << 32) | ReadBE32(data + 4);
+}
+
+//===--------------------------------------------------------------------===//
+// Zlib Inflation (DuckDB's bundled miniz)
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+class MinizInflater {
+public:
+	MinizInflater() {
+		memset(&stream, 0, sizeof(stream));
+		if (duckdb_miniz::mz_inflateInit(&stream) != duckdb_miniz::MZ_OK) {
+			throw IOException("Failed to initialize zlib decompression for git object");
+		}
+	}
+	~MinizInflater() {
+		duckdb_miniz::mz_inflateEnd(&stream);
+	}
+
+	duckdb_miniz::mz_stream stream;
+};
+
+} // namespace
+
+// Inflate a complete zlib stream of unknown output size (loose objects)
+static std::string InflateAll(const std::string &compressed) {
+	MinizInflater inflater;
+	auto &stream = inflater.stream;
+	std::string out;
+	out.resize(MaxValue<idx_t>(compressed.size() * 2, 256));
+
+	stream.next_in = reinterpret_cast<const unsigned char *>(compressed.data());
+	stream.avail_in = static_cast<unsigned int>(compressed.size());
+	while (true) {
+		auto produced = static_cast<idx_t>(stream.total_out);
+		if (produced == out.size()) {
+			out.resize(out.size() * 2);
+		}
+		stream.next_out = reinterpret_cast<unsigned char *>(&out[produced]);
+		stream.avail_out = static_cast<unsigned int>(out.size() - produced);
+		auto status = duckdb_miniz::mz_inflate(&stream, duckdb_miniz::MZ_NO_FLUSH);
+		if (status == duckdb_miniz::MZ_STREAM_END) {
+			break;
+		}
+		if (status != duckdb_miniz::MZ_OK || (stream.avail_in == 0 && stream.avail_out != 0)) {
+			throw IOException("Corrupt zlib stream in git object");
+		}
+	}
+	out.resize(static_cast<idx_t>(stream.total_out));
+	return out;
+}
+
+static GitObjectType ParseTypeName(const std::string &name) {
+	if (name == "blob") {
+		return GitObjectType::BLOB;
+	}
+	if (name == "tree") {
+		return GitObjectType::TREE;
+	}
+	if (name == "commit") {
+		return GitObjectType::COMMIT;
+	}
+	if (name == "tag") {
+		return GitObjectType::TAG;
+	}
+	return GitObjectType::NONE;
+}
+
+//===--------------------------------------------------------------------===//
+// Delta Application
+//===--------------------------------------------------------------------===//
+
+static idx_t ReadDeltaVarint(const std::string &delta, idx_t &pos) {
+	idx_t value = 0;
+	idx_t shift = 0;
+	uint8_t c;
+	do {
+		if (pos >= delta.size() || shift > 63) {
+			throw IOException("Corrupt git delta header");
+		}
+		c = static_cast<uint8_t>(delta[pos++]);
+		value |= static_cast<idx_t>(c & 0x7F) << shift;
+		shift += 7;
+	} while (c & 0x80);
+	return value;
+}
+
+static std::string ApplyDelta(const std::string &base, const std::string &delta) {
+	idx_t pos = 0;
+	auto source_size = ReadDeltaVarint(delta, pos);
+	auto target_size = ReadDeltaVarint(delta, pos);
+	if (source_size != base.size()) {
+		throw IOException("Git delta base size mismatch (%llu vs %llu)", source_size, base.size());
+	}
+
+	std::string result;
+	result.reserve(target_size);
+	while (pos < delta.size()) {
+		auto cmd = static_cast<uint8_t>(delta[pos++]);
+		if (cmd & 0x80) {
+			// Copy from base: bits 0-3 select offset bytes, bits 4-6 select size bytes
+			idx_t offset = 0;
+			idx_t size = 0;
+			for (idx_t i = 0; i < 4; i++) {
+				if (cmd & (1 << i)) {
+					if (pos >= delta.size()) {
+						throw IOException("Corrupt git delta copy instruction");
+					}
+					offset |= static_cast<idx_t>(static_cast<uint8_t>(delta[pos++])) << (8 * i);
+				}
+			}
+			for (idx_t i = 0; i < 3; i++) {
+				if (cmd & (0x10 << i)) {
+					if (pos >= delta.size()) {
+						throw IOException("Corrupt git delta copy instruction");
+					}
+					size |= static_cast<idx_t>(static_cast<uint8_t>(delta[pos++])) << (8 * i);
+				}
+			}
+			if (size == 0) {
+				size = 0x10000;
+			}
+			if (offset + size > base.size()) {
+				throw IOException("Git delta copy out of range");
+			}
+			result.append(base, offset, size);
+		} else if (cmd != 0) {
+			// Insert the next cmd literal bytes
+			if (pos + cmd > delta.size()) {
+				throw IOException("Git delta insert out of range");
+			}
+			result.append(delta, pos, cmd);
+			pos += cmd;
+		} else {
+			throw IOException("Corrupt git delta (reserved opcode)");
+		}
+	}
+	if (result.size() != target_size) {
+		throw IOException("Git delta result size mismatch (%llu vs %llu)", result.size(), target_size);
+	}
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Path Globbing
+//===--------------------------------------------------------------------===//
+
+// Match a bracket expression at p (pointing at '['). Returns the position after ']',
+// or nullptr when the class is unterminated (then '[' is matched literally).
+static const char *MatchCharClass(const char *p, char c, bool &matched) {
+	const char *q = p + 1;
+	bool negate = false;
+	if (*q == '!' || *q == '^') {
+		negate = true;
+		q++;
+	}
+	bool found = false;
+	bool first = true;
+	while (*q && (*q != ']' || first)) {
+		first = false;
+		if (q[1] == '-' && q[2] && q[2] != ']') {
+			if (c >= q[0] && c <= q[2]) {
+				found = true;
+			}
+			q += 3;
+		} else {
+			if (c == *q) {
+				found = true;
+			}
+			q++;
+		}
+	}
+	if (*q != ']') {
+		return nullptr;
+	}
+	matched = found != negate;
+	return q + 1;
+}
+
+static bool GlobMatchAt(const char *p, const char *s) {
+	while (*p) {
+		if (p[0] == '*' && p[1] == '*') {
+			const char *rest = p + 2;
+			if (*rest == '/') {
+				// "**/" matches zero or more leading directories
+				rest++;
+				if (GlobMatchAt(rest, s)) {
+					return true;
+				}
+				for (const char *t = s; *t; t++) {
+					if (*t == '/' && GlobMatchAt(rest, t + 1)) {
+						return true;
+					}
+				}
+				return false;
+			}
+			// Any other "**" matches across separators
+			for (const char *t = s;; t++) {
+				if (GlobMatchAt(rest, t)) {
+					return true;
+				}
+				if (!*t) {
+					return false;
+				}
+			}
+		}
+		if (*p == '*') {
+			p++;
+			for (const char *t = s;; t++) {
+				if (GlobMatchAt(p, t)) {
+					return true;
+				}
+				if (!*t || *t == '/') {
+					return false;
+				}
+			}
+		}
+		if (!*s) {
+			return false;
+		}
+		if (*p == '?') {
+			if (*s == '/') {
+				return false;
+			}
+			p++;
+			s++;
+			continue;
+		}
+		if (*p == '[') {
+			bool matched = false;
+			auto next = MatchCharClass(p, *s, matched);
+			if (next) {
+				if (!matched || *s == '/') {
+					return false;
+				}
+				p = next;
+				s++;
+				continue;
+			}
+		}
+		if (*p != *s) {
+			return false;
+		}
+		p++;
+		s++;
+	}
+	return *s == '\0';
+}
+
+bool GitGlobMatch(const std::string &pattern, const std::string &path) {
+	if (pattern.find('/') == std::string::npos) {
+		// Like .gitignore: a pattern without a slash matches the file name at any depth
+		auto slash = path.rfind('/');
+		auto name = slash == std::string::npos ? path : path.substr(slash + 1);
+		return GlobMatchAt(pattern.c_str(), name.c_str());
+	}
+	return GlobMatchAt(pattern.c_str(), path.c_str());
+}
+
+// Literal directory prefix of a glob ("docs/api/**/*.md" -> "docs/api/"), used to prune the tree walk
+static std::string GlobLiteralDirectory(const std::string &pattern) {
+	auto wildcard = pattern.find_first_of("*?[");
+	auto literal = pattern.substr(0, wildcard);
+	auto slash = literal.rfind('/');
+	if (slash == std::string::npos || pattern.find('/') == std::string::npos) {
+		return "";
+	}
+	return literal.substr(0, slash + 1);
+}
+
+//===--------------------------------------------------------------------===//
+// Repository
+//===--------------------------------------------------------------------===//
+
+struct GitRepository::PackFile {
+	std::string pack_path;
+	unique_ptr<FileHandle> handle;
+	idx_t pack_size = 0;
+	// Whole .idx file; fanout/oids/offsets point into it
+	std::string index_data;
+	const uint8_t *fanout = nullptr;
+	const uint8_t *oids = nullptr;
+	const uint8_t *offsets = nullptr;
+	const uint8_t *large_offsets = nullptr;
+	idx_t large_offset_count = 0;
+	idx_t object_count = 0;
+
+	// Index of oid in this pack, or -1
+	int64_t Find(const uint8_t *oid) const {
+		idx_t lo = oid[0] == 0 ? 0 : ReadBE32(fanout + (oid[0] - 1) * 4);
+		idx_t hi = ReadBE32(fanout + oid[0] * 4);
+		while (lo < hi) {
+			auto mid = lo + (hi - lo) / 2;
+			auto cmp = memcmp(oids + mid * GIT_OID_SIZE, oid, GIT_OID_SIZE);
+			if (cmp == 0) {
+				return static_cast<int64_t>(mid);
+			}
+			if (cmp < 0) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		return -1;
+	}
+
+	idx_t OffsetOf(idx_t entry) const {
+		auto offset = ReadBE32(offsets + entry * 4);
+		if (offset & 0x80000000) {
+			auto large_idx = offset & 0x7FFFFFFF;
+			if (large_idx >= large_offset_count) {
+				throw IOException("Corrupt pack index %s", pack_path);
+			}
+			return ReadBE64(large_offsets + large_idx * 8);
+		}
+		return offset;
+	}
+};
+
+GitRepository::GitRepository(FileSystem &fs_p, const std::string &repo_path, idx_t delta_cache_size)
+    : fs(fs_p), delta_base_cache(delta_cache_size) {
+	auto dot_git = fs.JoinPath(repo_path, ".git");
+	if (fs.DirectoryExists(dot_git)) {
+		git_dir = dot_git;
+	} else if (fs.FileExists(dot_git)) {
+		// Linked worktree or submodule: ".git" is a file containing "gitdir: <path>"
+		auto gitfile = ReadFileToString(dot_git);
+		StringUtil::Trim(gitfile);
+		if (!StringUtil::StartsWith(gitfile, "gitdir:")) {
+			throw InvalidInputException("'%s' is not a git repository (unreadable .git file)", repo_path);
+		}
+		auto target = gitfile.substr(7);
+		StringUtil::Trim(target);
+		git_dir = fs.IsPathAbsolute(target) ? target : fs.JoinPath(repo_path, target);
+	} else if (fs.FileExists(fs.JoinPath(repo_path, "HEAD")) &&
+	           fs.DirectoryExists(fs.JoinPath(repo_path, "objects"))) {
+		// Bare repository
+		git_dir = repo_path;
+	} else {
+		throw InvalidInputException("'%s' is not a git repository", repo_path);
+	}
+
+	common_dir = git_dir;
+	auto commondir_file = fs.JoinPath(git_dir, "commondir");
+	if (fs.FileExists(commondir_file)) {
+		auto common = ReadFileToString(commondir_file);
+		StringUtil::Trim(common);
+		common_dir = fs.IsPathAbsolute(common) ? common : fs.JoinPath(git_dir, common);
+	}
+}
+
+GitRepository::~GitRepository() {
+}
+
+std::string GitRepository::ReadFileToString(const std::string &path) {
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	auto size = fs.GetFileSize(*handle);
+	std::string result;
+	result.resize(static_cast<idx_t>(size));
+	if (size > 0) {
+		fs.Read(*handle, &result[0], size);
+	}
+	return result;
+}
+
+void GitRepository::LoadPacks() {
+	if (packs_loaded) {
+		return;
+	}
+	packs_loaded = true;
+
+	auto pack_dir = fs.JoinPath(fs.JoinPath(common_dir, "objects"), "pack");
+	if (!fs.DirectoryExists(pack_dir)) {
+		return;
+	}
+	vector<string> index_files;
+	fs.ListFiles(pack_dir, [&](const string &name, bool is_dir) {
+		if (!is_dir && StringUtil::EndsWith(name, ".idx")) {
+			index_files.push_back(name);
+		}
+	});
+	std::sort(index_files.begin(), index_files.end());
+
+	for (auto &index_name : index_files) {
+		auto pack = make_uniq<PackFile>();
+		auto index_path = fs.JoinPath(pack_dir, index_name);
+		pack->pack_path = fs.JoinPath(pack_dir, index_name.substr(0, index_name.size() - 4) + ".pack");
+		if (!fs.FileExists(pack->pack_path)) {
+			continue;
+		}
+		pack->index_data = ReadFileToString(index_path);
+
+		auto data = reinterpret_cast<const uint8_t *>(pack->index_data.data());
+		auto size = pack->index_data.size();
+		static const uint8_t index_magic[] = {0xFF, 't', 'O', 'c'};
+		if (size < 8 + 256 * 4 || memcmp(data, index_magic, 4) != 0 || ReadBE32(data + 4) != 2) {
+			throw IOException("Unsupported pack index %s (only version 2 is supported)", index_path);
+		}
+		pack->fanout = data + 8;
+		pack->object_count = ReadBE32(pack->fanout + 255 * 4);
+		auto n = pack->object_count;
+		idx_t oids_start = 8 + 256 * 4;
+		idx_t offsets_start = oids_start + n * GIT_OID_SIZE + n * 4; // skip CRC32 table
+		idx_t large_start = offsets_start + n * 4;
+		// Trailer: pack checksum + index checksum
+		if (large_start + 2 * GIT_OID_SIZE > size) {
+			throw IOException("Truncated pack index %s", index_path);
+		}
+		pack->oids = data + oids_start;
+		pack->offsets = data + offsets_start;
+		pack->large_offsets = data + large_start;
+		pack->large_offset_count = (size - 2 * GIT_OID_SIZE - large_start) / 8;
+
+		pack->handle = fs.OpenFile(pack->pack_path, FileOpenFlags::FILE_FLAGS_READ);
+		pack->pack_size = static_cast<idx_t>(fs.GetFileSize(*pack->handle));
+		packs.push_back(std::move(pack));
+	}
+}
+
+std::string GitRepository::InflatePackData(PackFile &pack, idx_t offset, idx_t expected_size) {
+	MinizInflater inflater;
+	auto &stream = inflater.stream;
+	// One spare byte so an empty object still has an output buffer
+	std::string out;
+	out.resize(expected_size + 1);
+	stream.next_out = reinterpret_cast<unsigned char *>(&out[0]);
+	stream.avail_out = static_cast<unsigned int>(out.size());
+
+	// Compressed data is rarely much larger than its output, so size the first read to match
+	std::string chunk;
+	idx_t chunk_size = MinValue<idx_t>(MaxValue<idx_t>(expected_size + 64, 512), GIT_PACK_READ_CHUNK);
+	idx_t position = offset;
+	while (true) {
+		if (stream.avail_in == 0) {
+			if (position >= pack.pack_size) {
+				throw IOException("Truncated object data in %s", pack.pack_path);
+			}
+			auto read_size = MinValue<idx_t>(chunk_size, pack.pack_size - position);
+			chunk.resize(read_size);
+			fs.Read(*pack.handle, &chunk[0], static_cast<int64_t>(read_size), position);
+			position += read_size;
+			chunk_size = GIT_PACK_READ_CHUNK;
+			stream.next_in = reinterpret_cast<const unsigned char *>(chunk.data());
+			stream.avail_in = static_cast<unsigned int>(read_size);
+		}
+		auto status = duckdb_miniz::mz_inflate(&stream, duckdb_miniz::MZ_NO_FLUSH);
+		if (status == duckdb_miniz::MZ_STREAM_END) {
+			break;
+		}
+		if (status != duckdb_miniz::MZ_OK) {
+			throw IOException("Corrupt object data in %s at offset %llu", pack.pack_path, offset);
+		}
+	}
+	if (static_cast<idx_t>(stream.total_out) != expected_size) {
+		throw IOException("Object size mismatch in %s at offset %llu", pack.pack_path, offset);
+	}
+	out.resize(expected_size);
+	return out;
+}
+
+GitObject GitRepository::ReadPackedObjectAt(idx_t pack_idx, idx_t offset) {
+	auto &pack = *packs[pack_idx];
+	auto cache_prefix = std::to_string(pack_idx) + ":";
+
+	// Walk the delta chain down to a full object (or a cached base), then apply deltas upwards
+	vector<std::string> deltas;
+	vector<idx_t> delta_offsets;
+	GitObject base;
+	idx_t current = offset;
+	while (true) {
+		if (deltas.size() > GIT_MAX_DELTA_CHAIN) {
+			throw IOException("Git delta chain too deep in %s", pack.pack_path);
+		}
+		if (!deltas.empty()) {
+			auto cached = delta_base_cache.Get(cache_prefix + std::to_string(current));
+			if (cached) {
+				base = *cached;
+				break;
+			}
+		}
+
+		// Entry header: type + varint size, then an OFS/REF base reference
+		uint8_t header[32];
+		if (current >= pack.pack_size) {
+			throw IOException("Object offset out of range in %s", pack.pack_path);
+		}
+		auto header_size = MinValue<idx_t>(sizeof(header), pack.pack_size - current);
+		fs.Read(*pack.handle, header, static_cast<int64_t>(header_size), current);
+		idx_t pos = 0;
+		uint8_t c = header[pos++];
+		auto type = static_cast<GitObjectType>((c >> 4) & 0x07);
+		idx_t size = c & 0x0F;
+		idx_t shift = 4;
+		while (c & 0x80) {
+			if (pos >= header_size || shift > 63) {
+				throw IOException("Corrupt object header in %s", pack.pack_path);
+			}
+			c = header[pos++];
+			size |= static_cast<idx_t>(c & 0x7F) << shift;
+			shift += 7;
+		}
+
+		if (type == GitObjectType::OFS_DELTA) {
+			if (pos >= header_size) {
+				throw IOException("Corrupt delta header in %s", pack.pack_path);
+			}
+			c = header[pos++];
+			idx_t distance = c & 0x7F;
+			while (c & 0x80) {
+				if (pos >= header_size) {
+					throw IOException("Corrupt delta header in %s", pack.pack_path);
+				}
+				c = header[pos++];
+				distance = ((distance + 1) << 7) | (c & 0x7F);
+			}
+			if (distance == 0 || distance > current) {
+				throw IOException("Corrupt delta base offset in %s", pack.pack_path);
+			}
+			deltas.push_back(InflatePackData(pack, current + pos, size));
+			delta_offsets.push_back(current);
+			current -= distance;
+			continue;
+		}
+		if (type == GitObjectType::REF_DELTA) {
+			if (pos + GIT_OID_SIZE > header_size) {
+				throw IOException("Corrupt delta header in %s", pack.pack_path);
+			}
+			auto base_id = OidToHex(header + pos);
+			deltas.push_back(InflatePackData(pack, current + pos + GIT_OID_SIZE, size));
+			delta_offsets.push_back(current);
+			base = ReadObject(base_id);
+			break;
+		}
+		if (type == GitObjectType::NONE || static_cast<uint8_t>(type) > static_cast<uint8_t>(GitObjectType::TAG)) {
+			throw IOException("Unknown object type in %s at offset %llu", pack.pack_path, current);
+		}
+		base.type = type;
+		base.data = InflatePackData(pack, current + pos, size);
+		if (!deltas.empty()) {
+			delta_base_cache.Put(cache_prefix + std::to_string(current), make_shared_ptr<GitObject>(base),
+			                     base.data.size());
+		}
+		break;
+	}
+
+	for (idx_t i = deltas.size(); i > 0; i--) {
+		base.data = ApplyDelta(base.data, deltas[i - 1]);
+		// Every intermediate result is the base of the next delta up the chain
+		if (i > 1) {
+			delta_base_cache.Put(cache_prefix + std::to_string(delta_offsets[i - 1]), make_shared_ptr<GitObject>(base),
+			                     base.data.size());
+		}
+	}
+	return base;
+}
+
+bool GitRepository::TryReadPackedObject(const uint8_t *oid, GitObject &result) {
+	LoadPacks();
+	for (idx_t i = 0; i < packs.size(); i++) {
+		auto entry = packs[i]->Find(oid);
+		if (entry >= 0) {
+			result = ReadPackedObjectAt(i, packs[i]->OffsetOf(static_cast<idx_t>(entry)));
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GitRepository::TryReadLooseObject(const std::string &oid_hex, GitObject &result) {
+	auto path = fs.JoinPath(fs.JoinPath(fs.JoinPath(common_dir, "objects"), oid_hex.substr(0, 2)), oid_hex.substr(2));
+	if (!fs.FileExists(path)) {
+		return false;
+	}
+	auto raw = InflateAll(ReadFileToString(path));
+	// "<type> <size>\0<data>"
+	auto space = raw.find(' ');
+	auto nul = raw.find('\0');
+	if (space == std::string::npos || nul == std::string::npos || space > nul) {
+		throw IOException("Corrupt loose object %s", oid_hex);
+	}
+	result.type = ParseTypeName(raw.substr(0, space));
+	if (result.type == GitObjectType::NONE) {
+		throw IOException("Unknown type of loose object %s", oid_hex);
+	}
+	result.data = raw.substr(nul + 1);
+	return true;
+}
+
+GitObject GitRepository::ReadObject(const std::string &oid_hex) {
+	uint8_t oid[GIT_OID_SIZE];
+	auto hex = StringUtil::Lower(oid_hex);
+	if (!HexToOid(hex, oid)) {
+		throw InvalidInputException("Invalid git object id '%s'", oid_hex);
+	}
+	GitObject result;
+	if (TryReadPackedObject(oid, result) || TryReadLooseObject(hex, result)) {
+		return result;
+	}
+	throw InvalidInputException("Git object %s not found in %s", oid_hex, common_dir);
+}
+
+//===--------------------------------------------------------------------===//
+// Revision Resolution
+//===--------------------------------------------------------------------===//
+
+void GitRepository::LoadPackedRefs() {
+	if (packed_refs_loaded) {
+		return;
+	}
+	packed_refs_loaded = true;
+	auto path = fs.JoinPath(common_dir, "packed-refs");
+	if (!fs.FileExists(path)) {
+		return;
+	}
+	auto content = ReadFileToString(path);
+	for (auto &line : StringUtil::Split(content, "\n")) {
+		// Skip the header comment and "^<id>" peeled-tag lines
+		if (line.size() < GIT_OID_HEX_SIZE + 2 || line[0] == '#' || line[0] == '^') {
+			continue;
+		}
+		auto name = line.substr(GIT_OID_HEX_SIZE + 1);
+		StringUtil::Trim(name);
+		packed_refs[name] = line.substr(0, GIT_OID_HEX_SIZE);
+	}
+}
+
+std::string GitRepository::ReadRef(const std::string &ref_name, idx_t depth) {
+	if (depth > GIT_MAX_REF_DEPTH) {
+		throw InvalidInputException("Symbolic ref loop at '%s'", ref_name);
+	}
+	std::string content;
+	for (auto &dir : {git_dir, common_dir}) {
+		auto path = fs.JoinPath(dir, ref_name);
+		if (fs.FileExists(path)) {
+			content = ReadFileToString(path);
+			break;
+		}
+	}
+	if (content.empty()) {
+		LoadPackedRefs();
+		auto entry = packed_refs.find(ref_name);
+		return entry == packed_refs.end() ? "" : entry->second;
+	}
+	StringUtil::Trim(content);
+	if (StringUtil::StartsWith(content, "ref:")) {
+		auto target = content.substr(4);
+		StringUtil::Trim(target);
+		return ReadRef(target, depth + 1);
+	}
+	content = content.substr(0, GIT_OID_HEX_SIZE);
+	return content.size() == GIT_OID_HEX_SIZE && IsHexString(content) ? content : "";
+}
+
+std::string GitRepository::ExpandAbbreviatedId(const std::string &prefix_p) {
+	auto prefix = StringUtil::Lower(prefix_p);
+	vector<std::string> matches;
+
+	auto loose_dir = fs.JoinPath(fs.JoinPath(common_dir, "objects"), prefix.substr(0, 2));
+	if (fs.DirectoryExists(loose_dir)) {
+		auto rest = prefix.substr(2);
+		fs.ListFiles(loose_dir, [&](const string &name, bool is_dir) {
+			if (!is_dir && StringUtil::StartsWith(name, rest)) {
+				matches.push_back(prefix.substr(0, 2) + name);
+			}
+		});
+	}
+
+	LoadPacks();
+	auto first_byte = static_cast<uint8_t>((HexDigitValue(prefix[0]) << 4) | HexDigitValue(prefix[1]));
+	for (auto &pack : packs) {
+		idx_t lo = first_byte == 0 ? 0 : ReadBE32(pack->fanout + (first_byte - 1) * 4);
+		idx_t hi = ReadBE32(pack->fanout + first_byte * 4);
+		for (idx_t i = lo; i < hi; i++) {
+			auto hex = OidToHex(pack->oids + i * GIT_OID_SIZE);
+			if (StringUtil::StartsWith(hex, prefix)) {
+				matches.push_back(hex);
+			}
+		}
+	}
+
+	std::sort(matches.begin(), matches.end());
+	matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+	if (matches.size() > 1) {
+		throw InvalidInputException("Ambiguous abbreviated git object id '%s'", prefix_p);
+	}
+	return matches.empty() ? "" : matches[0];
+}
+
+std::string GitRepository::ResolveRefName(const std::string &name_p) {
+	auto name = name_p == "@" ? std::string("HEAD") : name_p;
+	if (name.size() == GIT_OID_HEX_SIZE && IsHexString(name)) {
+		return StringUtil::Lower(name);
+	}
+	// Same lookup order as git rev-parse
+	const std::string candidates[] = {name,
+	                                  "refs/" + name,
+	                                  "refs/tags/" + name,
+	                                  "refs/heads/" + name,
+	                                  "refs/remotes/" + name,
+	                                  "refs/remotes/" + name + "/HEAD"};
+	for (auto &candidate : candidates) {
+		auto oid = ReadRef(candidate, 0);
+		if (!oid.empty()) {
+			return oid;
+		}
+	}
+	if (name.size() >= 4 && IsHexString(name)) {
+		auto oid = ExpandAbbreviatedId(name);
+		if (!oid.empty()) {
+			return oid;
+		}
+	}
+	throw InvalidInputException("Unknown git revision '%s' in %s", name_p, git_dir);
+}
+
+std::string GitRepository::PeelToCommit(std::string oid_hex) {
+	for (idx_t depth = 0; depth <= GIT_MAX_REF_DEPTH; depth++) {
+		auto object = ReadObject(oid_hex);
+		if (object.type == GitObjectType::COMMIT) {
+			return oid_hex;
+		}
+		if (object.type != GitObjectType::TAG || !StringUtil::StartsWith(object.data, "object ")) {
+			throw InvalidInputException("Git object %s does not name a commit", oid_hex);
+		}
+		oid_hex = object.data.substr(7, GIT_OID_HEX_SIZE);
+	}
+	throw InvalidInputException("Tag chain too deep at %s", oid_hex);
+}
+
+// Parent ids of a commit, in order
+static vector<std::string> CommitParents(const std::string &commit_data) {
+	vector<std::string> parents;
+	idx_t pos = 0;
+	while (pos < commit_data.size()) {
+		auto eol = commit_data.find('\n', pos);
+		if (eol == std::string::npos || eol == pos) {
+			break; // End of headers
+		}
+		if (commit_data.compare(pos, 7, "parent ") == 0) {
+			parents.push_back(commit_data.substr(pos + 7, GIT_OID_HEX_SIZE));
+		}
+		pos = eol + 1;
+	}
+	return parents;
+}
+
+std::string GitRepository::ResolveCommit(const std::string &rev) {
+	auto suffix_start = rev.find_first_of("~^");
+	auto oid = PeelToCommit(ResolveRefName(rev.substr(0, suffix_start)));
+
+	// Apply ~N (Nth first-parent ancestor), ^N (Nth parent) and ^{...} (peel) suffixes
+	idx_t pos = suffix_start == std::string::npos ? rev.size() : suffix_start;
+	while (pos < rev.size()) {
+		char op = rev[pos++];
+		if (op == '^' && pos < rev.size() && rev[pos] == '{') {
+			auto close = rev.find('}', pos);
+			if (close == std::string::npos) {
+				throw InvalidInputException("Invalid git revision '%s'", rev);
+			}
+			pos = close + 1;
+			continue;
+		}
+		idx_t number = 1;
+		if (pos < rev.size() && isdigit(static_cast<unsigned char>(rev[pos]))) {
+			number = 0;
+			while (pos < rev.size() && isdigit(static_cast<unsigned char>(rev[pos]))) {
+				number = number * 10 + static_cast<idx_t>(rev[pos] - '0');
+				pos++;
+			}
+		}
+		if (op != '~' && op != '^') {
+			throw InvalidInputException("Invalid git revision '%s'", rev);
+		}
+		if (op == '^') {
+			if (number == 0) {
+				continue;
+			}
+			auto parents = CommitParents(ReadObject(oid).data);
+			if (number > parents.size()) {
+				throw InvalidInputException("Git revision '%s' has no parent %llu", rev, number);
+			}
+			oid = parents[number - 1];
+		} else {
+			for (idx_t i = 0; i < number; i++) {
+				auto parents = CommitParents(ReadObject(oid).data);
+				if (parents.empty()) {
+					throw InvalidInputException("Git revision '%s' goes past the root commit", rev);
+				}
+				oid = parents[0];
+			}
+		}
+	}
+	return oid;
+}
+
+//===--------------------------------------------------------------------===//
+// Tree Walk
+//===--------------------------------------------------------------------===//
+
+void GitRepository::WalkTree(const std::string &tree_id, const std::string &prefix, const std::string &glob,
+                             std::vector<GitTreeEntry> &result) {
+	auto tree = ReadObject(tree_id);
+	if (tree.type != GitObjectType::TREE) {
+		throw IOException("Git object %s is not a tree", tree_id);
+	}
+	auto literal_dir = GlobLiteralDirectory(glob);
+	auto &data = tree.data;
+	idx_t pos = 0;
+	// Entries: "<octal mode> <name>\0<20-byte id>"
+	while (pos < data.size()) {
+		auto space = data.find(' ', pos);
+		auto nul = data.find('\0', space == std::string::npos ? pos : space);
+		if (space == std::string::npos || nul == std::string::npos || nul + 1 + GIT_OID_SIZE > data.size()) {
+			throw IOException("Corrupt git tree %s", tree_id);
+		}
+		auto mode = data.substr(pos, space - pos);
+		auto path = prefix + data.substr(space + 1, nul - space - 1);
+		auto oid = OidToHex(reinterpret_cast<const uint8_t *>(data.data()) + nul + 1);
+		pos = nul + 1 + GIT_OID_SIZE;
+
+		if (mode == "40000") {
+			auto dir = path + "/";
+			// Only descend into directories on the glob's literal prefix
+			if (StringUtil::StartsWith(dir, literal_dir) || StringUtil::StartsWith(literal_dir, dir)) {
+				WalkTree(oid, dir, glob, result);
+			}
+		} else if (mode == "100644" || mode == "100755" || mode == "100664") {
+			// Regular files only: symlinks (120000) and submodules (160000) have no markdown blob here
+			if (GitGlobMatch(glob, path)) {
+				result.push_back({path, oid});
+			}
+		}
+	}
+}
+
+std::vector<GitTreeEntry> GitRepository::ListFiles(const std::string &commit_id, const std::string &glob) {
+	auto commit = ReadObject(commit_id);
+	if (commit.type != GitObjectType::COMMIT || !StringUtil::StartsWith(commit.data, "tree ")) {
+		throw IOException("Git object %s is not a commit", commit_id);
+	}
+	std::vector<GitTreeEntry> result;
+	WalkTree(commit.data.substr(5, GIT_OID_HEX_SIZE), "", glob, result);
+	std::sort(result.begin(), result.end(),
+	          [](const GitTreeEntry &a, const GitTreeEntry &b) { return a.path < b.path; });
+	return result;
+}
+
+} // namespace markdown_git
+
+} // namespace duckdb
@@ -0,0 +1,230 @@
+#include "markdown_index.hpp"
+#include "markdown_simd.hpp"
+#include <cstring>
+
+namespace duckdb {
+
+namespace markdown_utils {
+
+//===--------------------------------------------------------------------===//
+// Frontmatter Bounds
+//===--------------------------------------------------------------------===//
+
+FrontmatterMatch FindFrontmatter(const char *data, size_t size) {
+	FrontmatterMatch m;
+	// Opening delimiter: "---" then \r?\n
+	if (size < 4 || data[0] != '-' || data[1] != '-' || data[2] != '-') {
+		return m;
+	}
+	size_t p = 3;
+	if (p < size && data[p] == '\r') {
+		p++;
+	}
+	if (p >= size || data[p] != '\n') {
+		return m;
+	}
+	p++; // start of body
+	size_t body_start = p;
+
+	// Closing delimiter: earliest '\n' (at or after the body start) immediately followed by "---".
+	while (p < size) {
+		auto nl = static_cast<const char *>(memchr(data + p, '\n', size - p));
+		if (!nl) {
+			break;
+		}
+		p = static_cast<size_t>(nl - data);
+		if (p + 4 <= size && data[p + 1] == '-' && data[p + 2] == '-' && data[p + 3] == '-') {
+			size_t body_end = p; // at the '\n'
+			// The delimiter is \r?\n, so drop a trailing '\r' from the body.
+			if (body_end > body_start && data[body_end - 1] == '\r') {
+				body_end--;
+			}
+			m.found = true;
+			m.body_start = body_start;
+			m.body_len = body_end - body_start;
+			m.after_close = p + 4; // just past the closing "---"
+			return m;
+		}
+		p++;
+	}
+	return m;
+}
+
+//===--------------------------------------------------------------------===//
+// Newline Index
+//===--------------------------------------------------------------------===//
+
+NewlineIndex::NewlineIndex(const char *data, size_t size) : size(size) {
+	using markdown_simd::BLOCK_SIZE;
+	line_starts.reserve(markdown_simd::CountByte(data, size, '\n') + 1);
+	size_t pos = 0;
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		auto newlines = markdown_simd::ByteBlock::Load(data + pos).Eq('\n');
+		while (newlines) {
+			line_starts.push_back(pos + markdown_simd::CountTrailingZeros(newlines) + 1);
+			newlines &= newlines - 1;
+		}
+	}
+	for (; pos < size; pos++) {
+		if (data[pos] == '\n') {
+			line_starts.push_back(pos + 1);
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Structural Index
+//===--------------------------------------------------------------------===//
+
+StructuralIndex::StructuralIndex(const char *data, size_t size) : data(data), size(size) {
+	FindLines();
+	ClassifyLines();
+}
+
+// Stage 1: one vectorized sweep for line starts, '#' and "[[" (per-line bits)
+void StructuralIndex::FindLines() {
+	using markdown_simd::BLOCK_SIZE;
+	auto &line_starts = lines.line_starts;
+	lines.size = size;
+	line_starts.reserve(markdown_simd::CountByte(data, size, '\n') + 1);
+	line_flags.reserve(line_starts.capacity());
+	line_flags.push_back(0);
+
+	auto mark_range = [&](uint32_t hash, uint32_t wiki, uint32_t range) {
+		if (hash & range) {
+			line_flags.back() |= LINE_HAS_HASH;
+		}
+		if (wiki & range) {
+			line_flags.back() |= LINE_HAS_WIKILINK;
+		}
+	};
+
+	uint32_t bracket_carry = 0; // The previous block ended in '['
+	size_t pos = 0;
+	for (; pos + BLOCK_SIZE <= size; pos += BLOCK_SIZE) {
+		auto block = markdown_simd::ByteBlock::Load(data + pos);
+		auto newlines = block.Eq('\n');
+		auto hash = block.Eq('#');
+		auto bracket = block.Eq('[');
+		// Bit i: "[[" ends at byte i
+		auto wiki = bracket & ((bracket << 1) | bracket_carry);
+		bracket_carry = (bracket >> (BLOCK_SIZE - 1)) & 1;
+
+		uint32_t segment_start = 0;
+		while (newlines) {
+			auto bit = markdown_simd::CountTrailingZeros(newlines);
+			auto before_newline = ((1u << bit) - 1) & ~((1u << segment_start) - 1);
+			mark_range(hash, wiki, before_newline);
+			line_starts.push_back(pos + bit + 1);
+			line_flags.push_back(0);
+			segment_start = bit + 1;
+			newlines &= newlines - 1;
+		}
+		auto rest = segment_start >= BLOCK_SIZE ? 0u : (0xFFFFu & ~((1u << segment_start) - 1));
+		mark_range(hash, wiki, rest);
+	}
+	for (; pos < size; pos++) {
+		char c = data[pos];
+		if (c == '\n') {
+			line_starts.push_back(pos + 1);
+			line_flags.push_back(0);
+		} else if (c == '#') {
+			line_flags.back() |= LINE_HAS_HASH;
+		} else if (c == '[' && ((pos > 0 && data[pos - 1] == '[') || bracket_carry)) {
+			line_flags.back() |= LINE_HAS_WIKILINK;
+		}
+		bracket_carry = 0;
+	}
+}
+
+static inline bool IsLeadingBlank(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Stage 2: classify each line from its leading and trailing bytes
+void StructuralIndex::ClassifyLines() {
+	frontmatter = FindFrontmatter(data, size);
+	bool in_fence = false;
+	char fence_char = 0;
+	size_t fence_len = 0;
+	for (idx_t line = 0; line < LineCount(); line++) {
+		auto start = LineStart(line);
+		auto end = LineEnd(line);
+		auto &flags = line_flags[line];
+
+		if (frontmatter.found && start < frontmatter.after_close) {
+			// YAML, not Markdown: a `# comment` line is no heading
+			flags |= LINE_FRONTMATTER;
+			continue;
+		}
+
+		size_t first = start;
+		while (first < end && IsLeadingBlank(data[first])) {
+			first++;
+		}
+		if (first + 3 <= end && (data[first] == '`' || data[first] == '~') && data[first + 1] == data[first] &&
+		    data[first + 2] == data[first]) {
+			auto run_end = first + 3;
+			while (run_end < end && data[run_end] == data[first]) {
+				run_end++;
+			}
+			bool is_fence;
+			if (!in_fence) {
+				// A backtick fence's info string may not contain a backtick
+				is_fence = data[first] == '~' || !memchr(data + run_end, '`', end - run_end);
+			} else {
+				// Only a run of the opening character, at least as long, with nothing after it closes
+				auto rest = run_end;
+				while (rest < end && IsLeadingBlank(data[rest])) {
+					rest++;
+				}
+				is_fence = data[first] == fence_char && run_end - first >= fence_len && rest == end;
+			}
+			if (is_fence) {
+				flags |= LINE_FENCE;
+				if (!in_fence) {
+					flags |= LINE_FENCE_OPEN;
+					fence_char = data[first];
+					fence_len = run_end - first;
+				}
+				in_fence = !in_fence;
+				continue;
+			}
+		}
+		if (in_fence) {
+			flags |= LINE_IN_FENCE;
+			continue;
+		}
+		if (first < end && data[first] == '[') {
+			flags |= LINE_BRACKET;
+		}
+
+		if ((flags & LINE_HAS_HASH) && data[start] == '#') {
+			size_t h = start;
+			while (h < end && data[h] == '#') {
+				h++;
+			}
+			auto level = h - start;
+			if (level <= 6 && h < end && (data[h] == ' ' || data[h] == '\t')) {
+				flags |= LINE_ATX_HEADING;
+			}
+		}
+
+		if (start < end && data[start] == '|') {
+			size_t last = end;
+			if (data[last - 1] == '\r') {
+				last--;
+			}
+			while (last > start && (data[last - 1] == ' ' || data[last - 1] == '\t')) {
+				last--;
+			}
+			if (last - 1 > start && data[last - 1] == '|') {
+				flags |= LINE_PIPE_TABLE;
+			}
+		}
+	}
+}
+
+} // namespace markdown_utils
+
+} // namespace duckdb
@@ -0,0 +1,388 @@
+#include "markdown_md4c.hpp"
+#include "markdown_index.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "utf8proc_wrapper.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <md4c.h>
+
+namespace duckdb {
+
+namespace markdown_md4c {
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+
+// Append the UTF-8 encoding of an entity reference ("&amp;", "&#35;", "&#x23;").
+// Named entities beyond the XML set are kept verbatim.
+static void AppendEntity(std::string &out, const char *text, size_t size) {
+	std::string entity(text, size);
+	int32_t codepoint = -1;
+	if (entity.size() > 3 && entity[1] == '#') {
+		bool hex = entity[2] == 'x' || entity[2] == 'X';
+		auto digits = entity.substr(hex ? 3 : 2, entity.size() - (hex ? 4 : 3));
+		codepoint = static_cast<int32_t>(std::strtol(digits.c_str(), nullptr, hex ? 16 : 10));
+		if (codepoint <= 0 || codepoint > 0x10FFFF) {
+			codepoint = 0xFFFD;
+		}
+	} else if (entity == "&amp;") {
+		codepoint = '&';
+	} else if (entity == "&lt;") {
+		codepoint = '<';
+	} else if (entity == "&gt;") {
+		codepoint = '>';
+	} else if (entity == "&quot;") {
+		codepoint = '"';
+	} else if (entity == "&apos;") {
+		codepoint = '\'';
+	} else if (entity == "&nbsp;") {
+		codepoint = 0xA0;
+	}
+	if (codepoint < 0) {
+		out += entity;
+		return;
+	}
+	char utf8[4];
+	int utf8_size = 0;
+	if (Utf8Proc::CodepointToUtf8(codepoint, utf8_size, utf8)) {
+		out.append(utf8, static_cast<size_t>(utf8_size));
+	}
+}
+
+static void AppendText(std::string &out, MD_TEXTTYPE type, const MD_CHAR *text, MD_SIZE size) {
+	switch (type) {
+	case MD_TEXT_ENTITY:
+		AppendEntity(out, text, size);
+		break;
+	case MD_TEXT_NULLCHAR:
+		out += "\xEF\xBF\xBD";
+		break;
+	default:
+		out.append(text, size);
+		break;
+	}
+}
+
+// Resolve an attribute (URL, title, info string) into plain text
+static std::string AttributeText(const MD_ATTRIBUTE &attr) {
+	std::string result;
+	if (!attr.text || attr.size == 0) {
+		return result;
+	}
+	for (idx_t i = 0; attr.substr_offsets[i] < attr.size; i++) {
+		auto begin = attr.substr_offsets[i];
+		auto end = attr.substr_offsets[i + 1];
+		AppendText(result, attr.substr_types[i], attr.text + begin, end - begin);
+	}
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Event Collector
+//===--------------------------------------------------------------------===//
+
+struct MD4CCollector {
+	MD4CCollector(const std::string &markdown_str, bool want_code, bool want_links, bool want_images)
+	    : base(markdown_str.data()), size(markdown_str.size()), lines(markdown_str), want_code(want_code),
+	      want_links(want_links), want_images(want_images) {
+	}
+
+	const char *base;
+	size_t size;
+	// Offset -> line number for the text pointers md4c hands back
+	markdown_utils::NewlineIndex lines;
+	bool want_code;
+	bool want_links;
+	bool want_images;
+
+	std::vector<markdown_utils::CodeBlock> code_blocks;
+	std::vector<markdown_utils::MarkdownLink> links;
+	std::vector<markdown_utils::MarkdownImage> images;
+
+	// Open spans, innermost last
+	std::vector<MD_SPANTYPE> spans;
+	// Open link / image results (indexes into links / images; -1 when not collected)
+	std::vector<int64_t> open_links;
+	std::vector<int64_t> open_images;
+	bool link_positioned = false;
+	bool image_positioned = false;
+
+	// Current code block
+	bool in_code = false;
+	char fence_char = 0;
+	size_t code_search_from = 0;
+	bool code_has_position = false;
+	bool code_position_on_fence = false;
+	size_t code_first_text = 0;
+
+	// End of the last text handed back from the input buffer
+	size_t last_offset = 0;
+
+	bool InBuffer(const char *ptr) const {
+		return ptr >= base && ptr < base + size;
+	}
+
+	idx_t LineAt(size_t offset) const {
+		return lines.LineOf(offset);
+	}
+
+	size_t LineStart(size_t offset) const {
+		return lines.LineStart(lines.LineIndex(offset));
+	}
+
+	// Blank apart from container markers ('>' of block quotes)
+	bool IsBlankLine(size_t line_start) const {
+		for (size_t i = line_start; i < size && base[i] != '\n'; i++) {
+			if (base[i] != ' ' && base[i] != '\t' && base[i] != '>' && base[i] != '\r') {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// A line holding an opening fence, possibly behind block quote / list markers
+	bool IsFenceLine(size_t line_start) const {
+		size_t i = line_start;
+		while (i < size && base[i] != '\n' && base[i] != fence_char) {
+			char c = base[i];
+			bool container = c == ' ' || c == '\t' || c == '>' || c == '-' || c == '*' || c == '+' || c == '.' ||
+			                 c == ')' || (c >= '0' && c <= '9');
+			if (!container) {
+				return false;
+			}
+			i++;
+		}
+		return i + 3 <= size && base[i] == fence_char && base[i + 1] == fence_char && base[i + 2] == fence_char;
+	}
+
+	// Line of the opening fence (or first line of an indented block)
+	idx_t CodeBlockLine() {
+		if (code_has_position) {
+			size_t line_start = LineStart(code_first_text);
+			if (code_position_on_fence || !fence_char) {
+				return LineAt(line_start);
+			}
+			// Step back over leading blank lines of the block to the fence itself
+			while (line_start > 0) {
+				line_start = LineStart(line_start - 1);
+				if (!IsBlankLine(line_start)) {
+					break;
+				}
+			}
+			return LineAt(line_start);
+		}
+		// Empty block: the next fence line after the previous content
+		size_t line_start = LineStart(code_search_from);
+		while (line_start < size) {
+			if (fence_char && IsFenceLine(line_start)) {
+				return LineAt(line_start);
+			}
+			auto next = static_cast<const char *>(memchr(base + line_start, '\n', size - line_start));
+			if (!next) {
+				break;
+			}
+			line_start = static_cast<size_t>(next - base) + 1;
+		}
+		return LineAt(code_search_from);
+	}
+
+	void NoteText(const MD_CHAR *text, MD_SIZE text_size) {
+		if (!InBuffer(text)) {
+			return;
+		}
+		auto offset = static_cast<size_t>(text - base);
+		if (in_code && !code_has_position) {
+			code_has_position = true;
+			code_first_text = offset;
+		}
+		if (!open_links.empty() && !link_positioned && open_links.back() >= 0) {
+			links[open_links.back()].line_number = LineAt(offset);
+			link_positioned = true;
+		}
+		if (!open_images.empty() && !image_positioned && open_images.back() >= 0) {
+			images[open_images.back()].line_number = LineAt(offset);
+			image_positioned = true;
+		}
+		last_offset = offset + text_size;
+	}
+
+	//===--------------------------------------------------------------------===//
+	// md4c callbacks
+	//===--------------------------------------------------------------------===//
+
+	static int EnterBlock(MD_BLOCKTYPE type, void *detail, void *userdata) {
+		auto &self = *static_cast<MD4CCollector *>(userdata);
+		if (type != MD_BLOCK_CODE || !self.want_code) {
+			return 0;
+		}
+		auto &code_detail = *static_cast<MD_BLOCK_CODE_DETAIL *>(detail);
+		markdown_utils::CodeBlock block;
+		block.info_string = AttributeText(code_detail.info);
+		block.language = AttributeText(code_detail.lang);
+		StringUtil::Trim(block.language);
+		block.line_number = 0;
+		self.code_blocks.push_back(std::move(block));
+		self.in_code = true;
+		self.fence_char = code_detail.fence_char;
+		self.code_search_from = self.last_offset;
+		self.code_has_position = false;
+		self.code_position_on_fence = false;
+		// The info string sits on the fence line itself
+		if (code_detail.info.size > 0 && self.InBuffer(code_detail.info.text)) {
+			self.code_has_position = true;
+			self.code_position_on_fence = true;
+			self.code_first_text = static_cast<size_t>(code_detail.info.text - self.base);
+		}
+		return 0;
+	}
+
+	static int LeaveBlock(MD_BLOCKTYPE type, void *detail, void *userdata) {
+		auto &self = *static_cast<MD4CCollector *>(userdata);
+		if (type != MD_BLOCK_CODE || !self.in_code) {
+			return 0;
+		}
+		self.code_blocks.back().line_number = self.CodeBlockLine();
+		self.in_code = false;
+		return 0;
+	}
+
+	static int EnterSpan(MD_SPANTYPE type, void *detail, void *userdata) {
+		auto &self = *static_cast<MD4CCollector *>(userdata);
+		self.spans.push_back(type);
+		if (type == MD_SPAN_A) {
+			int64_t index = -1;
+			if (self.want_links) {
+				auto &a_detail = *static_cast<MD_SPAN_A_DETAIL *>(detail);
+				markdown_utils::MarkdownLink link;
+				link.url = AttributeText(a_detail.href);
+				link.title = AttributeText(a_detail.title);
+				link.is_reference = false;
+				link.line_number = self.LineAt(self.last_offset);
+				index = static_cast<int64_t>(self.links.size());
+				self.links.push_back(std::move(link));
+			}
+			self.open_links.push_back(index);
+			self.link_positioned = false;
+		} else if (type == MD_SPAN_IMG) {
+			int64_t index = -1;
+			if (self.want_images) {
+				auto &img_detail = *static_cast<MD_SPAN_IMG_DETAIL *>(detail);
+				markdown_utils::MarkdownImage image;
+				image.url = AttributeText(img_detail.src);
+				image.title = AttributeText(img_detail.title);
+				image.line_number = self.LineAt(self.last_offset);
+				index = static_cast<int64_t>(self.images.size());
+				self.images.push_back(std::move(image));
+			}
+			self.open_images.push_back(index);
+			self.image_positioned = false;
+		}
+		return 0;
+	}
+
+	static int LeaveSpan(MD_SPANTYPE type, void *detail, void *userdata) {
+		auto &self = *static_cast<MD4CCollector *>(userdata);
+		self.spans.pop_back();
+		if (type == MD_SPAN_A) {
+			self.open_links.pop_back();
+			self.link_positioned = true;
+		} else if (type == MD_SPAN_IMG) {
+			self.open_images.pop_back();
+			self.image_positioned = true;
+		}
+		return 0;
+	}
+
+	static int Text(MD_TEXTTYPE type, const MD_CHAR *text, MD_SIZE text_size, void *userdata) {
+		auto &self = *static_cast<MD4CCollector *>(userdata);
+		self.NoteText(text, text_size);
+
+		if (self.in_code) {
+			AppendText(self.code_blocks.back().code, type, text, text_size);
+			return 0;
+		}
+		if (type == MD_TEXT_SOFTBR || type == MD_TEXT_BR || type == MD_TEXT_HTML) {
+			return 0;
+		}
+		// Like the cmark extractors, only text directly inside the link / image is
+		// collected (plus inline code directly inside a link), not emphasis etc.
+		auto depth = self.spans.size();
+		if (depth == 0) {
+			return 0;
+		}
+		auto top = self.spans[depth - 1];
+		if (top == MD_SPAN_A && !self.open_links.empty() && self.open_links.back() >= 0) {
+			AppendText(self.links[self.open_links.back()].text, type, text, text_size);
+		} else if (top == MD_SPAN_CODE && depth >= 2 && self.spans[depth - 2] == MD_SPAN_A &&
+		           !self.open_links.empty() && self.open_links.back() >= 0) {
+			AppendText(self.links[self.open_links.back()].text, type, text, text_size);
+		} else if (top == MD_SPAN_IMG && !self.open_images.empty() && self.open_images.back() >= 0 &&
+		           type != MD_TEXT_CODE) {
+			AppendText(self.images[self.open_images.back()].alt_text, type, text, text_size);
+		}
+		return 0;
+	}
+
+	void Parse() {
+		MD_PARSER parser {};
+		parser.abi_version = 0;
+		parser.flags = MD_DIALECT_COMMONMARK;
+		parser.enter_block = EnterBlock;
+		parser.leave_block = LeaveBlock;
+		parser.enter_span = EnterSpan;
+		parser.leave_span = LeaveSpan;
+		parser.text = Text;
+		md_parse(base, static_cast<MD_SIZE>(size), &parser, this);
+	}
+};
+
+//===--------------------------------------------------------------------===//
+// Extractors
+//===--------------------------------------------------------------------===//
+
+std::vector<markdown_utils::CodeBlock> ExtractCodeBlocks(const std::string &markdown_str,
+                                                         const std::string &language_filter) {
+	if (markdown_str.empty()) {
+		return {};
+	}
+	MD4CCollector collector(markdown_str, true, false, false);
+	collector.Parse();
+	if (language_filter.empty()) {
+		return std::move(collector.code_blocks);
+	}
+	std::vector<markdown_utils::CodeBlock> filtered;
+	auto filter = StringUtil::Lower(language_filter);
+	for (auto &block : collector.code_blocks) {
+		if (StringUtil::Lower(block.language) == filter) {
+			filtered.push_back(std::move(block));
+		}
+	}
+	return filtered;
+}
+
+std::vector<markdown_utils::MarkdownLink> ExtractLinks(const std::string &markdown_str) {
+	if (markdown_str.empty()) {
+		return {};
+	}
+	MD4CCollector collector(markdown_str, false, true, false);
+	collector.Parse();
+	auto reference_urls = markdown_utils::ExtractReferenceUrls(markdown_str);
+	for (auto &link : collector.links) {
+		link.is_reference = reference_urls.find(link.url) != reference_urls.end();
+	}
+	return std::move(collector.links);
+}
+
+std::vector<markdown_utils::MarkdownImage> ExtractImages(const std::string &markdown_str) {
+	if (markdown_str.empty()) {
+		return {};
+	}
+	MD4CCollector collector(markdown_str, false, false, true);
+	collector.Parse();
+	return std::move(collector.images);
+}
+
+} // namespace markdown_md4c
+
+} // namespace duckdb
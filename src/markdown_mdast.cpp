@@ -0,0 +1,422 @@
+#include "markdown_utils.hpp"
+#include "markdown_index.hpp"
+#include "duckdb/common/exception.hpp"
+#include "yyjson.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <cmark-gfm.h>
+#include <cmark-gfm-extension_api.h>
+#include <cmark-gfm-core-extensions.h>
+
+using namespace duckdb_yyjson; // NOLINT
+
+namespace duckdb {
+
+namespace markdown_utils {
+
+//===--------------------------------------------------------------------===//
+// mdast Export
+//===--------------------------------------------------------------------===//
+// The cmark-gfm tree is walked with cmark_iter (no recursion, so nesting depth is
+// only bounded by cmark) and written as the mdast nodes remark produces. Points are
+// 1-based; end points are exclusive, one column past the node's last byte.
+
+// One open mdast node whose children are being written
+struct MdastFrame {
+	explicit MdastFrame(yyjson_mut_val *children_p) : children(children_p) {
+	}
+
+	//! Children array, or nullptr while inside an image (its alt text is not a child)
+	yyjson_mut_val *children;
+	//! Adjacent text and soft breaks, merged into one text node as remark does
+	std::string text;
+	bool has_text = false;
+	int text_start_line = 0;
+	int text_start_column = 0;
+	int text_end_line = 0;
+	int text_end_column = 0;
+};
+
+struct MdastWriter {
+	yyjson_mut_doc *doc;
+	//! Lines before the parsed body (the frontmatter), added to every cmark line
+	int line_offset;
+
+	yyjson_mut_val *Point(int line, int column) {
+		auto point = yyjson_mut_obj(doc);
+		yyjson_mut_obj_add_int(doc, point, "line", line + line_offset);
+		yyjson_mut_obj_add_int(doc, point, "column", column);
+		return point;
+	}
+
+	void AddPosition(yyjson_mut_val *obj, int start_line, int start_column, int end_line, int end_column) {
+		// cmark leaves positions it does not track at 0
+		if (start_line <= 0 || end_line <= 0) {
+			return;
+		}
+		auto position = yyjson_mut_obj(doc);
+		yyjson_mut_obj_add_val(doc, position, "start", Point(start_line, start_column));
+		yyjson_mut_obj_add_val(doc, position, "end", Point(end_line, end_column + 1));
+		yyjson_mut_obj_add_val(doc, obj, "position", position);
+	}
+
+	void AddPosition(yyjson_mut_val *obj, cmark_node *node) {
+		AddPosition(obj, cmark_node_get_start_line(node), cmark_node_get_start_column(node),
+		            cmark_node_get_end_line(node), cmark_node_get_end_column(node));
+	}
+
+	void AddString(yyjson_mut_val *obj, const char *key, const char *value, size_t len) {
+		yyjson_mut_obj_add_val(doc, obj, key, yyjson_mut_strncpy(doc, value, len));
+	}
+
+	void AddString(yyjson_mut_val *obj, const char *key, const char *value) {
+		AddString(obj, key, value ? value : "", value ? strlen(value) : 0);
+	}
+
+	// Empty strings are null, as mdast writes a missing title or language
+	void AddOptionalString(yyjson_mut_val *obj, const char *key, const std::string &value) {
+		if (value.empty()) {
+			yyjson_mut_obj_add_null(doc, obj, key);
+		} else {
+			AddString(obj, key, value.data(), value.size());
+		}
+	}
+
+	// Literal without its trailing newlines (cmark keeps them for code and HTML blocks)
+	void AddLiteral(yyjson_mut_val *obj, cmark_node *node) {
+		auto literal = cmark_node_get_literal(node);
+		size_t len = literal ? strlen(literal) : 0;
+		while (len > 0 && literal[len - 1] == '\n') {
+			len--;
+		}
+		AddString(obj, "value", literal ? literal : "", len);
+	}
+
+	yyjson_mut_val *NewNode(const char *type) {
+		auto obj = yyjson_mut_obj(doc);
+		yyjson_mut_obj_add_str(doc, obj, "type", type);
+		return obj;
+	}
+
+	void FlushText(MdastFrame &frame) {
+		if (!frame.has_text) {
+			return;
+		}
+		auto obj = NewNode("text");
+		AddString(obj, "value", frame.text.data(), frame.text.size());
+		AddPosition(obj, frame.text_start_line, frame.text_start_column, frame.text_end_line, frame.text_end_column);
+		yyjson_mut_arr_append(frame.children, obj);
+		frame.text.clear();
+		frame.has_text = false;
+	}
+};
+
+static bool IsMdastLeaf(cmark_node_type type) {
+	switch (type) {
+	case CMARK_NODE_TEXT:
+	case CMARK_NODE_SOFTBREAK:
+	case CMARK_NODE_LINEBREAK:
+	case CMARK_NODE_CODE:
+	case CMARK_NODE_HTML_INLINE:
+	case CMARK_NODE_THEMATIC_BREAK:
+	case CMARK_NODE_CODE_BLOCK:
+	case CMARK_NODE_HTML_BLOCK:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Plain text of an image's description (its mdast alt)
+static std::string ImageAlt(cmark_node *image) {
+	std::string alt;
+	cmark_iter *iter = cmark_iter_new(image);
+	cmark_event_type event;
+	while ((event = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
+		if (event != CMARK_EVENT_ENTER) {
+			continue;
+		}
+		auto node = cmark_iter_get_node(iter);
+		switch (cmark_node_get_type(node)) {
+		case CMARK_NODE_TEXT:
+		case CMARK_NODE_CODE: {
+			auto literal = cmark_node_get_literal(node);
+			if (literal) {
+				alt += literal;
+			}
+			break;
+		}
+		case CMARK_NODE_SOFTBREAK:
+		case CMARK_NODE_LINEBREAK:
+			alt += ' ';
+			break;
+		default:
+			break;
+		}
+	}
+	cmark_iter_free(iter);
+	return alt;
+}
+
+static const char *TableAlign(uint8_t align) {
+	switch (align) {
+	case 'l':
+		return "left";
+	case 'c':
+		return "center";
+	case 'r':
+		return "right";
+	default:
+		return nullptr;
+	}
+}
+
+// The mdast node for one entered cmark node (children and position are added by the caller)
+static yyjson_mut_val *MdastNode(MdastWriter &writer, cmark_node *node) {
+	auto doc = writer.doc;
+	auto type_string = cmark_node_get_type_string(node);
+	switch (cmark_node_get_type(node)) {
+	case CMARK_NODE_PARAGRAPH:
+		return writer.NewNode("paragraph");
+	case CMARK_NODE_HEADING: {
+		auto obj = writer.NewNode("heading");
+		yyjson_mut_obj_add_int(doc, obj, "depth", cmark_node_get_heading_level(node));
+		return obj;
+	}
+	case CMARK_NODE_THEMATIC_BREAK:
+		return writer.NewNode("thematicBreak");
+	case CMARK_NODE_BLOCK_QUOTE:
+		return writer.NewNode("blockquote");
+	case CMARK_NODE_LIST: {
+		auto obj = writer.NewNode("list");
+		bool ordered = cmark_node_get_list_type(node) == CMARK_ORDERED_LIST;
+		yyjson_mut_obj_add_bool(doc, obj, "ordered", ordered);
+		if (ordered) {
+			yyjson_mut_obj_add_int(doc, obj, "start", cmark_node_get_list_start(node));
+		} else {
+			yyjson_mut_obj_add_null(doc, obj, "start");
+		}
+		yyjson_mut_obj_add_bool(doc, obj, "spread", !cmark_node_get_list_tight(node));
+		return obj;
+	}
+	case CMARK_NODE_ITEM: {
+		// cmark only knows whether the whole list is loose
+		auto obj = writer.NewNode("listItem");
+		auto list = cmark_node_parent(node);
+		yyjson_mut_obj_add_bool(doc, obj, "spread", list && !cmark_node_get_list_tight(list));
+		if (type_string && strcmp(type_string, "tasklist") == 0) {
+			yyjson_mut_obj_add_bool(doc, obj, "checked", cmark_gfm_extensions_get_tasklist_item_checked(node));
+		} else {
+			yyjson_mut_obj_add_null(doc, obj, "checked");
+		}
+		return obj;
+	}
+	case CMARK_NODE_CODE_BLOCK: {
+		// The info string is the language, then anything after it as meta
+		auto obj = writer.NewNode("code");
+		std::string info = cmark_node_get_fence_info(node) ? cmark_node_get_fence_info(node) : "";
+		auto split = info.find_first_of(" \t");
+		std::string lang = info.substr(0, split);
+		std::string meta;
+		if (split != std::string::npos) {
+			auto meta_start = info.find_first_not_of(" \t", split);
+			if (meta_start != std::string::npos) {
+				meta = info.substr(meta_start);
+			}
+		}
+		writer.AddOptionalString(obj, "lang", lang);
+		writer.AddOptionalString(obj, "meta", meta);
+		writer.AddLiteral(obj, node);
+		return obj;
+	}
+	case CMARK_NODE_HTML_BLOCK:
+	case CMARK_NODE_HTML_INLINE: {
+		auto obj = writer.NewNode("html");
+		writer.AddLiteral(obj, node);
+		return obj;
+	}
+	case CMARK_NODE_LINEBREAK:
+		return writer.NewNode("break");
+	case CMARK_NODE_CODE: {
+		auto obj = writer.NewNode("inlineCode");
+		writer.AddString(obj, "value", cmark_node_get_literal(node));
+		return obj;
+	}
+	case CMARK_NODE_EMPH:
+		return writer.NewNode("emphasis");
+	case CMARK_NODE_STRONG:
+		return writer.NewNode("strong");
+	case CMARK_NODE_LINK:
+	case CMARK_NODE_IMAGE: {
+		bool image = cmark_node_get_type(node) == CMARK_NODE_IMAGE;
+		auto obj = writer.NewNode(image ? "image" : "link");
+		writer.AddString(obj, "url", cmark_node_get_url(node));
+		writer.AddOptionalString(obj, "title", cmark_node_get_title(node) ? cmark_node_get_title(node) : "");
+		if (image) {
+			auto alt = ImageAlt(node);
+			writer.AddString(obj, "alt", alt.data(), alt.size());
+		}
+		return obj;
+	}
+	default:
+		break;
+	}
+
+	// GFM extension nodes
+	if (type_string && strcmp(type_string, "table") == 0) {
+		auto obj = writer.NewNode("table");
+		auto align = yyjson_mut_arr(doc);
+		auto columns = cmark_gfm_extensions_get_table_columns(node);
+		auto alignments = cmark_gfm_extensions_get_table_alignments(node);
+		for (uint16_t i = 0; i < columns; i++) {
+			auto value = alignments ? TableAlign(alignments[i]) : nullptr;
+			yyjson_mut_arr_append(align, value ? yyjson_mut_str(doc, value) : yyjson_mut_null(doc));
+		}
+		yyjson_mut_obj_add_val(doc, obj, "align", align);
+		return obj;
+	} else if (type_string && (strcmp(type_string, "table_header") == 0 || strcmp(type_string, "table_row") == 0)) {
+		return writer.NewNode("tableRow");
+	} else if (type_string && strcmp(type_string, "table_cell") == 0) {
+		return writer.NewNode("tableCell");
+	} else if (type_string && strcmp(type_string, "strikethrough") == 0) {
+		return writer.NewNode("delete");
+	}
+	return nullptr;
+}
+
+std::string MarkdownToMdast(const char *data, size_t size) {
+	yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+	if (!doc) {
+		throw InternalException("Failed to allocate the mdast document");
+	}
+	MdastWriter writer {doc, 0};
+
+	auto root = writer.NewNode("root");
+	yyjson_mut_doc_set_root(doc, root);
+	auto root_children = yyjson_mut_arr(doc);
+	yyjson_mut_obj_add_val(doc, root, "children", root_children);
+
+	// Frontmatter is not markdown to cmark; remark-frontmatter calls it a yaml node
+	size_t body_start = 0;
+	auto fm = FindFrontmatter(data, size);
+	if (fm.found) {
+		body_start = fm.after_close;
+		if (body_start < size && data[body_start] == '\r') {
+			body_start++;
+		}
+		while (body_start < size && data[body_start] == '\n') {
+			body_start++;
+		}
+		int close_line = 1 + static_cast<int>(std::count(data, data + fm.after_close, '\n'));
+		auto yaml = writer.NewNode("yaml");
+		writer.AddString(yaml, "value", data + fm.body_start, fm.body_len);
+		writer.AddPosition(yaml, 1, 1, close_line, 3);
+		yyjson_mut_arr_append(root_children, yaml);
+		writer.line_offset = static_cast<int>(std::count(data, data + body_start, '\n'));
+	}
+
+	cmark_gfm_core_extensions_ensure_registered();
+	cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+	for (auto name : {"table", "strikethrough", "autolink", "tasklist"}) {
+		auto extension = cmark_find_syntax_extension(name);
+		if (extension) {
+			cmark_parser_attach_syntax_extension(parser, extension);
+		}
+	}
+	cmark_parser_feed(parser, data + body_start, size - body_start);
+	cmark_node *document = cmark_parser_finish(parser);
+	cmark_parser_free(parser);
+
+	vector<MdastFrame> stack;
+	if (document) {
+		cmark_iter *iter = cmark_iter_new(document);
+		cmark_event_type event;
+		while ((event = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
+			auto node = cmark_iter_get_node(iter);
+			auto type = cmark_node_get_type(node);
+			if (event == CMARK_EVENT_EXIT) {
+				if (stack.back().children) {
+					writer.FlushText(stack.back());
+				}
+				stack.pop_back();
+				continue;
+			}
+			if (type == CMARK_NODE_DOCUMENT) {
+				stack.push_back(MdastFrame(root_children));
+				continue;
+			}
+			auto &parent = stack.back();
+			if (!parent.children) {
+				// Image description: already in the alt
+				if (!IsMdastLeaf(type)) {
+					stack.push_back(MdastFrame(nullptr));
+				}
+				continue;
+			}
+			if (type == CMARK_NODE_TEXT || type == CMARK_NODE_SOFTBREAK) {
+				if (!parent.has_text) {
+					parent.has_text = true;
+					parent.text_start_line = cmark_node_get_start_line(node);
+					parent.text_start_column = cmark_node_get_start_column(node);
+				}
+				if (type == CMARK_NODE_TEXT) {
+					auto literal = cmark_node_get_literal(node);
+					parent.text += literal ? literal : "";
+				} else {
+					parent.text += '\n';
+				}
+				if (cmark_node_get_end_line(node) > 0) {
+					parent.text_end_line = cmark_node_get_end_line(node);
+					parent.text_end_column = cmark_node_get_end_column(node);
+				}
+				continue;
+			}
+			writer.FlushText(parent);
+
+			auto obj = MdastNode(writer, node);
+			yyjson_mut_val *children = nullptr;
+			if (obj) {
+				if (!IsMdastLeaf(type) && type != CMARK_NODE_IMAGE) {
+					children = yyjson_mut_arr(doc);
+					yyjson_mut_obj_add_val(doc, obj, "children", children);
+				}
+				writer.AddPosition(obj, node);
+				yyjson_mut_arr_append(parent.children, obj);
+			} else if (!IsMdastLeaf(type)) {
+				// Custom and unknown containers are transparent: their children join the parent
+				children = parent.children;
+			}
+			if (!IsMdastLeaf(type)) {
+				stack.push_back(MdastFrame(children));
+			}
+		}
+		cmark_iter_free(iter);
+		cmark_node_free(document);
+	}
+
+	// The root spans the whole input; its end is just past the last byte
+	size_t last_line_start = size;
+	while (last_line_start > 0 && data[last_line_start - 1] != '\n') {
+		last_line_start--;
+	}
+	int end_line = 1 + static_cast<int>(std::count(data, data + size, '\n'));
+	int end_column = static_cast<int>(size - last_line_start + 1);
+	writer.line_offset = 0;
+	writer.AddPosition(root, 1, 1, end_line, end_column - 1);
+
+	size_t len = 0;
+	char *json = yyjson_mut_write(doc, YYJSON_WRITE_NOFLAG, &len);
+	yyjson_mut_doc_free(doc);
+	if (!json) {
+		throw InvalidInputException("Failed to write mdast JSON");
+	}
+	std::string result(json, len);
+	free(json);
+	return result;
+}
+
+} // namespace markdown_utils
+
+} // namespace duckdb
@@ -0,0 +1,192 @@
+#include "markdown_memo_cache.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr const char *MARKDOWN_MEMO_CACHE_KEY = "markdown_memo_cache";
+
+// Rough in-memory footprint of a cached result, used to bound the cache in bytes
+static idx_t EstimateValueSize(const Value &value) {
+	idx_t size = sizeof(Value);
+	if (value.IsNull()) {
+		return size;
+	}
+	switch (value.type().InternalType()) {
+	case PhysicalType::VARCHAR:
+		size += StringValue::Get(value).size();
+		break;
+	case PhysicalType::STRUCT:
+		for (auto &child : StructValue::GetChildren(value)) {
+			size += EstimateValueSize(child);
+		}
+		break;
+	case PhysicalType::LIST:
+		for (auto &child : ListValue::GetChildren(value)) {
+			size += EstimateValueSize(child);
+		}
+		break;
+	default:
+		break;
+	}
+	return size;
+}
+
+MarkdownMemoCache::MarkdownMemoCache(idx_t capacity_bytes) : capacity(0) {
+	Resize(capacity_bytes);
+}
+
+shared_ptr<MarkdownMemoCache> MarkdownMemoCache::Get(ClientContext &context) {
+	Value setting;
+	if (!context.TryGetCurrentSetting(SETTING_NAME, setting) || setting.IsNull()) {
+		return nullptr;
+	}
+	auto capacity = UBigIntValue::Get(setting.DefaultCastAs(LogicalType::UBIGINT));
+	if (capacity == 0) {
+		return nullptr;
+	}
+	auto &object_cache = ObjectCache::GetObjectCache(context);
+	auto result = object_cache.GetOrCreate<MarkdownMemoCache>(MARKDOWN_MEMO_CACHE_KEY, capacity);
+	if (result->capacity.load() != capacity) {
+		result->Resize(capacity);
+	}
+	return result;
+}
+
+void MarkdownMemoCache::Resize(idx_t capacity_bytes) {
+	capacity = capacity_bytes;
+	for (auto &shard : shards) {
+		std::lock_guard<std::mutex> guard(shard.lock);
+		shard.cache.SetCapacity(capacity_bytes / SHARD_COUNT);
+	}
+}
+
+MarkdownMemoCache::Shard &MarkdownMemoCache::GetShard(const Key &key) {
+	// The low bits also pick the bucket inside the shard's map, so shard on the high ones
+	return shards[(key.hash >> 48) % SHARD_COUNT];
+}
+
+bool MarkdownMemoCache::Lookup(MarkdownMemoFunction function, const string_t &input, Key &key, Value &result) {
+	key = Key {function, Hash(input.GetData(), input.GetSize())};
+	auto &shard = GetShard(key);
+	shared_ptr<Entry> entry;
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		entry = shard.cache.Get(key);
+	}
+	if (!entry || entry->input.size() != input.GetSize() ||
+	    memcmp(entry->input.data(), input.GetData(), input.GetSize()) != 0) {
+		misses++;
+		return false;
+	}
+	hits++;
+	result = entry->result;
+	return true;
+}
+
+void MarkdownMemoCache::Store(const Key &key, const string_t &input, const Value &result) {
+	auto entry = make_shared_ptr<Entry>();
+	entry->input = input.GetString();
+	entry->result = result;
+	auto size = sizeof(Entry) + entry->input.size() + EstimateValueSize(result);
+	auto &shard = GetShard(key);
+	std::lock_guard<std::mutex> guard(shard.lock);
+	shard.cache.Put(key, std::move(entry), size);
+}
+
+MarkdownMemoCacheStats MarkdownMemoCache::GetStats() const {
+	MarkdownMemoCacheStats stats;
+	stats.capacity = capacity;
+	for (auto &shard : shards) {
+		std::lock_guard<std::mutex> guard(shard.lock);
+		stats.used_bytes += shard.cache.UsedBytes();
+		stats.entries += shard.cache.Count();
+	}
+	stats.hits = hits;
+	stats.misses = misses;
+	return stats;
+}
+
+string MarkdownMemoCache::ObjectType() {
+	return MARKDOWN_MEMO_CACHE_KEY;
+}
+
+string MarkdownMemoCache::GetObjectType() {
+	return ObjectType();
+}
+
+optional_idx MarkdownMemoCache::GetEstimatedCacheMemory() const {
+	return optional_idx(GetStats().used_bytes);
+}
+
+//===--------------------------------------------------------------------===//
+// markdown_memo_cache_stats()
+//===--------------------------------------------------------------------===//
+
+struct MarkdownMemoCacheStatsBindData : public TableFunctionData {
+	MarkdownMemoCacheStats stats;
+};
+
+struct MarkdownMemoCacheStatsState : public GlobalTableFunctionState {
+	bool done = false;
+};
+
+static unique_ptr<FunctionData> MarkdownMemoCacheStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<MarkdownMemoCacheStatsBindData>();
+	auto cache = ObjectCache::GetObjectCache(context).Get<MarkdownMemoCache>(MARKDOWN_MEMO_CACHE_KEY);
+	if (cache) {
+		result->stats = cache->GetStats();
+	}
+
+	names.emplace_back("capacity");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("used_bytes");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("entries");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("hits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("misses");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> MarkdownMemoCacheStatsInit(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	return make_uniq<MarkdownMemoCacheStatsState>();
+}
+
+static void MarkdownMemoCacheStatsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownMemoCacheStatsBindData>();
+	auto &state = input.global_state->Cast<MarkdownMemoCacheStatsState>();
+	if (state.done) {
+		output.SetCardinality(0);
+		return;
+	}
+	const auto &stats = bind_data.stats;
+	output.data[0].SetValue(0, Value::UBIGINT(stats.capacity));
+	output.data[1].SetValue(0, Value::UBIGINT(stats.used_bytes));
+	output.data[2].SetValue(0, Value::UBIGINT(stats.entries));
+	output.data[3].SetValue(0, Value::UBIGINT(stats.hits));
+	output.data[4].SetValue(0, Value::UBIGINT(stats.misses));
+	output.SetCardinality(1);
+	state.done = true;
+}
+
+void MarkdownMemoCache::Register(ExtensionLoader &loader) {
+	TableFunction stats_func("markdown_memo_cache_stats", {}, MarkdownMemoCacheStatsFunction,
+	                         MarkdownMemoCacheStatsBind, MarkdownMemoCacheStatsInit);
+	loader.RegisterFunction(stats_func);
+
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(SETTING_NAME,
+	                          "Bytes of md_to_html/md_extract_sections/md_stats results to memoize by content hash "
+	                          "(0 disables the cache)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0));
+}
+
+} // namespace duckdb
@@ -0,0 +1,822 @@
+#include "markdown_pandoc.hpp"
+#include "markdown_utils.hpp"
+#include "duckdb/common/exception.hpp"
+#include "yyjson.hpp"
+#include <cstdlib>
+
+using namespace duckdb_yyjson; // NOLINT
+
+namespace duckdb {
+
+// Bytes read from the file per refill
+static constexpr idx_t PANDOC_READ_BLOCK_SIZE = 1 << 20;
+// Maximum block / inline nesting depth walked. Guards against unbounded recursion
+// (stack overflow) on adversarially nested ASTs, as ExtractPandocText does.
+static constexpr int MAX_PANDOC_DEPTH = 1000;
+
+//===--------------------------------------------------------------------===//
+// PandocJsonStream
+//===--------------------------------------------------------------------===//
+
+PandocJsonStream::PandocJsonStream(unique_ptr<FileHandle> handle_p) : handle(std::move(handle_p)) {
+}
+
+bool PandocJsonStream::Refill() {
+	if (eof) {
+		return false;
+	}
+	if (pos > 0) {
+		buffer.erase(0, pos);
+		pos = 0;
+	}
+	auto old_size = buffer.size();
+	buffer.resize(old_size + PANDOC_READ_BLOCK_SIZE);
+	auto n = handle->Read(&buffer[old_size], PANDOC_READ_BLOCK_SIZE);
+	buffer.resize(old_size + static_cast<idx_t>(n));
+	bytes_read += static_cast<idx_t>(n);
+	if (n == 0) {
+		eof = true;
+		return false;
+	}
+	return true;
+}
+
+static inline bool IsJsonWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool PandocJsonStream::SkipWhitespace() {
+	while (true) {
+		while (pos < buffer.size() && IsJsonWhitespace(buffer[pos])) {
+			pos++;
+		}
+		if (pos < buffer.size()) {
+			return true;
+		}
+		if (!Refill()) {
+			return false;
+		}
+	}
+}
+
+void PandocJsonStream::ReadValue(string &json) {
+	// Bracket depth outside strings; the scan resumes where it stopped after each refill
+	idx_t offset = 0;
+	idx_t depth = 0;
+	bool in_string = false;
+	bool escaped = false;
+	while (true) {
+		if (pos + offset >= buffer.size()) {
+			if (!Refill()) {
+				throw InvalidInputException("Pandoc JSON document is truncated");
+			}
+			continue;
+		}
+		char c = buffer[pos + offset];
+		if (in_string) {
+			offset++;
+			if (escaped) {
+				escaped = false;
+			} else if (c == '\\') {
+				escaped = true;
+			} else if (c == '"') {
+				in_string = false;
+				if (depth == 0) {
+					break;
+				}
+			}
+			continue;
+		}
+		if (c == '"') {
+			in_string = true;
+		} else if (c == '{' || c == '[') {
+			depth++;
+		} else if (c == '}' || c == ']') {
+			if (depth == 0) {
+				// End of the enclosing object or array: a scalar value ends here
+				if (offset == 0) {
+					throw InvalidInputException("Malformed Pandoc JSON: unexpected '%c'", c);
+				}
+				break;
+			}
+			depth--;
+			if (depth == 0) {
+				offset++;
+				break;
+			}
+		} else if (depth == 0 && (c == ',' || IsJsonWhitespace(c))) {
+			// A scalar value ends at its delimiter
+			break;
+		}
+		offset++;
+	}
+	json.assign(buffer, pos, offset);
+	pos += offset;
+}
+
+bool PandocJsonStream::Next(ItemType &type, string &json) {
+	while (true) {
+		switch (state) {
+		case State::DOCUMENT:
+			if (!SkipWhitespace() || buffer[pos] != '{') {
+				throw InvalidInputException("Not a Pandoc JSON document (expected an object with a \"blocks\" array)");
+			}
+			pos++;
+			state = State::KEY;
+			break;
+		case State::KEY: {
+			if (!SkipWhitespace()) {
+				throw InvalidInputException("Pandoc JSON document is truncated");
+			}
+			if (buffer[pos] == '}') {
+				pos++;
+				state = State::DONE;
+				break;
+			}
+			if (buffer[pos] == ',') {
+				pos++;
+				break;
+			}
+			string key;
+			ReadValue(key);
+			if (!SkipWhitespace() || buffer[pos] != ':') {
+				throw InvalidInputException("Malformed Pandoc JSON: expected ':' after key %s", key);
+			}
+			pos++;
+			if (!SkipWhitespace()) {
+				throw InvalidInputException("Pandoc JSON document is truncated");
+			}
+			if (key == "\"blocks\"") {
+				if (buffer[pos] != '[') {
+					throw InvalidInputException("Malformed Pandoc JSON: \"blocks\" is not an array");
+				}
+				pos++;
+				state = State::BLOCKS;
+				break;
+			}
+			ReadValue(json);
+			if (key == "\"meta\"") {
+				type = ItemType::META;
+				return true;
+			}
+			break; // pandoc-api-version and anything else is skipped
+		}
+		case State::BLOCKS:
+			if (!SkipWhitespace()) {
+				throw InvalidInputException("Pandoc JSON document is truncated");
+			}
+			if (buffer[pos] == ']') {
+				pos++;
+				state = State::KEY;
+				break;
+			}
+			if (buffer[pos] == ',') {
+				pos++;
+				break;
+			}
+			ReadValue(json);
+			type = ItemType::BLOCK;
+			return true;
+		case State::DONE:
+			return false;
+		}
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Pandoc AST helpers
+//===--------------------------------------------------------------------===//
+
+// Parsed JSON text of one piece, freed on scope exit
+struct PandocDocument {
+	explicit PandocDocument(const string &json) {
+		yyjson_read_err error;
+		doc = yyjson_read_opts(const_cast<char *>(json.data()), json.size(), YYJSON_READ_NOFLAG, nullptr, &error);
+		if (!doc) {
+			throw InvalidInputException("Malformed Pandoc JSON: %s at byte %llu of a block", error.msg,
+			                            static_cast<uint64_t>(error.pos));
+		}
+	}
+	~PandocDocument() {
+		yyjson_doc_free(doc);
+	}
+	yyjson_val *Root() const {
+		return yyjson_doc_get_root(doc);
+	}
+
+	yyjson_doc *doc;
+};
+
+static string NodeTag(yyjson_val *node) {
+	auto tag = yyjson_obj_get(node, "t");
+	return yyjson_is_str(tag) ? string(yyjson_get_str(tag), yyjson_get_len(tag)) : string();
+}
+
+static yyjson_val *NodeContent(yyjson_val *node) {
+	return yyjson_obj_get(node, "c");
+}
+
+static string JsonString(yyjson_val *val) {
+	return yyjson_is_str(val) ? string(yyjson_get_str(val), yyjson_get_len(val)) : string();
+}
+
+static void CheckDepth(int depth) {
+	if (depth > MAX_PANDOC_DEPTH) {
+		throw InvalidInputException("Pandoc nesting exceeds maximum supported depth (%d)", MAX_PANDOC_DEPTH);
+	}
+}
+
+// Pandoc Attr [id, [classes], [[key, value]]] as id / class / key attributes
+static void AddPandocAttr(yyjson_val *attr, std::map<string, string> &attributes) {
+	if (!yyjson_is_arr(attr) || yyjson_arr_size(attr) != 3) {
+		return;
+	}
+	auto id = JsonString(yyjson_arr_get(attr, 0));
+	if (!id.empty()) {
+		attributes["id"] = id;
+	}
+	string classes;
+	size_t idx, max;
+	yyjson_val *val;
+	yyjson_arr_foreach(yyjson_arr_get(attr, 1), idx, max, val) {
+		if (!classes.empty()) {
+			classes += ' ';
+		}
+		classes += JsonString(val);
+	}
+	if (!classes.empty()) {
+		attributes["class"] = classes;
+	}
+	yyjson_arr_foreach(yyjson_arr_get(attr, 2), idx, max, val) {
+		auto key = JsonString(yyjson_arr_get(val, 0));
+		if (!key.empty()) {
+			attributes[key] = JsonString(yyjson_arr_get(val, 1));
+		}
+	}
+}
+
+// Text of a list of inlines: markdown keeps emphasis, code, links and images as
+// RenderInlineElementToMarkdown writes them; plain keeps only the words
+static void AppendInlines(yyjson_val *inlines, bool markdown, string &out, int depth);
+static void AppendBlocks(yyjson_val *blocks, bool markdown, string &out, int depth);
+
+static void AppendWrapped(yyjson_val *inlines, bool markdown, const char *marker, string &out, int depth) {
+	if (markdown) {
+		out += marker;
+	}
+	AppendInlines(inlines, markdown, out, depth);
+	if (markdown) {
+		out += marker;
+	}
+}
+
+static void AppendInline(yyjson_val *node, bool markdown, string &out, int depth) {
+	CheckDepth(depth);
+	auto tag = NodeTag(node);
+	auto c = NodeContent(node);
+	if (tag == "Str") {
+		out += JsonString(c);
+	} else if (tag == "Space") {
+		out += ' ';
+	} else if (tag == "SoftBreak") {
+		out += markdown ? "\n" : " ";
+	} else if (tag == "LineBreak") {
+		out += markdown ? "  \n" : " ";
+	} else if (tag == "Emph") {
+		AppendWrapped(c, markdown, "*", out, depth + 1);
+	} else if (tag == "Strong") {
+		AppendWrapped(c, markdown, "**", out, depth + 1);
+	} else if (tag == "Strikeout") {
+		AppendWrapped(c, markdown, "~~", out, depth + 1);
+	} else if (tag == "Superscript") {
+		AppendWrapped(c, markdown, "^", out, depth + 1);
+	} else if (tag == "Subscript") {
+		AppendWrapped(c, markdown, "~", out, depth + 1);
+	} else if (tag == "Underline" || tag == "SmallCaps") {
+		AppendInlines(c, markdown, out, depth + 1);
+	} else if (tag == "Quoted") {
+		bool single = NodeTag(yyjson_arr_get(c, 0)) == "SingleQuote";
+		out += single ? '\'' : '"';
+		AppendInlines(yyjson_arr_get(c, 1), markdown, out, depth + 1);
+		out += single ? '\'' : '"';
+	} else if (tag == "Cite") {
+		AppendInlines(yyjson_arr_get(c, 1), markdown, out, depth + 1);
+	} else if (tag == "Code") {
+		auto code = JsonString(yyjson_arr_get(c, 1));
+		if (markdown) {
+			out += code.find('`') != string::npos ? "`` " + code + " ``" : "`" + code + "`";
+		} else {
+			out += code;
+		}
+	} else if (tag == "Math") {
+		auto tex = JsonString(yyjson_arr_get(c, 1));
+		if (markdown) {
+			auto marker = NodeTag(yyjson_arr_get(c, 0)) == "DisplayMath" ? "$$" : "$";
+			out += marker + tex + marker;
+		} else {
+			out += tex;
+		}
+	} else if (tag == "RawInline") {
+		out += JsonString(yyjson_arr_get(c, 1));
+	} else if (tag == "Link" || tag == "Image") {
+		// [attr, [inlines], [url, title]]
+		auto target = yyjson_arr_get(c, 2);
+		if (markdown) {
+			out += tag == "Image" ? "![" : "[";
+		}
+		AppendInlines(yyjson_arr_get(c, 1), markdown, out, depth + 1);
+		if (markdown) {
+			out += "](" + JsonString(yyjson_arr_get(target, 0));
+			auto title = JsonString(yyjson_arr_get(target, 1));
+			if (!title.empty()) {
+				out += " \"" + title + "\"";
+			}
+			out += ")";
+		}
+	} else if (tag == "Span") {
+		AppendInlines(yyjson_arr_get(c, 1), markdown, out, depth + 1);
+	} else if (tag == "Note") {
+		// Footnote bodies are not part of the running text
+	}
+}
+
+static void AppendInlines(yyjson_val *inlines, bool markdown, string &out, int depth) {
+	CheckDepth(depth);
+	size_t idx, max;
+	yyjson_val *node;
+	yyjson_arr_foreach(inlines, idx, max, node) {
+		AppendInline(node, markdown, out, depth);
+	}
+}
+
+static string InlinesText(yyjson_val *inlines, bool markdown) {
+	string out;
+	AppendInlines(inlines, markdown, out, 0);
+	return out;
+}
+
+// Text of the first Plain / Para of a list item or table cell, like ParseBlocks' list items
+static string FirstParagraphText(yyjson_val *blocks) {
+	size_t idx, max;
+	yyjson_val *block;
+	yyjson_arr_foreach(blocks, idx, max, block) {
+		auto tag = NodeTag(block);
+		if (tag == "Plain" || tag == "Para") {
+			return InlinesText(NodeContent(block), false);
+		}
+	}
+	return string();
+}
+
+// Markdown of nested blocks (blockquote bodies, footnotes)
+static void AppendBlock(yyjson_val *block, bool markdown, string &out, int depth) {
+	CheckDepth(depth);
+	auto tag = NodeTag(block);
+	auto c = NodeContent(block);
+	if (tag == "Plain" || tag == "Para") {
+		AppendInlines(c, markdown, out, depth + 1);
+	} else if (tag == "Header") {
+		if (markdown) {
+			out += string(MinValue<int64_t>(MaxValue<int64_t>(yyjson_get_sint(yyjson_arr_get(c, 0)), 1), 6), '#');
+			out += ' ';
+		}
+		AppendInlines(yyjson_arr_get(c, 2), markdown, out, depth + 1);
+	} else if (tag == "CodeBlock") {
+		auto code = JsonString(yyjson_arr_get(c, 1));
+		out += markdown ? "```\n" + code + "\n```" : code;
+	} else if (tag == "RawBlock") {
+		out += JsonString(yyjson_arr_get(c, 1));
+	} else if (tag == "BlockQuote") {
+		string inner;
+		AppendBlocks(c, markdown, inner, depth + 1);
+		if (!markdown) {
+			out += inner;
+			return;
+		}
+		size_t start = 0;
+		while (start <= inner.size()) {
+			auto end = inner.find('\n', start);
+			if (end == string::npos) {
+				end = inner.size();
+			}
+			out += start > 0 ? "\n> " : "> ";
+			out.append(inner, start, end - start);
+			start = end + 1;
+		}
+	} else if (tag == "BulletList" || tag == "OrderedList") {
+		auto items = tag == "OrderedList" ? yyjson_arr_get(c, 1) : c;
+		auto number = tag == "OrderedList" ? yyjson_get_sint(yyjson_arr_get(yyjson_arr_get(c, 0), 0)) : 0;
+		size_t idx, max;
+		yyjson_val *item;
+		yyjson_arr_foreach(items, idx, max, item) {
+			if (idx > 0) {
+				out += '\n';
+			}
+			if (markdown) {
+				out += tag == "OrderedList" ? std::to_string(number++) + ". " : "- ";
+			}
+			AppendBlocks(item, markdown, out, depth + 1);
+		}
+	} else if (tag == "LineBlock") {
+		size_t idx, max;
+		yyjson_val *line;
+		yyjson_arr_foreach(c, idx, max, line) {
+			if (idx > 0) {
+				out += markdown ? "  \n" : " ";
+			}
+			AppendInlines(line, markdown, out, depth + 1);
+		}
+	} else if (tag == "Div") {
+		AppendBlocks(yyjson_arr_get(c, 1), markdown, out, depth + 1);
+	} else if (tag == "Figure") {
+		AppendBlocks(yyjson_arr_get(c, 2), markdown, out, depth + 1);
+	} else if (tag == "HorizontalRule") {
+		out += markdown ? "---" : "";
+	}
+}
+
+static void AppendBlocks(yyjson_val *blocks, bool markdown, string &out, int depth) {
+	CheckDepth(depth);
+	size_t idx, max;
+	yyjson_val *block;
+	bool first = true;
+	yyjson_arr_foreach(blocks, idx, max, block) {
+		string text;
+		AppendBlock(block, markdown, text, depth);
+		if (text.empty()) {
+			continue;
+		}
+		if (!first) {
+			out += markdown ? "\n\n" : " ";
+		}
+		out += text;
+		first = false;
+	}
+}
+
+// JSON text of a mutable value, freed here
+static string WriteJson(yyjson_mut_val *val) {
+	size_t len = 0;
+	char *json = yyjson_mut_val_write(val, YYJSON_WRITE_NOFLAG, &len);
+	if (!json) {
+		throw InternalException("Failed to write Pandoc row JSON");
+	}
+	string result(json, len);
+	free(json);
+	return result;
+}
+
+// Mutable document freed on scope exit
+struct PandocMutableDocument {
+	PandocMutableDocument() : doc(yyjson_mut_doc_new(nullptr)) {
+	}
+	~PandocMutableDocument() {
+		yyjson_mut_doc_free(doc);
+	}
+	yyjson_mut_doc *doc;
+};
+
+static void AddStringTo(yyjson_mut_doc *doc, yyjson_mut_val *arr, const string &text) {
+	yyjson_mut_arr_append(arr, yyjson_mut_strncpy(doc, text.data(), text.size()));
+}
+
+// Cells of Pandoc table rows: a JSON array of strings per row
+static void AddTableRows(yyjson_mut_doc *doc, yyjson_mut_val *out_rows, yyjson_val *rows, bool legacy) {
+	size_t idx, max;
+	yyjson_val *row;
+	yyjson_arr_foreach(rows, idx, max, row) {
+		auto out_row = yyjson_mut_arr(doc);
+		// Row: [attr, [cells]] with cells [attr, align, rowspan, colspan, [blocks]];
+		// before pandoc 2.10 a row was just [[blocks]] per cell
+		auto cells = legacy ? row : yyjson_arr_get(row, 1);
+		size_t cell_idx, cell_max;
+		yyjson_val *cell;
+		yyjson_arr_foreach(cells, cell_idx, cell_max, cell) {
+			AddStringTo(doc, out_row, FirstParagraphText(legacy ? cell : yyjson_arr_get(cell, 4)));
+		}
+		yyjson_mut_arr_append(out_rows, out_row);
+	}
+}
+
+// {"headers": [...], "rows": [[...], ...]}, the encoding of read_markdown_blocks' tables
+static string TableJson(yyjson_val *c) {
+	PandocMutableDocument mut;
+	auto doc = mut.doc;
+	auto headers = yyjson_mut_arr(doc);
+	auto rows = yyjson_mut_arr(doc);
+
+	// Before pandoc 2.10: [caption, aligns, widths, [header cells], [rows]]
+	bool legacy = yyjson_arr_size(c) == 5;
+	if (legacy) {
+		size_t idx, max;
+		yyjson_val *cell;
+		yyjson_arr_foreach(yyjson_arr_get(c, 3), idx, max, cell) {
+			AddStringTo(doc, headers, FirstParagraphText(cell));
+		}
+		AddTableRows(doc, rows, yyjson_arr_get(c, 4), true);
+	} else {
+		// [attr, caption, colspecs, head, [bodies], foot]; the last head row holds the headers
+		auto head_rows = yyjson_arr_get(yyjson_arr_get(c, 3), 1);
+		auto head_count = yyjson_arr_size(head_rows);
+		if (head_count > 0) {
+			size_t idx, max;
+			yyjson_val *cell;
+			yyjson_arr_foreach(yyjson_arr_get(yyjson_arr_get(head_rows, head_count - 1), 1), idx, max, cell) {
+				AddStringTo(doc, headers, FirstParagraphText(yyjson_arr_get(cell, 4)));
+			}
+		}
+		size_t idx, max;
+		yyjson_val *body;
+		yyjson_arr_foreach(yyjson_arr_get(c, 4), idx, max, body) {
+			// [attr, row_head_columns, [head rows], [body rows]]
+			AddTableRows(doc, rows, yyjson_arr_get(body, 2), false);
+			AddTableRows(doc, rows, yyjson_arr_get(body, 3), false);
+		}
+		AddTableRows(doc, rows, yyjson_arr_get(yyjson_arr_get(c, 5), 1), false);
+	}
+
+	auto root = yyjson_mut_obj(doc);
+	yyjson_mut_obj_add_val(doc, root, "headers", headers);
+	yyjson_mut_obj_add_val(doc, root, "rows", rows);
+	return WriteJson(root);
+}
+
+// Meta value as a JSON value: strings for inline and block text, lists and maps kept
+static yyjson_mut_val *MetaValue(yyjson_mut_doc *doc, yyjson_val *node, int depth) {
+	CheckDepth(depth);
+	auto tag = NodeTag(node);
+	auto c = NodeContent(node);
+	if (tag == "MetaBool") {
+		return yyjson_mut_bool(doc, yyjson_get_bool(c));
+	} else if (tag == "MetaString") {
+		auto text = JsonString(c);
+		return yyjson_mut_strncpy(doc, text.data(), text.size());
+	} else if (tag == "MetaInlines") {
+		auto text = InlinesText(c, true);
+		return yyjson_mut_strncpy(doc, text.data(), text.size());
+	} else if (tag == "MetaBlocks") {
+		string text;
+		AppendBlocks(c, true, text, depth + 1);
+		return yyjson_mut_strncpy(doc, text.data(), text.size());
+	} else if (tag == "MetaList") {
+		auto list = yyjson_mut_arr(doc);
+		size_t idx, max;
+		yyjson_val *item;
+		yyjson_arr_foreach(c, idx, max, item) {
+			yyjson_mut_arr_append(list, MetaValue(doc, item, depth + 1));
+		}
+		return list;
+	} else if (tag == "MetaMap") {
+		auto map = yyjson_mut_obj(doc);
+		size_t idx, max;
+		yyjson_val *key, *val;
+		yyjson_obj_foreach(c, idx, max, key, val) {
+			yyjson_mut_obj_add(map, yyjson_mut_strncpy(doc, yyjson_get_str(key), yyjson_get_len(key)),
+			                   MetaValue(doc, val, depth + 1));
+		}
+		return map;
+	}
+	return yyjson_mut_null(doc);
+}
+
+//===--------------------------------------------------------------------===//
+// PandocConverter
+//===--------------------------------------------------------------------===//
+
+void PandocConverter::AddMeta(const string &json, vector<PandocRow> &rows) {
+	PandocDocument meta(json);
+	auto root = meta.Root();
+	if (!yyjson_is_obj(root) || yyjson_obj_size(root) == 0) {
+		return;
+	}
+	// One `key: value` line per field; JSON values are valid YAML flow values
+	PandocMutableDocument mut;
+	string yaml;
+	size_t idx, max;
+	yyjson_val *key, *val;
+	yyjson_obj_foreach(root, idx, max, key, val) {
+		yaml += string(yyjson_get_str(key), yyjson_get_len(key)) + ": " + WriteJson(MetaValue(mut.doc, val, 0)) + "\n";
+	}
+	yaml.pop_back();
+
+	PandocRow row;
+	row.kind = "block";
+	row.element_type = "frontmatter";
+	row.content = std::move(yaml);
+	row.level = 0;
+	row.encoding = "yaml";
+	row.element_order = next_order++;
+	rows.push_back(std::move(row));
+}
+
+// duck_block element_type of an inline that only wraps other inlines, or empty
+static string InlineContainerType(const string &tag) {
+	if (tag == "Emph") {
+		return "italic";
+	} else if (tag == "Strong") {
+		return "bold";
+	} else if (tag == "Strikeout") {
+		return "strikethrough";
+	} else if (tag == "Superscript") {
+		return "superscript";
+	} else if (tag == "Subscript") {
+		return "subscript";
+	} else if (tag == "Underline") {
+		return "underline";
+	} else if (tag == "SmallCaps") {
+		return "smallcaps";
+	}
+	return string();
+}
+
+// One inline row per inline element, depth first
+static void AddInlineRows(yyjson_val *inlines, int32_t level, int32_t &next_order, vector<PandocRow> &rows) {
+	CheckDepth(level);
+	size_t idx, max;
+	yyjson_val *node;
+	yyjson_arr_foreach(inlines, idx, max, node) {
+		auto tag = NodeTag(node);
+		auto c = NodeContent(node);
+		PandocRow row;
+		row.kind = "inline";
+		row.level = level;
+		yyjson_val *children = nullptr;
+
+		if (tag == "Str") {
+			row.element_type = "text";
+			row.content = JsonString(c);
+		} else if (tag == "Space") {
+			row.element_type = "space";
+			row.content = " ";
+		} else if (tag == "SoftBreak") {
+			row.element_type = "softbreak";
+			row.content = "\n";
+		} else if (tag == "LineBreak") {
+			row.element_type = "linebreak";
+			row.content = "\n";
+		} else if (!InlineContainerType(tag).empty()) {
+			row.element_type = InlineContainerType(tag);
+			children = c;
+		} else if (tag == "Quoted") {
+			row.element_type = "quoted";
+			row.attributes["quote_type"] = NodeTag(yyjson_arr_get(c, 0)) == "SingleQuote" ? "single" : "double";
+			children = yyjson_arr_get(c, 1);
+		} else if (tag == "Cite") {
+			row.element_type = "cite";
+			auto citation = yyjson_arr_get(yyjson_arr_get(c, 0), 0);
+			row.attributes["key"] = JsonString(yyjson_obj_get(citation, "citationId"));
+			children = yyjson_arr_get(c, 1);
+		} else if (tag == "Code") {
+			row.element_type = "code";
+			AddPandocAttr(yyjson_arr_get(c, 0), row.attributes);
+			row.content = JsonString(yyjson_arr_get(c, 1));
+		} else if (tag == "Math") {
+			row.element_type = "math";
+			row.attributes["display"] = NodeTag(yyjson_arr_get(c, 0)) == "DisplayMath" ? "block" : "inline";
+			row.content = JsonString(yyjson_arr_get(c, 1));
+		} else if (tag == "RawInline") {
+			row.element_type = "raw";
+			row.attributes["format"] = JsonString(yyjson_arr_get(c, 0));
+			row.content = JsonString(yyjson_arr_get(c, 1));
+		} else if (tag == "Link" || tag == "Image") {
+			row.element_type = tag == "Link" ? "link" : "image";
+			AddPandocAttr(yyjson_arr_get(c, 0), row.attributes);
+			auto target = yyjson_arr_get(c, 2);
+			row.attributes[tag == "Link" ? "href" : "src"] = JsonString(yyjson_arr_get(target, 0));
+			auto title = JsonString(yyjson_arr_get(target, 1));
+			if (!title.empty()) {
+				row.attributes["title"] = title;
+			}
+			children = yyjson_arr_get(c, 1);
+		} else if (tag == "Span") {
+			row.element_type = "span";
+			AddPandocAttr(yyjson_arr_get(c, 0), row.attributes);
+			children = yyjson_arr_get(c, 1);
+		} else if (tag == "Note") {
+			row.element_type = "note";
+			AppendBlocks(c, false, row.content, level);
+		} else {
+			row.element_type = "raw";
+			row.attributes["original_type"] = tag;
+		}
+
+		if (children) {
+			// Container content is its children's markdown, as RenderInlineElementToMarkdown
+			// expects; an image's is its alt text
+			AppendInlines(children, row.element_type != "image", row.content, level);
+		}
+		row.element_order = next_order++;
+		rows.push_back(std::move(row));
+		if (children) {
+			AddInlineRows(children, level + 1, next_order, rows);
+		}
+	}
+}
+
+void PandocConverter::AddBlock(const string &json, vector<PandocRow> &rows) {
+	PandocDocument block_doc(json);
+	// Div and Figure are flattened, so one piece may hold several blocks
+	vector<yyjson_val *> pending {block_doc.Root()};
+	while (!pending.empty()) {
+		auto block = pending.back();
+		pending.pop_back();
+		auto tag = NodeTag(block);
+		auto c = NodeContent(block);
+		if (tag == "Div" || tag == "Figure") {
+			auto children = yyjson_arr_get(c, tag == "Div" ? 1 : 2);
+			for (auto i = static_cast<idx_t>(yyjson_arr_size(children)); i > 0; i--) {
+				pending.push_back(yyjson_arr_get(children, i - 1));
+			}
+			continue;
+		}
+		if (tag == "Null" || tag.empty()) {
+			continue;
+		}
+
+		PandocRow row;
+		row.kind = "block";
+		yyjson_val *inline_content = nullptr;
+
+		if (tag == "Header") {
+			// [level, attr, inlines]
+			row.element_type = "heading";
+			row.content = InlinesText(yyjson_arr_get(c, 2), false);
+			row.attributes["heading_level"] = std::to_string(yyjson_get_sint(yyjson_arr_get(c, 0)));
+			AddPandocAttr(yyjson_arr_get(c, 1), row.attributes);
+			// Generated IDs take -1, -2 suffixes after earlier headings of the document, as
+			// read_markdown_sections does; explicit Pandoc IDs are kept but still count
+			auto id = row.attributes.find("id");
+			if (id == row.attributes.end()) {
+				auto base_id = markdown_utils::GenerateSectionId(row.content, {});
+				row.attributes["id"] = markdown_utils::GenerateSectionId(row.content, id_counts);
+				id_counts[base_id]++;
+			} else {
+				id_counts[id->second]++;
+			}
+			inline_content = yyjson_arr_get(c, 2);
+		} else if (tag == "Para" || tag == "Plain") {
+			row.element_type = "paragraph";
+			row.content = InlinesText(c, true);
+			inline_content = c;
+		} else if (tag == "LineBlock") {
+			row.element_type = "paragraph";
+			AppendBlock(block, true, row.content, 0);
+		} else if (tag == "CodeBlock") {
+			// [attr, text]; the first class is the language
+			row.element_type = "code";
+			row.content = JsonString(yyjson_arr_get(c, 1));
+			AddPandocAttr(yyjson_arr_get(c, 0), row.attributes);
+			auto classes = row.attributes.find("class");
+			if (classes != row.attributes.end()) {
+				row.attributes["language"] = classes->second.substr(0, classes->second.find(' '));
+			}
+		} else if (tag == "RawBlock") {
+			auto format = JsonString(yyjson_arr_get(c, 0));
+			row.element_type = format == "html" ? "html" : "raw";
+			row.attributes["format"] = format;
+			row.content = JsonString(yyjson_arr_get(c, 1));
+		} else if (tag == "BlockQuote") {
+			row.element_type = "blockquote";
+			AppendBlocks(c, true, row.content, 0);
+		} else if (tag == "BulletList" || tag == "OrderedList") {
+			// BulletList [items]; OrderedList [[start, style, delim], [items]]; an item is [blocks]
+			row.element_type = "list";
+			row.encoding = "json";
+			bool ordered = tag == "OrderedList";
+			row.attributes["ordered"] = ordered ? "true" : "false";
+			if (ordered) {
+				row.attributes["start"] = std::to_string(yyjson_get_sint(yyjson_arr_get(yyjson_arr_get(c, 0), 0)));
+			}
+			PandocMutableDocument mut;
+			auto items = yyjson_mut_arr(mut.doc);
+			size_t idx, max;
+			yyjson_val *item;
+			yyjson_arr_foreach(ordered ? yyjson_arr_get(c, 1) : c, idx, max, item) {
+				AddStringTo(mut.doc, items, FirstParagraphText(item));
+			}
+			row.content = WriteJson(items);
+		} else if (tag == "Table") {
+			row.element_type = "table";
+			row.encoding = "json";
+			row.content = TableJson(c);
+			if (yyjson_arr_size(c) == 6) {
+				AddPandocAttr(yyjson_arr_get(c, 0), row.attributes);
+			}
+		} else if (tag == "HorizontalRule") {
+			row.element_type = "hr";
+		} else {
+			// DefinitionList and anything newer than this reader
+			row.element_type = "raw";
+			row.attributes["original_type"] = tag;
+			AppendBlock(block, true, row.content, 0);
+		}
+
+		row.element_order = next_order++;
+		rows.push_back(std::move(row));
+		if (inlines && inline_content) {
+			AddInlineRows(inline_content, 1, next_order, rows);
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,137 @@
+#include "markdown_reader.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <atomic>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Anchor Scan (read_markdown_anchors)
+//===--------------------------------------------------------------------===//
+// One row per heading anchor of every matching file, for joining `file.md#anchor`
+// links against. Files are handed out to threads through an atomic cursor, and each
+// file gets a single heading-only line pass (ExtractAnchors) with no cmark parse.
+
+struct MarkdownAnchorsBindData : public TableFunctionData {
+	vector<string> files;
+	MarkdownReader::MarkdownReadOptions options;
+};
+
+struct MarkdownAnchorsGlobalState : public GlobalTableFunctionState {
+	std::atomic<idx_t> next_file {0};
+	idx_t max_threads = 1;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownAnchorsLocalState : public LocalTableFunctionState {
+	string file_path;
+	vector<markdown_utils::MarkdownAnchor> anchors;
+	idx_t anchor_index = 0;
+};
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownAnchorsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                             vector<LogicalType> &return_types,
+                                                             vector<string> &names) {
+	auto result = make_uniq<MarkdownAnchorsBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("read_markdown_anchors requires a path");
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "maximum_file_size") {
+			result->options.maximum_file_size = UBigIntValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for read_markdown_anchors: %s", kv.first);
+		}
+	}
+
+	result->files = GetFiles(context, input.inputs[0], false);
+	MarkdownScanReport::BeginScan(context);
+
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("anchor_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("level");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTEGER));
+	names.emplace_back("line");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownAnchorsInitGlobal(ClientContext &context,
+                                                                               TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownAnchorsBindData>();
+	auto result = make_uniq<MarkdownAnchorsGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownAnchorsInitLocal(ExecutionContext &context,
+                                                                             TableFunctionInitInput &input,
+                                                                             GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownAnchorsLocalState>();
+}
+
+void MarkdownReader::MarkdownAnchorsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownAnchorsBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownAnchorsGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownAnchorsLocalState>();
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (lstate.anchor_index >= lstate.anchors.size()) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			lstate.file_path = bind_data.files[file_index];
+			lstate.anchor_index = 0;
+
+			MarkdownFileScanStats file_stats;
+			file_stats.file_path = lstate.file_path;
+			try {
+				auto content = ReadMarkdownFile(context, lstate.file_path, bind_data.options, &file_stats);
+				Profiler scan_timer;
+				scan_timer.Start();
+				lstate.anchors = markdown_utils::ExtractAnchors(content);
+				scan_timer.End();
+				file_stats.parse_seconds = scan_timer.Elapsed();
+			} catch (const std::exception &e) {
+				file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(file_stats));
+				throw InvalidInputException("Error reading anchors of file %s: %s", lstate.file_path, e.what());
+			}
+			MarkdownScanReport::Record(context, std::move(file_stats));
+			continue;
+		}
+
+		const auto &anchor = lstate.anchors[lstate.anchor_index++];
+		output.data[0].SetValue(output_idx, Value(lstate.file_path));
+		output.data[1].SetValue(output_idx, Value(anchor.id));
+		output.data[2].SetValue(output_idx, Value::INTEGER(anchor.level));
+		output.data[3].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(anchor.line)));
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterAnchorsFunction(ExtensionLoader &loader) {
+	TableFunction anchors_func("read_markdown_anchors", {LogicalType(LogicalTypeId::VARCHAR)}, MarkdownAnchorsFunction,
+	                           MarkdownAnchorsBind, MarkdownAnchorsInitGlobal, MarkdownAnchorsInitLocal);
+
+	anchors_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+
+	loader.RegisterFunction(anchors_func);
+}
+
+} // namespace duckdb
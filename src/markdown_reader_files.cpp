@@ -1,6 +1,8 @@
 #include "markdown_reader.hpp"
 #include "markdown_copy.hpp"
+#include "markdown_index.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/types/value.hpp"
@@ -16,19 +18,77 @@ namespace duckdb {
 // File Path Resolution
 //===--------------------------------------------------------------------===//
 
-vector<string> MarkdownReader::GetFiles(ClientContext &context, const Value &path_value, bool ignore_errors) {
+//===--------------------------------------------------------------------===//
+// Sharding
+//===--------------------------------------------------------------------===//
+
+// FNV-1a: unlike std::hash, stable across processes, platforms and builds, so
+// independent scans on different machines agree on the split
+static uint64_t ShardHash(const string &key) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (auto c : key) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static bool InShard(const string &key, idx_t shard_index, idx_t shard_count) {
+	return shard_count <= 1 || ShardHash(key) % shard_count == shard_index;
+}
+
+static bool IsPathSeparator(char c) {
+	return c == '/' || c == '\\';
+}
+
+// First path component of file below base (the whole remainder for files directly in base)
+static string TopLevelComponent(const string &base, const string &file) {
+	auto start = StringUtil::StartsWith(file, base) ? base.size() : 0;
+	auto end = start;
+	while (end < file.size() && !IsPathSeparator(file[end])) {
+		end++;
+	}
+	return file.substr(start, end - start);
+}
+
+vector<string> MarkdownReader::GetFiles(ClientContext &context, const Value &path_value, bool ignore_errors,
+                                        idx_t shard_index, idx_t shard_count,
+                                        const vector<string> &directory_patterns) {
 	auto &fs = FileSystem::GetFileSystem(context);
 	vector<string> result;
 
+	// Explicit files and flat directory listings are sharded by their full path
+	auto add_files = [&](const vector<string> &files) {
+		for (auto &file : files) {
+			if (InShard(file, shard_index, shard_count)) {
+				result.push_back(file);
+			}
+		}
+	};
+
 	// Helper lambda to handle individual file paths
 	auto processPath = [&](const string &markdown_path) {
 		// First: check if we're dealing with just a single file that exists
 		if (fs.FileExists(markdown_path)) {
-			result.push_back(markdown_path);
+			add_files({markdown_path});
 			return;
 		}
 
 		// Second: attempt to use the path as a glob
+		bool sharded_glob = false;
+		if (shard_count > 1) {
+			try {
+				sharded_glob = fs.HasGlob(markdown_path);
+			} catch (const NotImplementedException &) {
+				// No glob support; fall through to the directory checks
+			}
+		}
+		if (sharded_glob) {
+			// An empty shard is expected, so there is no fallback to the directory checks below
+			auto glob_files = GetShardedGlobFiles(context, markdown_path, shard_index, shard_count);
+			result.insert(result.end(), glob_files.begin(), glob_files.end());
+			return;
+		}
 		auto glob_files = GetGlobFiles(context, markdown_path);
 		if (glob_files.size() > 0) {
 			result.insert(result.end(), glob_files.begin(), glob_files.end());
@@ -37,20 +97,18 @@ vector<string> MarkdownReader::GetFiles(ClientContext &context, const Value &pat
 
 		// Third: if it looks like a directory, try to glob out all of the markdown children
 		if (StringUtil::EndsWith(markdown_path, "/")) {
-			auto md_files = GetGlobFiles(context, fs.JoinPath(markdown_path, "*.md"));
-			auto markdown_files = GetGlobFiles(context, fs.JoinPath(markdown_path, "*.markdown"));
-			result.insert(result.end(), md_files.begin(), md_files.end());
-			result.insert(result.end(), markdown_files.begin(), markdown_files.end());
+			for (auto &pattern : directory_patterns) {
+				add_files(GetGlobFiles(context, fs.JoinPath(markdown_path, pattern)));
+			}
 			return;
 		}
 
 		// Fourth: check if it's a directory (without trailing slash)
 		try {
 			if (fs.DirectoryExists(markdown_path)) {
-				auto md_files = GetGlobFiles(context, fs.JoinPath(markdown_path, "*.md"));
-				auto markdown_files = GetGlobFiles(context, fs.JoinPath(markdown_path, "*.markdown"));
-				result.insert(result.end(), md_files.begin(), md_files.end());
-				result.insert(result.end(), markdown_files.begin(), markdown_files.end());
+				for (auto &pattern : directory_patterns) {
+					add_files(GetGlobFiles(context, fs.JoinPath(markdown_path, pattern)));
+				}
 				return;
 			}
 		} catch (const NotImplementedException &) {
@@ -169,17 +227,105 @@ vector<string> MarkdownReader::GetGlobFiles(ClientContext &context, const string
 	return result;
 }
 
+vector<string> MarkdownReader::GetShardedGlobFiles(ClientContext &context, const string &pattern, idx_t shard_index,
+                                                   idx_t shard_count) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<string> result;
+
+	// Literal base directory: everything up to the separator before the first wildcard
+	auto wildcard = pattern.find_first_of("*?[");
+	if (wildcard == string::npos) {
+		wildcard = pattern.size();
+	}
+	idx_t base_len = 0;
+	for (idx_t i = 0; i < wildcard; i++) {
+		if (IsPathSeparator(pattern[i])) {
+			base_len = i + 1;
+		}
+	}
+	auto base = pattern.substr(0, base_len);
+
+	auto keep_shard = [&](const vector<string> &files) {
+		for (auto &file : files) {
+			if (InShard(TopLevelComponent(base, file), shard_index, shard_count)) {
+				result.push_back(file);
+			}
+		}
+	};
+
+	idx_t segment_end = wildcard;
+	while (segment_end < pattern.size() && !IsPathSeparator(pattern[segment_end])) {
+		segment_end++;
+	}
+	if (segment_end >= pattern.size()) {
+		// Wildcards only in the last component: the listing is a single directory read
+		keep_shard(GetGlobFiles(context, pattern));
+		return result;
+	}
+
+	auto first_segment = pattern.substr(base_len, segment_end - base_len);
+	auto separator = pattern.substr(segment_end, 1);
+	auto rest = pattern.substr(segment_end + 1);
+	bool recursive = first_segment == "**";
+
+	// The remainder of the pattern may be a plain path once the wildcard segment is fixed
+	auto expand = [&](const string &sub_pattern) -> vector<string> {
+		bool has_glob;
+		try {
+			has_glob = fs.HasGlob(sub_pattern);
+		} catch (const NotImplementedException &) {
+			has_glob = true;
+		}
+		if (has_glob) {
+			return GetGlobFiles(context, sub_pattern);
+		}
+		if (fs.FileExists(sub_pattern)) {
+			return {sub_pattern};
+		}
+		return {};
+	};
+
+	try {
+		// List the top level once, then expand only the directories that fall in this shard
+		for (auto &entry : fs.Glob(base + (recursive ? "*" : first_segment))) {
+			if (!fs.DirectoryExists(entry.path) ||
+			    !InShard(TopLevelComponent(base, entry.path), shard_index, shard_count)) {
+				continue;
+			}
+			auto files = expand(entry.path + separator + (recursive ? "**" + separator : "") + rest);
+			result.insert(result.end(), files.begin(), files.end());
+		}
+		if (recursive) {
+			// "**" also matches zero directories
+			keep_shard(expand(base + rest));
+		}
+	} catch (const NotImplementedException &) {
+		// No directory listing: expand the whole pattern and keep this shard's part
+		result.clear();
+		keep_shard(GetGlobFiles(context, pattern));
+	}
+
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
 //===--------------------------------------------------------------------===//
 // File Reading
 //===--------------------------------------------------------------------===//
 
 string MarkdownReader::ReadMarkdownFile(ClientContext &context, const string &file_path,
-                                        const MarkdownReadOptions &options) {
+                                        const MarkdownReadOptions &options, MarkdownFileScanStats *stats) {
 	auto &fs = FileSystem::GetFileSystem(context);
+	Profiler read_timer;
+	read_timer.Start();
 
 	// Read file content
 	auto file_handle = fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ);
 	const auto file_size = fs.GetFileSize(*file_handle);
+	if (stats) {
+		stats->file_size = file_size;
+	}
 
 	// Check file size
 	if (options.maximum_file_size > 0) {
@@ -196,12 +342,73 @@ string MarkdownReader::ReadMarkdownFile(ClientContext &context, const string &fi
 
 	// Normalize content if requested
 	if (options.normalize_content) {
-		content = markdown_utils::NormalizeMarkdown(content);
+		markdown_utils::NormalizeMarkdownInPlace(content, options.normalize);
 	}
 
+	read_timer.End();
+	if (stats) {
+		stats->read_seconds = read_timer.Elapsed();
+	}
 	return content;
 }
 
+// First read of a lead_only scan; enough for the front of most documents
+static constexpr idx_t LEAD_PREFIX_SIZE = 4096;
+
+markdown_utils::MarkdownLead MarkdownReader::ReadMarkdownLead(ClientContext &context, const string &file_path,
+                                                              const MarkdownReadOptions &options,
+                                                              MarkdownFileScanStats *stats) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	Profiler read_timer;
+	read_timer.Start();
+
+	auto file_handle = fs.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ);
+	const auto file_size = fs.GetFileSize(*file_handle);
+	if (stats) {
+		stats->file_size = file_size;
+	}
+	if (options.maximum_file_size > 0) {
+		if (file_size > options.maximum_file_size) {
+			throw InvalidInputException("File %s is too large (%llu bytes, maximum is %llu bytes)", file_path,
+			                            file_size, options.maximum_file_size);
+		}
+	}
+
+	// Grow the prefix until ExtractLead can stop inside it. Only whole lines are
+	// normalized and parsed, so a CRLF or code point cut at the end never is.
+	markdown_utils::MarkdownLead lead;
+	string buffer;
+	string content;
+	idx_t prefix_size = LEAD_PREFIX_SIZE;
+	while (true) {
+		const auto target = MinValue<idx_t>(prefix_size, file_size);
+		const auto have = buffer.size();
+		buffer.resize(target);
+		fs.Read(*file_handle, reinterpret_cast<void *>(&buffer[have]), target - have);
+		const bool at_eof = target == file_size;
+
+		auto usable = target;
+		if (!at_eof) {
+			auto last_newline = buffer.rfind('\n');
+			usable = last_newline == string::npos ? 0 : last_newline + 1;
+		}
+		content.assign(buffer, 0, usable);
+		if (options.normalize_content) {
+			markdown_utils::NormalizeMarkdownInPlace(content, options.normalize);
+		}
+		if (markdown_utils::ExtractLead(content.data(), content.size(), at_eof, lead)) {
+			break;
+		}
+		prefix_size *= 2;
+	}
+
+	read_timer.End();
+	if (stats) {
+		stats->read_seconds = read_timer.Elapsed();
+	}
+	return lead;
+}
+
 //===--------------------------------------------------------------------===//
 // Section Processing
 //===--------------------------------------------------------------------===//
@@ -220,6 +427,25 @@ vector<markdown_utils::MarkdownSection> MarkdownReader::ProcessSections(const st
 	                                     options.content_mode, options.max_content_length);
 }
 
+bool MarkdownReader::ExtractFrontmatterSection(const string &content, markdown_utils::MarkdownSection &section) {
+	auto fm = markdown_utils::FindFrontmatter(content);
+	if (!fm.found || fm.body_len == 0) {
+		return false;
+	}
+	string frontmatter = content.substr(fm.body_start, fm.body_len);
+	section.id = "frontmatter";
+	section.section_path = "frontmatter";
+	section.level = 0; // Special level for frontmatter
+	section.title = "frontmatter";
+	section.content = frontmatter;
+	section.parent_id = "";
+	section.position = 0;
+	section.start_line = 1;
+	// The block ends on the line holding the closing "---"
+	section.end_line = markdown_utils::NewlineIndex(content.data(), fm.after_close).LineCount();
+	return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Replacement Scan Support
 //===--------------------------------------------------------------------===//
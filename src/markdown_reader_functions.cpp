@@ -1,13 +1,23 @@
 #include "markdown_reader.hpp"
+#include "markdown_checkpoint.hpp"
+#include "markdown_index.hpp"
+#include "markdown_trigram_index.hpp"
 #include "markdown_types.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/filter/expression_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
 
 namespace duckdb {
 
@@ -21,21 +31,205 @@ struct MarkdownReadDocumentBindData : public TableFunctionData {
 	idx_t current_file_index = 0;
 };
 
+// Files are parsed one at a time during the scan, so a long scan holds one file's
+// rows in memory and its progress can be checkpointed file by file
 struct MarkdownReadSectionBindData : public TableFunctionData {
 	vector<string> files;
 	MarkdownReader::MarkdownReadOptions options;
-	vector<markdown_utils::MarkdownSection> all_sections;
+	idx_t current_file_index = 0;
+	bool file_done = false; // Record the previous file once its rows are out (or it failed to read)
+	vector<markdown_utils::MarkdownSection> file_sections;
 	idx_t current_section_index = 0;
 };
 
 struct MarkdownReadBlocksBindData : public TableFunctionData {
 	vector<string> files;
 	MarkdownReader::MarkdownReadOptions options;
-	// Flattened blocks with file path association
-	vector<pair<string, markdown_utils::MarkdownBlock>> all_blocks;
+	idx_t current_file_index = 0;
+	bool file_done = false; // Record the previous file once its rows are out (or it failed to read)
+	vector<markdown_utils::MarkdownBlock> file_blocks;
 	idx_t current_block_index = 0;
 };
 
+//===--------------------------------------------------------------------===//
+// File Pruning
+//===--------------------------------------------------------------------===//
+// The file_path column is constant per file, so a filter on it (a WHERE clause
+// or a join-derived dynamic filter from the build side of a hash join) decides
+// whether a whole file is needed before the file is read.
+//
+// With a trigram index (markdown_build_trigram_index), filters on content are
+// pushed down as well. The index rules out files and sections whose text lacks
+// a trigram of the filter's LIKE / ILIKE literals before they are read or
+// emitted; the filter itself is then checked exactly on each remaining row.
+
+// Shared by the file-based readers: file_path is always their first column
+struct MarkdownFileScanGlobalState : public GlobalTableFunctionState {
+	optional_ptr<const TableFilter> file_path_filter;
+	optional_ptr<const TableFilter> content_filter;
+	LogicalType content_type;
+	//! Set when the index applies to this scan and the content filter has trigrams to look up
+	unique_ptr<MarkdownTrigramIndex> trigram_index;
+	TrigramQuery trigram_query;
+	//! Files whose rows have all been emitted, handed to the checkpoint once the scan is drained
+	vector<string> completed_files;
+};
+
+// A consumer that stops early (LIMIT) never takes the rows of the chunks it did not pull,
+// so a file only reaches the checkpoint once the scan has returned its empty last chunk
+static void CompleteFile(MarkdownFileScanGlobalState &gstate, const MarkdownReader::MarkdownReadOptions &options,
+                         const string &file_path) {
+	if (!options.checkpoint_file.empty()) {
+		gstate.completed_files.push_back(file_path);
+	}
+}
+
+static void FinishScan(ClientContext &context, MarkdownFileScanGlobalState &gstate,
+                       const MarkdownReader::MarkdownReadOptions &options) {
+	for (auto &file_path : gstate.completed_files) {
+		MarkdownCheckpoint::MarkCompleted(context, options.checkpoint_file, file_path);
+	}
+	gstate.completed_files.clear();
+}
+
+// Column a trigram index can prune on, or INVALID_INDEX. Section content is only
+// indexed as content_mode 'minimal' returns it.
+static idx_t TrigramContentColumn(const MarkdownReadDocumentBindData &bind_data) {
+	if (bind_data.options.trigram_index.empty() || bind_data.options.lead_only) {
+		return DConstants::INVALID_INDEX;
+	}
+	return bind_data.options.include_filepath ? 1 : 0;
+}
+
+static idx_t TrigramContentColumn(const MarkdownReadSectionBindData &bind_data) {
+	if (bind_data.options.trigram_index.empty() || bind_data.options.content_mode != "minimal") {
+		return DConstants::INVALID_INDEX;
+	}
+	return bind_data.options.include_filepath ? 5 : 4;
+}
+
+static idx_t TrigramContentColumn(const MarkdownReadBlocksBindData &bind_data) {
+	return DConstants::INVALID_INDEX;
+}
+
+template <class BIND_DATA>
+static bool ScanSupportsPushdown(const FunctionData &bind_data_p, idx_t col_idx) {
+	auto &bind_data = bind_data_p.Cast<BIND_DATA>();
+	return (bind_data.options.include_filepath && col_idx == 0) || col_idx == TrigramContentColumn(bind_data);
+}
+
+template <class BIND_DATA>
+static unique_ptr<GlobalTableFunctionState> MarkdownFileScanInitGlobal(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<BIND_DATA>();
+	auto &options = bind_data.options;
+	auto result = make_uniq<MarkdownFileScanGlobalState>();
+	auto content_column = TrigramContentColumn(bind_data);
+	if (input.filters) {
+		for (auto &entry : input.filters->filters) {
+			auto column = input.column_ids[entry.first];
+			if (options.include_filepath && column == 0) {
+				result->file_path_filter = entry.second.get();
+			} else if (content_column != DConstants::INVALID_INDEX && column == content_column) {
+				result->content_filter = entry.second.get();
+			}
+		}
+	}
+	if (result->content_filter) {
+		result->content_type = options.content_as_varchar ? LogicalType(LogicalTypeId::VARCHAR)
+		                                                  : MarkdownTypes::MarkdownType();
+		result->trigram_query = TrigramQuery::FromFilter(*result->content_filter);
+		auto signature = MarkdownTrigramIndex::OptionsSignature(
+		    options.normalize_content, options.normalize.trim_trailing_whitespace, options.normalize.expand_tabs,
+		    options.normalize.unicode_nfc);
+		if (result->trigram_query.CanPrune()) {
+			if (!FileSystem::GetFileSystem(context).FileExists(options.trigram_index)) {
+				throw InvalidInputException(
+				    "Trigram index %s does not exist (build it with markdown_build_trigram_index)", options.trigram_index);
+			}
+			auto index = MarkdownTrigramIndex::Load(context, options.trigram_index);
+			// An index of differently normalized content says nothing about this scan
+			if (index->options_signature == signature) {
+				result->trigram_index = std::move(index);
+			}
+		}
+	}
+	return std::move(result);
+}
+
+// Filters that cannot be evaluated here keep the row, which is correct for the
+// optional filters joins push down and for anything DuckDB re-checks
+static bool FilterMatches(ClientContext &context, const TableFilter &filter, const Value &value) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		return filter.Cast<ConstantFilter>().Compare(value);
+	case TableFilterType::IS_NULL:
+		return false;
+	case TableFilterType::IS_NOT_NULL:
+		return true;
+	case TableFilterType::IN_FILTER: {
+		for (auto &in_value : filter.Cast<InFilter>().values) {
+			if (in_value == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			if (!FilterMatches(context, *child, value)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		for (auto &child : filter.Cast<ConjunctionOrFilter>().child_filters) {
+			if (FilterMatches(context, *child, value)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional = filter.Cast<OptionalFilter>();
+		return !optional.child_filter || FilterMatches(context, *optional.child_filter, value);
+	}
+	case TableFilterType::DYNAMIC_FILTER: {
+		// Filled in once the join's build side is complete; until then every row passes
+		auto &filter_data = *filter.Cast<DynamicFilter>().filter_data;
+		lock_guard<mutex> guard(filter_data.lock);
+		return !filter_data.initialized || !filter_data.filter || FilterMatches(context, *filter_data.filter, value);
+	}
+	case TableFilterType::EXPRESSION_FILTER:
+		return filter.Cast<ExpressionFilter>().EvaluateWithConstant(context, value);
+	default:
+		return true;
+	}
+}
+
+static bool FilePathMatches(ClientContext &context, optional_ptr<const TableFilter> filter, const string &file_path) {
+	return !filter || FilterMatches(context, *filter, Value(file_path));
+}
+
+static bool ContentMatches(ClientContext &context, const MarkdownFileScanGlobalState &gstate, const string &content) {
+	if (!gstate.content_filter) {
+		return true;
+	}
+	Value content_value(content);
+	content_value.Reinterpret(gstate.content_type);
+	return FilterMatches(context, *gstate.content_filter, content_value);
+}
+
+// Segments of a file (document first, then sections) that can satisfy the content filter.
+// Returns false when the index cannot rule anything out for the file.
+static bool TrigramCandidates(ClientContext &context, const MarkdownFileScanGlobalState &gstate,
+                              const string &file_path, const MarkdownTrigramIndex::IndexedFile *&file,
+                              vector<bool> &segments) {
+	return gstate.trigram_index &&
+	       gstate.trigram_index->MatchSegments(context, file_path, gstate.trigram_query, file, segments);
+}
+
 //===--------------------------------------------------------------------===//
 // Helper Functions
 //===--------------------------------------------------------------------===//
@@ -89,8 +283,8 @@ static std::string UnescapeMarkdownInline(const std::string &in) {
 	return out;
 }
 
-static Value BuildWikilinksValue(const std::string &content) {
-	auto wikilinks = markdown_utils::ExtractWikilinks(UnescapeMarkdownInline(content));
+static Value BuildWikilinksValue(const std::string &text, const markdown_utils::StructuralIndex &index) {
+	auto wikilinks = markdown_utils::ExtractWikilinks(text, index);
 	vector<Value> rows;
 	for (const auto &wl : wikilinks) {
 		child_list_t<Value> sc;
@@ -109,8 +303,8 @@ static Value BuildWikilinksValue(const std::string &content) {
 	return Value::LIST(rows);
 }
 
-static Value BuildTagsValue(const std::string &content) {
-	auto tags = markdown_utils::ExtractTags(UnescapeMarkdownInline(content));
+static Value BuildTagsValue(const std::string &text, const markdown_utils::StructuralIndex &index) {
+	auto tags = markdown_utils::ExtractTags(text, index);
 	vector<Value> rows;
 	for (const auto &t : tags) {
 		child_list_t<Value> sc;
@@ -124,7 +318,32 @@ static Value BuildTagsValue(const std::string &content) {
 	return Value::LIST(rows);
 }
 
-static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReader::MarkdownReadOptions &options) {
+// Fill the extract_extensions columns (wikilinks, tags) of a row. Both scan the content with
+// inline escapes removed, over one structural index; content_index, an index of the content
+// itself, is reused when there was nothing to unescape.
+static void SetExtensionColumns(DataChunk &output, idx_t &column_idx, idx_t row,
+                                const MarkdownReader::MarkdownReadOptions &options, const std::string &content,
+                                optional_ptr<const markdown_utils::StructuralIndex> content_index) {
+	if (!options.extract_wikilinks && !options.extract_tags) {
+		return;
+	}
+	auto text = UnescapeMarkdownInline(content);
+	unique_ptr<markdown_utils::StructuralIndex> text_index;
+	if (!content_index || text.size() != content.size()) {
+		text_index = make_uniq<markdown_utils::StructuralIndex>(text);
+		content_index = text_index.get();
+	}
+	if (options.extract_wikilinks) {
+		output.data[column_idx].SetValue(row, BuildWikilinksValue(text, *content_index));
+		column_idx++;
+	}
+	if (options.extract_tags) {
+		output.data[column_idx].SetValue(row, BuildTagsValue(text, *content_index));
+		column_idx++;
+	}
+}
+
+void MarkdownReader::ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReadOptions &options) {
 	for (const auto &kv : input.named_parameters) {
 		if (kv.first == "extract_metadata") {
 			options.extract_metadata = BooleanValue::Get(kv.second);
@@ -132,6 +351,16 @@ static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReader::
 			options.include_stats = BooleanValue::Get(kv.second);
 		} else if (kv.first == "normalize_content") {
 			options.normalize_content = BooleanValue::Get(kv.second);
+		} else if (kv.first == "trim_trailing_whitespace") {
+			options.normalize.trim_trailing_whitespace = BooleanValue::Get(kv.second);
+		} else if (kv.first == "expand_tabs") {
+			auto tab_width = IntegerValue::Get(kv.second);
+			if (tab_width < 0) {
+				throw InvalidInputException("expand_tabs must be non-negative (0 disables tab expansion)");
+			}
+			options.normalize.expand_tabs = static_cast<idx_t>(tab_width);
+		} else if (kv.first == "unicode_nfc") {
+			options.normalize.unicode_nfc = BooleanValue::Get(kv.second);
 		} else if (kv.first == "maximum_file_size") {
 			options.maximum_file_size = UBigIntValue::Get(kv.second);
 		} else if (kv.first == "flavor") {
@@ -157,6 +386,8 @@ static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReader::
 			options.include_filepath = BooleanValue::Get(kv.second);
 		} else if (kv.first == "content_as_varchar") {
 			options.content_as_varchar = BooleanValue::Get(kv.second);
+		} else if (kv.first == "lead_only") {
+			options.lead_only = BooleanValue::Get(kv.second);
 		} else if (kv.first == "content_mode") {
 			auto mode = StringValue::Get(kv.second);
 			if (mode != "minimal" && mode != "full" && mode != "smart") {
@@ -170,6 +401,39 @@ static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReader::
 			}
 		} else if (kv.first == "max_content_length") {
 			options.max_content_length = UBigIntValue::Get(kv.second);
+		} else if (kv.first == "separator") {
+			options.separator = StringValue::Get(kv.second);
+			if (options.separator.empty()) {
+				throw InvalidInputException("separator must not be empty");
+			}
+		} else if (kv.first == "shard_index") {
+			auto shard_index = BigIntValue::Get(kv.second);
+			if (shard_index < 0) {
+				throw InvalidInputException("shard_index must be non-negative");
+			}
+			options.shard_index = static_cast<idx_t>(shard_index);
+		} else if (kv.first == "shard_count") {
+			auto shard_count = BigIntValue::Get(kv.second);
+			if (shard_count < 1) {
+				throw InvalidInputException("shard_count must be at least 1");
+			}
+			options.shard_count = static_cast<idx_t>(shard_count);
+		} else if (kv.first == "checkpoint_file") {
+			options.checkpoint_file = StringValue::Get(kv.second);
+			if (options.checkpoint_file.empty()) {
+				throw InvalidInputException("checkpoint_file must not be empty");
+			}
+		} else if (kv.first == "checkpoint_batch") {
+			options.checkpoint_batch = UBigIntValue::Get(kv.second);
+		} else if (kv.first == "trigram_index") {
+			options.trigram_index = StringValue::Get(kv.second);
+			if (options.trigram_index.empty()) {
+				throw InvalidInputException("trigram_index must not be empty");
+			}
+		} else if (kv.first == "delta_cache_size") {
+			options.delta_cache_size = UBigIntValue::Get(kv.second);
+		} else if (kv.first == "parse_cache_size") {
+			options.parse_cache_size = UBigIntValue::Get(kv.second);
 		} else if (kv.first == "extract_extensions") {
 			// Opt-in add-on extractors. Comma-separated VARCHAR — each token is a flavor
 			// ('obsidian' → wikilinks + tags) or a feature ('wikilinks', 'tags').
@@ -202,6 +466,13 @@ static void ParseMarkdownOptions(TableFunctionBindInput &input, MarkdownReader::
 			throw InvalidInputException("Unknown parameter for read_markdown: %s", kv.first);
 		}
 	}
+	if (options.checkpoint_batch > 0 && options.checkpoint_file.empty()) {
+		throw InvalidInputException("checkpoint_batch requires checkpoint_file");
+	}
+	if (options.shard_index >= options.shard_count) {
+		throw InvalidInputException("shard_index must be less than shard_count (got shard_index %llu, shard_count %llu)",
+		                            options.shard_index, options.shard_count);
+	}
 }
 
 //===--------------------------------------------------------------------===//
@@ -219,18 +490,35 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadDocumentsBind(ClientContext
 		throw InvalidInputException("read_markdown requires at least one argument");
 	}
 
-	auto &path_param = input.inputs[0];
-	result->files = GetFiles(context, path_param, false);
-
 	// Parse options
 	ParseMarkdownOptions(input, result->options);
 
+	auto &path_param = input.inputs[0];
+	result->files = GetFiles(context, path_param, false, result->options.shard_index, result->options.shard_count);
+	if (!result->options.checkpoint_file.empty()) {
+		MarkdownCheckpoint::SkipCompleted(context, result->options.checkpoint_file, result->options.checkpoint_batch,
+		                                  result->files);
+	}
+	MarkdownScanReport::BeginScan(context);
+
 	// Define return columns
 	if (result->options.include_filepath) {
 		names.emplace_back("file_path");
 		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
 	}
 
+	if (result->options.lead_only) {
+		// Only the front of each file is read, so no whole-document column can be filled
+		if (result->options.include_stats || result->options.extract_wikilinks || result->options.extract_tags) {
+			throw InvalidInputException("lead_only cannot be combined with include_stats or extract_extensions");
+		}
+		names.emplace_back("title");
+		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+		names.emplace_back("summary");
+		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+		return std::move(result);
+	}
+
 	names.emplace_back("content");
 	if (result->options.content_as_varchar) {
 		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
@@ -245,18 +533,7 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadDocumentsBind(ClientContext
 
 	if (result->options.include_stats) {
 		names.emplace_back("stats");
-
-		// Create stats struct type
-		child_list_t<LogicalType> stats_struct;
-		stats_struct.push_back(make_pair("word_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("char_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("line_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("heading_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("code_block_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("link_count", LogicalType(LogicalTypeId::BIGINT)));
-		stats_struct.push_back(make_pair("reading_time_minutes", LogicalType(LogicalTypeId::DOUBLE)));
-
-		return_types.emplace_back(LogicalType::STRUCT(stats_struct));
+		return_types.emplace_back(markdown_utils::StatsStructType());
 	}
 
 	// Optional add-on extractor columns (extract_extensions param)
@@ -275,8 +552,10 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadDocumentsBind(ClientContext
 void MarkdownReader::MarkdownReadDocumentsFunction(ClientContext &context, TableFunctionInput &input,
                                                    DataChunk &output) {
 	auto &bind_data = input.bind_data->CastNoConst<MarkdownReadDocumentBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownFileScanGlobalState>();
 
 	if (bind_data.current_file_index >= bind_data.files.size()) {
+		FinishScan(context, gstate, bind_data.options);
 		output.SetCardinality(0);
 		return;
 	}
@@ -285,68 +564,93 @@ void MarkdownReader::MarkdownReadDocumentsFunction(ClientContext &context, Table
 
 	while (bind_data.current_file_index < bind_data.files.size() && output_idx < STANDARD_VECTOR_SIZE) {
 		auto &file_path = bind_data.files[bind_data.current_file_index];
+		if (!FilePathMatches(context, gstate.file_path_filter, file_path)) {
+			bind_data.current_file_index++;
+			continue;
+		}
+		const MarkdownTrigramIndex::IndexedFile *indexed_file = nullptr;
+		vector<bool> segments;
+		if (TrigramCandidates(context, gstate, file_path, indexed_file, segments) && !segments[0]) {
+			// Ruled out by the index, so complete like a file that failed the content filter
+			CompleteFile(gstate, bind_data.options, file_path);
+			bind_data.current_file_index++;
+			continue;
+		}
+		MarkdownFileScanStats file_stats;
+		file_stats.file_path = file_path;
 
 		try {
-			// Read file content
-			string content = ReadMarkdownFile(context, file_path, bind_data.options);
-
-			idx_t column_idx = 0;
+			if (bind_data.options.lead_only) {
+				auto lead = ReadMarkdownLead(context, file_path, bind_data.options, &file_stats);
+				idx_t column_idx = 0;
+				if (bind_data.options.include_filepath) {
+					output.data[column_idx++].SetValue(output_idx, Value(file_path));
+				}
+				output.data[column_idx++].SetValue(output_idx, lead.has_title ? Value(lead.title) : Value());
+				output.data[column_idx].SetValue(output_idx, lead.has_summary ? Value(lead.summary) : Value());
+				output_idx++;
+			} else {
+				// Read file content
+				string content = ReadMarkdownFile(context, file_path, bind_data.options, &file_stats);
+				if (!ContentMatches(context, gstate, content)) {
+					// Nothing to emit, so the file is complete
+					MarkdownScanReport::Record(context, std::move(file_stats));
+					CompleteFile(gstate, bind_data.options, file_path);
+					bind_data.current_file_index++;
+					continue;
+				}
+				Profiler parse_timer;
+				parse_timer.Start();
 
-			// Set file path if requested
-			if (bind_data.options.include_filepath) {
-				output.data[column_idx].SetValue(output_idx, Value(file_path));
-				column_idx++;
-			}
+				idx_t column_idx = 0;
 
-			// Set content
-			output.data[column_idx].SetValue(output_idx, Value(content));
-			column_idx++;
+				// Set file path if requested
+				if (bind_data.options.include_filepath) {
+					output.data[column_idx].SetValue(output_idx, Value(file_path));
+					column_idx++;
+				}
 
-			// Set metadata if requested
-			if (bind_data.options.extract_metadata) {
-				auto metadata = markdown_utils::ExtractMetadata(content);
-				output.data[column_idx].SetValue(output_idx, markdown_utils::MetadataToMap(metadata));
+				// Set content
+				output.data[column_idx].SetValue(output_idx, Value(content));
 				column_idx++;
-			}
 
-			// Set stats if requested
-			if (bind_data.options.include_stats) {
-				auto stats = markdown_utils::CalculateStats(content);
-
-				// Create struct value
-				child_list_t<Value> struct_values;
-				struct_values.push_back(std::make_pair("word_count", Value::BIGINT(stats.word_count)));
-				struct_values.push_back(std::make_pair("char_count", Value::BIGINT(stats.char_count)));
-				struct_values.push_back(std::make_pair("line_count", Value::BIGINT(stats.line_count)));
-				struct_values.push_back(std::make_pair("heading_count", Value::BIGINT(stats.heading_count)));
-				struct_values.push_back(std::make_pair("code_block_count", Value::BIGINT(stats.code_block_count)));
-				struct_values.push_back(std::make_pair("link_count", Value::BIGINT(stats.link_count)));
-				struct_values.push_back(
-				    std::make_pair("reading_time_minutes", Value::DOUBLE(stats.reading_time_minutes)));
-
-				output.data[column_idx].SetValue(output_idx, Value::STRUCT(struct_values));
-				column_idx++;
-			}
+				// Set metadata if requested
+				if (bind_data.options.extract_metadata) {
+					auto metadata = markdown_utils::ExtractMetadata(content);
+					output.data[column_idx].SetValue(output_idx, markdown_utils::MetadataToMap(metadata));
+					column_idx++;
+				}
 
-			// Optional add-on extractor columns
-			if (bind_data.options.extract_wikilinks) {
-				output.data[column_idx].SetValue(output_idx, BuildWikilinksValue(content));
-				column_idx++;
-			}
-			if (bind_data.options.extract_tags) {
-				output.data[column_idx].SetValue(output_idx, BuildTagsValue(content));
-				column_idx++;
-			}
+				// Set stats if requested; the add-on extractors reuse its structural index
+				unique_ptr<markdown_utils::StructuralIndex> index;
+				if (bind_data.options.include_stats) {
+					index = make_uniq<markdown_utils::StructuralIndex>(content);
+					auto stats = markdown_utils::CalculateStats(content, *index);
+					output.data[column_idx].SetValue(output_idx, markdown_utils::StatsToStruct(stats));
+					column_idx++;
+				}
 
-			output_idx++;
+				// Optional add-on extractor columns
+				SetExtensionColumns(output, column_idx, output_idx, bind_data.options, content, index.get());
 
+				parse_timer.End();
+				file_stats.parse_seconds = parse_timer.Elapsed();
+				output_idx++;
+			}
 		} catch (const std::exception &e) {
+			file_stats.error = e.what();
+			MarkdownScanReport::Record(context, std::move(file_stats));
 			throw InvalidInputException("Error reading Markdown file %s: %s", file_path, e.what());
 		}
+		MarkdownScanReport::Record(context, std::move(file_stats));
+		CompleteFile(gstate, bind_data.options, file_path);
 
 		bind_data.current_file_index++;
 	}
 
+	if (output_idx == 0) {
+		FinishScan(context, gstate, bind_data.options);
+	}
 	output.SetCardinality(output_idx);
 }
 
@@ -399,6 +703,8 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 
 	// Handle fragment syntax in file paths
 	auto &path_param = input.inputs[0];
+	auto shard_index = result->options.shard_index;
+	auto shard_count = result->options.shard_count;
 	string global_fragment;
 
 	if (path_param.type().id() == LogicalTypeId::VARCHAR) {
@@ -406,9 +712,9 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 		auto [clean_path, fragment] = ParseFragmentFromPath(path_param.ToString());
 		if (!fragment.empty()) {
 			global_fragment = fragment;
-			result->files = GetFiles(context, Value(clean_path), false);
+			result->files = GetFiles(context, Value(clean_path), false, shard_index, shard_count);
 		} else {
-			result->files = GetFiles(context, path_param, false);
+			result->files = GetFiles(context, path_param, false, shard_index, shard_count);
 		}
 	} else if (path_param.type().id() == LogicalTypeId::LIST) {
 		// List of paths - check each for fragments
@@ -423,9 +729,10 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 				}
 			}
 		}
-		result->files = GetFiles(context, Value::LIST(LogicalType::VARCHAR, clean_paths), false);
+		result->files =
+		    GetFiles(context, Value::LIST(LogicalType::VARCHAR, clean_paths), false, shard_index, shard_count);
 	} else {
-		result->files = GetFiles(context, path_param, false);
+		result->files = GetFiles(context, path_param, false, shard_index, shard_count);
 	}
 
 	// Use fragment as section_filter if not already set via parameter
@@ -433,48 +740,11 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 		result->options.section_filter = global_fragment;
 	}
 
-	// Pre-process all files to extract sections
-	for (const auto &file_path : result->files) {
-		try {
-			string content = ReadMarkdownFile(context, file_path, result->options);
-
-			// Add frontmatter as a special section if extract_metadata is enabled
-			if (result->options.extract_metadata) {
-				string frontmatter = markdown_utils::ExtractRawFrontmatter(content);
-				if (!frontmatter.empty()) {
-					markdown_utils::MarkdownSection fm_section;
-					fm_section.id = "frontmatter";
-					fm_section.section_path = "frontmatter";
-					fm_section.level = 0; // Special level for frontmatter
-					fm_section.title = file_path + "|frontmatter";
-					fm_section.content = frontmatter;
-					fm_section.parent_id = "";
-					fm_section.position = 0;
-					fm_section.start_line = 1;
-					// Calculate end line from frontmatter content
-					fm_section.end_line = static_cast<idx_t>(std::count(frontmatter.begin(), frontmatter.end(), '\n') +
-					                                         2); // +2 for --- delimiters
-					result->all_sections.push_back(fm_section);
-				}
-			}
-
-			auto sections = ProcessSections(content, result->options);
-
-			// Add file path to each section for later retrieval
-			// Apply section_filter if specified
-			for (auto &section : sections) {
-				// Check if section matches filter
-				if (!SectionMatchesFilter(section.id, section.section_path, result->options.section_filter)) {
-					continue;
-				}
-				section.title = file_path + "|" + section.title; // Store file path temporarily
-				result->all_sections.push_back(section);
-			}
-		} catch (const std::exception &e) {
-			// Skip files that can't be read
-			continue;
-		}
+	if (!result->options.checkpoint_file.empty()) {
+		MarkdownCheckpoint::SkipCompleted(context, result->options.checkpoint_file, result->options.checkpoint_batch,
+		                                  result->files);
 	}
+	MarkdownScanReport::BeginScan(context);
 
 	// Define return columns for sections
 	if (result->options.include_filepath) {
@@ -510,6 +780,19 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 	names.emplace_back("end_line");
 	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
 
+	// Nested-set columns: descendants of s are the rows with tree_lo BETWEEN s.tree_lo + 1 AND s.tree_hi
+	names.emplace_back("tree_lo");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("tree_hi");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("depth");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTEGER));
+
+	names.emplace_back("subtree_word_count");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
 	// Optional add-on extractor columns (per-section: extracted from section.content)
 	if (result->options.extract_wikilinks) {
 		names.emplace_back("wikilinks");
@@ -523,24 +806,94 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadSectionsBind(ClientContext
 	return std::move(result);
 }
 
+bool MarkdownReader::LoadNextSectionFile(ClientContext &context, MarkdownReadSectionBindData &bind_data,
+                                         MarkdownFileScanGlobalState &scan_state) {
+	auto &options = bind_data.options;
+	if (bind_data.file_done) {
+		CompleteFile(scan_state, options, bind_data.files[bind_data.current_file_index - 1]);
+	}
+	bind_data.file_done = false;
+	bind_data.file_sections.clear();
+	bind_data.current_section_index = 0;
+	if (bind_data.current_file_index >= bind_data.files.size()) {
+		return false;
+	}
+	const auto &file_path = bind_data.files[bind_data.current_file_index++];
+	if (!FilePathMatches(context, scan_state.file_path_filter, file_path)) {
+		return true;
+	}
+	const MarkdownTrigramIndex::IndexedFile *indexed_file = nullptr;
+	vector<bool> segments;
+	if (!TrigramCandidates(context, scan_state, file_path, indexed_file, segments)) {
+		indexed_file = nullptr;
+	} else if (std::find(segments.begin() + 1, segments.end(), true) == segments.end()) {
+		// No section of the file can match; it is complete with no rows
+		bind_data.file_done = true;
+		return true;
+	}
+	// A section is kept unless the index rules it out, then checked against the content filter
+	auto keep_section = [&](const markdown_utils::MarkdownSection &section) {
+		if (indexed_file) {
+			auto start_line = section.level == 0 ? 0 : section.start_line;
+			auto segment = MarkdownTrigramIndex::SectionSegment(*indexed_file, start_line);
+			if (segment != DConstants::INVALID_INDEX && !segments[segment]) {
+				return false;
+			}
+		}
+		return ContentMatches(context, scan_state, section.content);
+	};
+	MarkdownFileScanStats file_stats;
+	file_stats.file_path = file_path;
+	try {
+		string content = ReadMarkdownFile(context, file_path, options, &file_stats);
+		Profiler parse_timer;
+		parse_timer.Start();
+
+		// Add frontmatter as a special section if extract_metadata is enabled
+		if (options.extract_metadata) {
+			markdown_utils::MarkdownSection fm_section;
+			if (ExtractFrontmatterSection(content, fm_section) && keep_section(fm_section)) {
+				bind_data.file_sections.push_back(fm_section);
+			}
+		}
+
+		// Apply section_filter if specified
+		for (auto &section : ProcessSections(content, options)) {
+			if (SectionMatchesFilter(section.id, section.section_path, options.section_filter) &&
+			    keep_section(section)) {
+				bind_data.file_sections.push_back(std::move(section));
+			}
+		}
+		parse_timer.End();
+		file_stats.parse_seconds = parse_timer.Elapsed();
+		file_stats.section_count = bind_data.file_sections.size();
+		bind_data.file_done = true;
+	} catch (const std::exception &e) {
+		// Skip files that can't be read. They still count as done, so a checkpointed
+		// batch run moves past them instead of retrying them in every batch.
+		file_stats.error = e.what();
+		bind_data.file_done = true;
+	}
+	MarkdownScanReport::Record(context, std::move(file_stats));
+	return true;
+}
+
 void MarkdownReader::MarkdownReadSectionsFunction(ClientContext &context, TableFunctionInput &input,
                                                   DataChunk &output) {
 	auto &bind_data = input.bind_data->CastNoConst<MarkdownReadSectionBindData>();
-
-	if (bind_data.current_section_index >= bind_data.all_sections.size()) {
-		output.SetCardinality(0);
-		return;
-	}
+	auto &gstate = input.global_state->Cast<MarkdownFileScanGlobalState>();
 
 	idx_t output_idx = 0;
 
-	while (bind_data.current_section_index < bind_data.all_sections.size() && output_idx < STANDARD_VECTOR_SIZE) {
-		const auto &section = bind_data.all_sections[bind_data.current_section_index];
-
-		// Extract file path from temporarily stored title (file_path|actual_title)
-		auto pipe_pos = section.title.find('|');
-		string file_path = section.title.substr(0, pipe_pos);
-		string actual_title = section.title.substr(pipe_pos + 1);
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (bind_data.current_section_index >= bind_data.file_sections.size()) {
+			if (!LoadNextSectionFile(context, bind_data, gstate)) {
+				break;
+			}
+			continue;
+		}
+		const auto &section = bind_data.file_sections[bind_data.current_section_index];
+		const auto &file_path = bind_data.files[bind_data.current_file_index - 1];
 
 		idx_t column_idx = 0;
 
@@ -556,7 +909,7 @@ void MarkdownReader::MarkdownReadSectionsFunction(ClientContext &context, TableF
 		column_idx++;
 		output.data[column_idx].SetValue(output_idx, Value(section.level));
 		column_idx++;
-		output.data[column_idx].SetValue(output_idx, Value(actual_title));
+		output.data[column_idx].SetValue(output_idx, Value(section.title));
 		column_idx++;
 		output.data[column_idx].SetValue(output_idx, Value(section.content));
 		column_idx++;
@@ -567,20 +920,36 @@ void MarkdownReader::MarkdownReadSectionsFunction(ClientContext &context, TableF
 		output.data[column_idx].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(section.end_line)));
 		column_idx++;
 
-		// Optional add-on extractor columns (extracted from this section's content)
-		if (bind_data.options.extract_wikilinks) {
-			output.data[column_idx].SetValue(output_idx, BuildWikilinksValue(section.content));
-			column_idx++;
-		}
-		if (bind_data.options.extract_tags) {
-			output.data[column_idx].SetValue(output_idx, BuildTagsValue(section.content));
-			column_idx++;
+		// The frontmatter row (tree_lo 0) is not part of the heading tree
+		Value tree_lo(LogicalType::BIGINT);
+		Value tree_hi(LogicalType::BIGINT);
+		Value depth(LogicalType::INTEGER);
+		Value subtree_word_count(LogicalType::BIGINT);
+		if (section.tree_lo > 0) {
+			tree_lo = Value::BIGINT(static_cast<int64_t>(section.tree_lo));
+			tree_hi = Value::BIGINT(static_cast<int64_t>(section.tree_hi));
+			depth = Value::INTEGER(section.depth);
+			subtree_word_count = Value::BIGINT(static_cast<int64_t>(section.subtree_word_count));
 		}
+		output.data[column_idx].SetValue(output_idx, tree_lo);
+		column_idx++;
+		output.data[column_idx].SetValue(output_idx, tree_hi);
+		column_idx++;
+		output.data[column_idx].SetValue(output_idx, depth);
+		column_idx++;
+		output.data[column_idx].SetValue(output_idx, subtree_word_count);
+		column_idx++;
+
+		// Optional add-on extractor columns (extracted from this section's content)
+		SetExtensionColumns(output, column_idx, output_idx, bind_data.options, section.content, nullptr);
 
 		output_idx++;
 		bind_data.current_section_index++;
 	}
 
+	if (output_idx == 0) {
+		FinishScan(context, gstate, bind_data.options);
+	}
 	output.SetCardinality(output_idx);
 }
 
@@ -598,25 +967,17 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadBlocksBind(ClientContext &c
 		throw InvalidInputException("read_markdown_blocks requires at least one argument");
 	}
 
-	auto &path_param = input.inputs[0];
-	result->files = GetFiles(context, path_param, false);
-
 	// Parse options
 	ParseMarkdownOptions(input, result->options);
 
-	// Pre-process all files to extract blocks (flattened)
-	for (const auto &file_path : result->files) {
-		try {
-			string content = ReadMarkdownFile(context, file_path, result->options);
-			auto blocks = markdown_utils::ParseBlocks(content);
-			for (auto &block : blocks) {
-				result->all_blocks.push_back({file_path, block});
-			}
-		} catch (const std::exception &e) {
-			// Skip files that can't be read
-			continue;
-		}
+	auto &path_param = input.inputs[0];
+	result->files = GetFiles(context, path_param, false, result->options.shard_index, result->options.shard_count);
+
+	if (!result->options.checkpoint_file.empty()) {
+		MarkdownCheckpoint::SkipCompleted(context, result->options.checkpoint_file, result->options.checkpoint_batch,
+		                                  result->files);
 	}
+	MarkdownScanReport::BeginScan(context);
 
 	// Define return columns (flattened - one row per block)
 	// Uses duck_block shape: kind, element_type, content, level, encoding, attributes, element_order
@@ -660,18 +1021,58 @@ unique_ptr<FunctionData> MarkdownReader::MarkdownReadBlocksBind(ClientContext &c
 	return std::move(result);
 }
 
+bool MarkdownReader::LoadNextBlocksFile(ClientContext &context, MarkdownReadBlocksBindData &bind_data,
+                                        MarkdownFileScanGlobalState &scan_state) {
+	auto &options = bind_data.options;
+	if (bind_data.file_done) {
+		CompleteFile(scan_state, options, bind_data.files[bind_data.current_file_index - 1]);
+	}
+	bind_data.file_done = false;
+	bind_data.file_blocks.clear();
+	bind_data.current_block_index = 0;
+	if (bind_data.current_file_index >= bind_data.files.size()) {
+		return false;
+	}
+	const auto &file_path = bind_data.files[bind_data.current_file_index++];
+	if (!FilePathMatches(context, scan_state.file_path_filter, file_path)) {
+		return true;
+	}
+	MarkdownFileScanStats file_stats;
+	file_stats.file_path = file_path;
+	try {
+		string content = ReadMarkdownFile(context, file_path, options, &file_stats);
+		Profiler parse_timer;
+		parse_timer.Start();
+		bind_data.file_blocks = markdown_utils::ParseBlocks(content);
+		parse_timer.End();
+		file_stats.parse_seconds = parse_timer.Elapsed();
+		file_stats.block_count = bind_data.file_blocks.size();
+		bind_data.file_done = true;
+	} catch (const std::exception &e) {
+		// Skip files that can't be read. They still count as done, so a checkpointed
+		// batch run moves past them instead of retrying them in every batch.
+		file_stats.error = e.what();
+		bind_data.file_done = true;
+	}
+	MarkdownScanReport::Record(context, std::move(file_stats));
+	return true;
+}
+
 void MarkdownReader::MarkdownReadBlocksFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
 	auto &bind_data = input.bind_data->CastNoConst<MarkdownReadBlocksBindData>();
-
-	if (bind_data.current_block_index >= bind_data.all_blocks.size()) {
-		output.SetCardinality(0);
-		return;
-	}
+	auto &gstate = input.global_state->Cast<MarkdownFileScanGlobalState>();
 
 	idx_t output_idx = 0;
 
-	while (bind_data.current_block_index < bind_data.all_blocks.size() && output_idx < STANDARD_VECTOR_SIZE) {
-		const auto &[file_path, block] = bind_data.all_blocks[bind_data.current_block_index];
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (bind_data.current_block_index >= bind_data.file_blocks.size()) {
+			if (!LoadNextBlocksFile(context, bind_data, gstate)) {
+				break;
+			}
+			continue;
+		}
+		const auto &block = bind_data.file_blocks[bind_data.current_block_index];
+		const auto &file_path = bind_data.files[bind_data.current_file_index - 1];
 
 		idx_t column_idx = 0;
 
@@ -718,19 +1119,15 @@ void MarkdownReader::MarkdownReadBlocksFunction(ClientContext &context, TableFun
 		column_idx++;
 
 		// Optional add-on extractor columns (extracted from this block's content)
-		if (bind_data.options.extract_wikilinks) {
-			output.data[column_idx].SetValue(output_idx, BuildWikilinksValue(block.content));
-			column_idx++;
-		}
-		if (bind_data.options.extract_tags) {
-			output.data[column_idx].SetValue(output_idx, BuildTagsValue(block.content));
-			column_idx++;
-		}
+		SetExtensionColumns(output, column_idx, output_idx, bind_data.options, block.content, nullptr);
 
 		output_idx++;
 		bind_data.current_block_index++;
 	}
 
+	if (output_idx == 0) {
+		FinishScan(context, gstate, bind_data.options);
+	}
 	output.SetCardinality(output_idx);
 }
 
@@ -747,12 +1144,25 @@ void MarkdownReader::RegisterFunction(ExtensionLoader &loader) {
 	read_markdown_func.named_parameters["extract_metadata"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_markdown_func.named_parameters["include_stats"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_markdown_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_markdown_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_markdown_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+	read_markdown_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_markdown_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+	read_markdown_func.named_parameters["shard_index"] = LogicalType(LogicalTypeId::BIGINT);
+	read_markdown_func.named_parameters["shard_count"] = LogicalType(LogicalTypeId::BIGINT);
+	read_markdown_func.named_parameters["checkpoint_file"] = LogicalType(LogicalTypeId::VARCHAR);
+	read_markdown_func.named_parameters["checkpoint_batch"] = LogicalType(LogicalTypeId::UBIGINT);
 	read_markdown_func.named_parameters["extract_extensions"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_markdown_func.named_parameters["flavor"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_markdown_func.named_parameters["include_filepath"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_markdown_func.named_parameters["filename"] = LogicalType(LogicalTypeId::BOOLEAN); // Alias for include_filepath
 	read_markdown_func.named_parameters["content_as_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_markdown_func.named_parameters["trigram_index"] = LogicalType(LogicalTypeId::VARCHAR);
+	read_markdown_func.named_parameters["lead_only"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	read_markdown_func.init_global = MarkdownFileScanInitGlobal<MarkdownReadDocumentBindData>;
+	read_markdown_func.filter_pushdown = true;
+	read_markdown_func.supports_pushdown_type = ScanSupportsPushdown<MarkdownReadDocumentBindData>;
 
 	loader.RegisterFunction(read_markdown_func);
 
@@ -764,7 +1174,14 @@ void MarkdownReader::RegisterFunction(ExtensionLoader &loader) {
 	read_sections_func.named_parameters["extract_metadata"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_sections_func.named_parameters["include_stats"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_sections_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_sections_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_sections_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+	read_sections_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_sections_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+	read_sections_func.named_parameters["shard_index"] = LogicalType(LogicalTypeId::BIGINT);
+	read_sections_func.named_parameters["shard_count"] = LogicalType(LogicalTypeId::BIGINT);
+	read_sections_func.named_parameters["checkpoint_file"] = LogicalType(LogicalTypeId::VARCHAR);
+	read_sections_func.named_parameters["checkpoint_batch"] = LogicalType(LogicalTypeId::UBIGINT);
 	read_sections_func.named_parameters["extract_extensions"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_sections_func.named_parameters["flavor"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_sections_func.named_parameters["include_content"] = LogicalType(LogicalTypeId::BOOLEAN);
@@ -779,6 +1196,11 @@ void MarkdownReader::RegisterFunction(ExtensionLoader &loader) {
 	read_sections_func.named_parameters["content_mode"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_sections_func.named_parameters["max_depth"] = LogicalType(LogicalTypeId::INTEGER);
 	read_sections_func.named_parameters["max_content_length"] = LogicalType(LogicalTypeId::UBIGINT);
+	read_sections_func.named_parameters["trigram_index"] = LogicalType(LogicalTypeId::VARCHAR);
+
+	read_sections_func.init_global = MarkdownFileScanInitGlobal<MarkdownReadSectionBindData>;
+	read_sections_func.filter_pushdown = true;
+	read_sections_func.supports_pushdown_type = ScanSupportsPushdown<MarkdownReadSectionBindData>;
 
 	loader.RegisterFunction(read_sections_func);
 
@@ -789,12 +1211,32 @@ void MarkdownReader::RegisterFunction(ExtensionLoader &loader) {
 	// Add named parameters for blocks
 	read_blocks_func.named_parameters["extract_metadata"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_blocks_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_blocks_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_blocks_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+	read_blocks_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_blocks_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+	read_blocks_func.named_parameters["shard_index"] = LogicalType(LogicalTypeId::BIGINT);
+	read_blocks_func.named_parameters["shard_count"] = LogicalType(LogicalTypeId::BIGINT);
+	read_blocks_func.named_parameters["checkpoint_file"] = LogicalType(LogicalTypeId::VARCHAR);
+	read_blocks_func.named_parameters["checkpoint_batch"] = LogicalType(LogicalTypeId::UBIGINT);
 	read_blocks_func.named_parameters["extract_extensions"] = LogicalType(LogicalTypeId::VARCHAR);
 	read_blocks_func.named_parameters["include_filepath"] = LogicalType(LogicalTypeId::BOOLEAN);
 	read_blocks_func.named_parameters["filename"] = LogicalType(LogicalTypeId::BOOLEAN); // Alias for include_filepath
 
+	read_blocks_func.init_global = MarkdownFileScanInitGlobal<MarkdownReadBlocksBindData>;
+	read_blocks_func.filter_pushdown = true;
+	read_blocks_func.supports_pushdown_type = ScanSupportsPushdown<MarkdownReadBlocksBindData>;
+
 	loader.RegisterFunction(read_blocks_func);
+
+	RegisterStreamFunction(loader);
+	RegisterGitFunction(loader);
+	RegisterLintFunction(loader);
+	RegisterTermStatsFunction(loader);
+	RegisterPageRankFunction(loader);
+	RegisterTrigramIndexFunction(loader);
+	RegisterPandocFunction(loader);
+	RegisterAnchorsFunction(loader);
 }
 
 } // namespace duckdb
@@ -0,0 +1,260 @@
+#include "markdown_reader.hpp"
+#include "markdown_git.hpp"
+#include "markdown_lru_cache.hpp"
+#include "markdown_types.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/table_function.hpp"
+#include <functional>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Git Reader (read_markdown_git)
+//===--------------------------------------------------------------------===//
+// Reads markdown blobs straight out of a repository's object database at one or
+// more revisions, without a checkout. Each blob is parsed into sections once and
+// the result is kept in an LRU keyed by blob id, so files unchanged between the
+// requested revisions are not re-parsed.
+
+static constexpr const char *MARKDOWN_GIT_DEFAULT_GLOB = "**/*.md";
+
+struct MarkdownReadGitBindData : public TableFunctionData {
+	string repo_path;
+	vector<string> revisions;
+	string glob;
+	MarkdownReader::MarkdownReadOptions options;
+};
+
+using MarkdownGitSections = vector<markdown_utils::MarkdownSection>;
+
+struct MarkdownReadGitGlobalState : public GlobalTableFunctionState {
+	explicit MarkdownReadGitGlobalState(idx_t parse_cache_size) : parse_cache(parse_cache_size) {
+	}
+
+	unique_ptr<markdown_git::GitRepository> repo;
+	// Cursor: revision -> file in that revision's tree -> section of that file
+	idx_t rev_index = 0;
+	string commit_id;
+	vector<markdown_git::GitTreeEntry> files;
+	idx_t file_index = 0;
+	bool files_loaded = false;
+	shared_ptr<MarkdownGitSections> sections;
+	idx_t section_index = 0;
+	// Parsed sections keyed by blob id, shared across revisions
+	MarkdownLRUCache<string, MarkdownGitSections> parse_cache;
+};
+
+static idx_t EstimateSectionsSize(const MarkdownGitSections &sections) {
+	idx_t size = sizeof(MarkdownGitSections);
+	for (auto &section : sections) {
+		size += sizeof(section) + section.id.size() + section.section_path.size() + section.title.size() +
+		        section.content.size() + section.parent_id.size();
+	}
+	return size;
+}
+
+static shared_ptr<MarkdownGitSections> ParseGitBlob(MarkdownReadGitGlobalState &gstate,
+                                                     const markdown_git::GitTreeEntry &entry,
+                                                     const MarkdownReader::MarkdownReadOptions &options,
+                                                     const std::function<MarkdownGitSections(const string &)> &parse) {
+	auto cached = gstate.parse_cache.Get(entry.blob_id);
+	if (cached) {
+		return cached;
+	}
+	auto blob = gstate.repo->ReadObject(entry.blob_id);
+	auto result = make_shared_ptr<MarkdownGitSections>();
+	// Oversized blobs are skipped, like unreadable files in read_markdown_sections
+	if (options.maximum_file_size == 0 || blob.data.size() <= options.maximum_file_size) {
+		*result = parse(blob.data);
+	}
+	gstate.parse_cache.Put(entry.blob_id, result, EstimateSectionsSize(*result));
+	return result;
+}
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownReadGitBind(ClientContext &context, TableFunctionBindInput &input,
+                                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<MarkdownReadGitBindData>();
+
+	if (input.inputs.size() < 2 || input.inputs[0].IsNull() || input.inputs[1].IsNull()) {
+		throw InvalidInputException("read_markdown_git requires a repository path and a revision");
+	}
+	result->repo_path = StringValue::Get(input.inputs[0]);
+
+	auto &rev_param = input.inputs[1];
+	if (rev_param.type().id() == LogicalTypeId::LIST) {
+		for (auto &rev : ListValue::GetChildren(rev_param)) {
+			if (!rev.IsNull()) {
+				result->revisions.push_back(StringValue::Get(rev));
+			}
+		}
+	} else {
+		result->revisions.push_back(StringValue::Get(rev_param));
+	}
+
+	result->glob = MARKDOWN_GIT_DEFAULT_GLOB;
+	if (input.inputs.size() > 2 && !input.inputs[2].IsNull()) {
+		result->glob = StringValue::Get(input.inputs[2]);
+	}
+
+	ParseMarkdownOptions(input, result->options);
+
+	names.emplace_back("rev");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("commit_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("blob_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("section_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("section_path");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("level");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTEGER));
+
+	names.emplace_back("title");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("content");
+	if (result->options.content_as_varchar) {
+		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	} else {
+		return_types.emplace_back(MarkdownTypes::MarkdownType());
+	}
+
+	names.emplace_back("parent_id");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	names.emplace_back("start_line");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("end_line");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownReadGitInitGlobal(ClientContext &context,
+                                                                               TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadGitBindData>();
+	auto result = make_uniq<MarkdownReadGitGlobalState>(bind_data.options.parse_cache_size);
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->repo =
+	    make_uniq<markdown_git::GitRepository>(fs, bind_data.repo_path, bind_data.options.delta_cache_size);
+	return std::move(result);
+}
+
+void MarkdownReader::MarkdownReadGitFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadGitBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownReadGitGlobalState>();
+	const auto &options = bind_data.options;
+
+	auto parse = [&](const string &blob) {
+		string content = blob;
+		if (options.normalize_content) {
+			markdown_utils::NormalizeMarkdownInPlace(content, options.normalize);
+		}
+		MarkdownGitSections sections;
+		markdown_utils::MarkdownSection fm_section;
+		if (options.extract_metadata && ExtractFrontmatterSection(content, fm_section)) {
+			sections.push_back(std::move(fm_section));
+		}
+		for (auto &section : ProcessSections(content, options)) {
+			sections.push_back(std::move(section));
+		}
+		return sections;
+	};
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && gstate.rev_index < bind_data.revisions.size()) {
+		const auto &rev = bind_data.revisions[gstate.rev_index];
+		if (!gstate.files_loaded) {
+			gstate.commit_id = gstate.repo->ResolveCommit(rev);
+			gstate.files = gstate.repo->ListFiles(gstate.commit_id, bind_data.glob);
+			gstate.file_index = 0;
+			gstate.sections = nullptr;
+			gstate.files_loaded = true;
+		}
+		if (gstate.file_index >= gstate.files.size()) {
+			gstate.rev_index++;
+			gstate.files_loaded = false;
+			continue;
+		}
+
+		const auto &entry = gstate.files[gstate.file_index];
+		if (!gstate.sections) {
+			gstate.sections = ParseGitBlob(gstate, entry, options, parse);
+			gstate.section_index = 0;
+		}
+		if (gstate.section_index >= gstate.sections->size()) {
+			gstate.file_index++;
+			gstate.sections = nullptr;
+			continue;
+		}
+
+		const auto &section = (*gstate.sections)[gstate.section_index];
+		idx_t column_idx = 0;
+		output.data[column_idx++].SetValue(output_idx, Value(rev));
+		output.data[column_idx++].SetValue(output_idx, Value(gstate.commit_id));
+		output.data[column_idx++].SetValue(output_idx, Value(entry.path));
+		output.data[column_idx++].SetValue(output_idx, Value(entry.blob_id));
+		output.data[column_idx++].SetValue(output_idx, Value(section.id));
+		output.data[column_idx++].SetValue(output_idx, Value(section.section_path));
+		output.data[column_idx++].SetValue(output_idx, Value(section.level));
+		output.data[column_idx++].SetValue(output_idx, Value(section.title));
+		output.data[column_idx++].SetValue(output_idx, Value(section.content));
+		output.data[column_idx++].SetValue(output_idx,
+		                                   section.parent_id.empty() ? Value() : Value(section.parent_id));
+		output.data[column_idx++].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(section.start_line)));
+		output.data[column_idx++].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(section.end_line)));
+
+		gstate.section_index++;
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterGitFunction(ExtensionLoader &loader) {
+	TableFunctionSet read_git_set("read_markdown_git");
+
+	// rev is a single revision or a list of revisions; glob defaults to '**/*.md'
+	vector<vector<LogicalType>> signatures = {
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR},
+	    {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	    {LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR)},
+	    {LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR), LogicalType::VARCHAR}};
+
+	for (auto &arguments : signatures) {
+		TableFunction read_git_func("read_markdown_git", arguments, MarkdownReadGitFunction, MarkdownReadGitBind,
+		                            MarkdownReadGitInitGlobal);
+		read_git_func.named_parameters["extract_metadata"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+		read_git_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+		read_git_func.named_parameters["include_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["min_level"] = LogicalType(LogicalTypeId::INTEGER);
+		read_git_func.named_parameters["max_level"] = LogicalType(LogicalTypeId::INTEGER);
+		read_git_func.named_parameters["content_as_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
+		read_git_func.named_parameters["content_mode"] = LogicalType(LogicalTypeId::VARCHAR);
+		read_git_func.named_parameters["max_depth"] = LogicalType(LogicalTypeId::INTEGER);
+		read_git_func.named_parameters["max_content_length"] = LogicalType(LogicalTypeId::UBIGINT);
+		read_git_func.named_parameters["delta_cache_size"] = LogicalType(LogicalTypeId::UBIGINT);
+		read_git_func.named_parameters["parse_cache_size"] = LogicalType(LogicalTypeId::UBIGINT);
+		read_git_set.AddFunction(read_git_func);
+	}
+
+	loader.RegisterFunction(read_git_set);
+}
+
+} // namespace duckdb
@@ -0,0 +1,147 @@
+#include "markdown_reader.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <atomic>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Lint Scan (markdown_lint)
+//===--------------------------------------------------------------------===//
+// One row per lint issue of every matching file. Files are handed out to threads
+// through an atomic cursor; each thread reads and lints its file on its own, so
+// a vault is linted on all cores with no lock on the hot path.
+
+struct MarkdownLintBindData : public TableFunctionData {
+	vector<string> files;
+	MarkdownReader::MarkdownReadOptions options;
+	uint32_t rules = markdown_utils::LINT_ALL_RULES;
+};
+
+struct MarkdownLintGlobalState : public GlobalTableFunctionState {
+	std::atomic<idx_t> next_file {0};
+	idx_t max_threads = 1;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownLintLocalState : public LocalTableFunctionState {
+	string file_path;
+	vector<markdown_utils::MarkdownLintIssue> issues;
+	idx_t issue_index = 0;
+};
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownLintBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<MarkdownLintBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("markdown_lint requires a path");
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "rules") {
+			if (kv.second.IsNull()) {
+				continue;
+			}
+			vector<std::string> rule_names;
+			for (auto &rule : ListValue::GetChildren(kv.second)) {
+				rule_names.push_back(rule.ToString());
+			}
+			result->rules = markdown_utils::ParseLintRules(rule_names);
+		} else if (kv.first == "maximum_file_size") {
+			result->options.maximum_file_size = UBigIntValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for markdown_lint: %s", kv.first);
+		}
+	}
+
+	result->files = GetFiles(context, input.inputs[0], false);
+	MarkdownScanReport::BeginScan(context);
+
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("rule");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("line");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	names.emplace_back("message");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownLintInitGlobal(ClientContext &context,
+                                                                            TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownLintBindData>();
+	auto result = make_uniq<MarkdownLintGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownLintInitLocal(ExecutionContext &context,
+                                                                          TableFunctionInitInput &input,
+                                                                          GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownLintLocalState>();
+}
+
+void MarkdownReader::MarkdownLintFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownLintBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownLintGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownLintLocalState>();
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (lstate.issue_index >= lstate.issues.size()) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			lstate.file_path = bind_data.files[file_index];
+			lstate.issue_index = 0;
+
+			MarkdownFileScanStats file_stats;
+			file_stats.file_path = lstate.file_path;
+			try {
+				auto content = ReadMarkdownFile(context, lstate.file_path, bind_data.options, &file_stats);
+				Profiler lint_timer;
+				lint_timer.Start();
+				lstate.issues = markdown_utils::LintMarkdown(content, bind_data.rules);
+				lint_timer.End();
+				file_stats.parse_seconds = lint_timer.Elapsed();
+			} catch (const std::exception &e) {
+				file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(file_stats));
+				throw InvalidInputException("Error linting file %s: %s", lstate.file_path, e.what());
+			}
+			MarkdownScanReport::Record(context, std::move(file_stats));
+			continue;
+		}
+
+		const auto &issue = lstate.issues[lstate.issue_index++];
+		output.data[0].SetValue(output_idx, Value(lstate.file_path));
+		output.data[1].SetValue(output_idx, Value(issue.rule));
+		output.data[2].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(issue.line)));
+		output.data[3].SetValue(output_idx, Value(issue.message));
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterLintFunction(ExtensionLoader &loader) {
+	TableFunction lint_func("markdown_lint", {LogicalType(LogicalTypeId::VARCHAR)}, MarkdownLintFunction,
+	                        MarkdownLintBind, MarkdownLintInitGlobal, MarkdownLintInitLocal);
+
+	lint_func.named_parameters["rules"] = LogicalType::LIST(LogicalType(LogicalTypeId::VARCHAR));
+	lint_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+
+	loader.RegisterFunction(lint_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,493 @@
+#include "markdown_reader.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Link Graph Centrality (markdown_pagerank)
+//===--------------------------------------------------------------------===//
+// One row per matching file with its PageRank over the graph of resolved wikilinks
+// and relative markdown links between the files. The scan runs in three phases that
+// every thread takes part in:
+//   1. Files are claimed through an atomic cursor and their link targets extracted
+//      into per-file slots; the thread finishing the last file resolves the targets
+//      and builds the graph in compressed sparse row (CSR) form.
+//   2. Each iteration is a sparse matrix-vector product over the in-edges, split in
+//      blocks of nodes that threads claim; a block only writes its own nodes, so the
+//      product needs no atomics, and the thread completing the last block advances
+//      the iteration.
+//   3. Rows are emitted in chunks claimed through a second cursor.
+// A thread only ever waits on work another thread has already claimed, so the scan
+// cannot stall when the scheduler runs fewer threads than MaxThreads().
+
+//! Nodes per claimed block of the sparse matrix-vector product
+static constexpr idx_t PAGERANK_BLOCK_SIZE = 1024;
+
+struct FileLinkTargets {
+	vector<string> wikilinks; // [[target]] note names
+	vector<string> urls;      // [text](url) destinations
+};
+
+//! Link graph of the scanned files, indexed like the file list. The sources linking to
+//! node v are in_sources[in_offsets[v] .. in_offsets[v + 1]).
+struct LinkGraph {
+	vector<idx_t> in_offsets;
+	vector<uint32_t> in_sources;
+	vector<idx_t> out_degree;
+};
+
+struct MarkdownPageRankBindData : public TableFunctionData {
+	vector<string> files;
+	MarkdownReader::MarkdownReadOptions options;
+	idx_t iterations = 20;
+	double damping = 0.85;
+};
+
+struct MarkdownPageRankGlobalState : public GlobalTableFunctionState {
+	idx_t max_threads = 1;
+
+	// Phase 1: link extraction; each slot is written by the thread that claimed its file
+	std::atomic<idx_t> next_file {0};
+	vector<FileLinkTargets> targets;
+
+	std::mutex lock;
+	std::condition_variable state_changed;
+	idx_t files_done = 0;
+	bool graph_ready = false;
+	bool failed = false;
+	LinkGraph graph;
+
+	// Phase 2: iterations (under lock). contrib[u] is rank[u] / out_degree[u], and
+	// dangling is the rank held by nodes without out-links, spread over all nodes.
+	idx_t iteration = 0;
+	idx_t block_count = 0;
+	idx_t next_block = 0;
+	idx_t blocks_done = 0;
+	vector<double> rank, contrib;
+	vector<double> next_rank, next_contrib;
+	double dangling = 0;
+	double next_dangling = 0;
+
+	// Phase 3: output
+	std::atomic<idx_t> next_row {0};
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownPageRankLocalState : public LocalTableFunctionState {
+	bool scanned = false;
+};
+
+//===--------------------------------------------------------------------===//
+// Link Resolution
+//===--------------------------------------------------------------------===//
+
+// Collapse "." and ".." segments and repeated slashes
+static string NormalizeLinkPath(const string &path) {
+	vector<string> segments;
+	for (auto &segment : StringUtil::Split(path, '/')) {
+		if (segment.empty() || segment == ".") {
+			continue;
+		}
+		if (segment == ".." && !segments.empty() && segments.back() != "..") {
+			segments.pop_back();
+		} else {
+			segments.push_back(segment);
+		}
+	}
+	auto result = StringUtil::Join(segments, "/");
+	return StringUtil::StartsWith(path, "/") ? "/" + result : result;
+}
+
+static string DirectoryOf(const string &path) {
+	auto slash = path.rfind('/');
+	return slash == string::npos ? string() : path.substr(0, slash);
+}
+
+// Lowercased file name without its .md / .markdown extension: the name wikilinks use
+static string NoteName(const string &path) {
+	auto slash = path.rfind('/');
+	auto name = StringUtil::Lower(slash == string::npos ? path : path.substr(slash + 1));
+	if (StringUtil::EndsWith(name, ".md")) {
+		name.resize(name.size() - 3);
+	} else if (StringUtil::EndsWith(name, ".markdown")) {
+		name.resize(name.size() - 9);
+	}
+	return name;
+}
+
+static string PercentDecode(const string &url) {
+	string result;
+	for (size_t i = 0; i < url.size(); i++) {
+		if (url[i] == '%' && i + 2 < url.size() && std::isxdigit(static_cast<unsigned char>(url[i + 1])) &&
+		    std::isxdigit(static_cast<unsigned char>(url[i + 2]))) {
+			result += static_cast<char>(std::stoi(url.substr(i + 1, 2), nullptr, 16));
+			i += 2;
+		} else {
+			result += url[i];
+		}
+	}
+	return result;
+}
+
+struct LinkResolver {
+	explicit LinkResolver(const vector<string> &files) : paths(files.size()) {
+		for (idx_t i = 0; i < files.size(); i++) {
+			paths[i] = NormalizeLinkPath(files[i]);
+			by_path.emplace(paths[i], i);
+			by_name[NoteName(paths[i])].push_back(i);
+		}
+	}
+
+	// [[target]] resolves by note name, case-insensitively; a target with a folder
+	// ([[area/note]]) must also match the end of the path. Among several candidates the
+	// note in the linking file's folder wins, then the one with the shortest path.
+	idx_t ResolveWikilink(idx_t source, string target) const {
+		StringUtil::Trim(target);
+		auto name = NoteName(target);
+		auto entry = by_name.find(name);
+		if (entry == by_name.end()) {
+			return DConstants::INVALID_INDEX;
+		}
+		auto folder = StringUtil::Lower(NormalizeLinkPath(DirectoryOf(target)));
+		auto source_dir = DirectoryOf(paths[source]);
+		idx_t best = DConstants::INVALID_INDEX;
+		for (auto candidate : entry->second) {
+			auto candidate_dir = DirectoryOf(paths[candidate]);
+			if (!folder.empty()) {
+				auto lower_dir = StringUtil::Lower(candidate_dir);
+				if (lower_dir != folder && !StringUtil::EndsWith(lower_dir, "/" + folder)) {
+					continue;
+				}
+			}
+			if (candidate_dir == source_dir) {
+				return candidate;
+			}
+			if (best == DConstants::INVALID_INDEX || paths[candidate].size() < paths[best].size()) {
+				best = candidate;
+			}
+		}
+		return best;
+	}
+
+	// [text](url) resolves relative to the linking file, with or without the .md extension.
+	// External URLs (with a scheme) and same-document #anchors never resolve.
+	idx_t ResolveUrl(idx_t source, const string &url) const {
+		auto path = url.substr(0, url.find_first_of("#?"));
+		auto colon = path.find(':');
+		if (path.empty() || (colon != string::npos && colon < path.find('/'))) {
+			return DConstants::INVALID_INDEX;
+		}
+		path = PercentDecode(path);
+		auto source_dir = DirectoryOf(paths[source]);
+		if (!StringUtil::StartsWith(path, "/") && !source_dir.empty()) {
+			path = source_dir + "/" + path;
+		}
+		path = NormalizeLinkPath(path);
+		for (auto &candidate : {path, path + ".md"}) {
+			auto entry = by_path.find(candidate);
+			if (entry != by_path.end()) {
+				return entry->second;
+			}
+		}
+		return DConstants::INVALID_INDEX;
+	}
+
+	vector<string> paths;
+	std::unordered_map<string, idx_t> by_path;
+	std::unordered_map<string, vector<idx_t>> by_name;
+};
+
+// Resolve every file's link targets and build the in-edge CSR. Repeated links between
+// two files count once, and links of a file to itself are dropped.
+static LinkGraph BuildLinkGraph(const vector<string> &files, const vector<FileLinkTargets> &targets) {
+	LinkResolver resolver(files);
+	LinkGraph graph;
+	graph.out_degree.resize(files.size(), 0);
+	graph.in_offsets.resize(files.size() + 1, 0);
+
+	vector<vector<idx_t>> out_edges(files.size());
+	for (idx_t source = 0; source < files.size(); source++) {
+		auto &edges = out_edges[source];
+		for (auto &target : targets[source].wikilinks) {
+			edges.push_back(resolver.ResolveWikilink(source, target));
+		}
+		for (auto &url : targets[source].urls) {
+			edges.push_back(resolver.ResolveUrl(source, url));
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		edges.erase(std::remove_if(edges.begin(), edges.end(),
+		                           [&](idx_t target) { return target == source || target == DConstants::INVALID_INDEX; }),
+		            edges.end());
+		graph.out_degree[source] = edges.size();
+		for (auto target : edges) {
+			graph.in_offsets[target + 1]++;
+		}
+	}
+	for (idx_t node = 0; node < files.size(); node++) {
+		graph.in_offsets[node + 1] += graph.in_offsets[node];
+	}
+
+	// Sources are visited in order, so each node's in-edges come out sorted
+	graph.in_sources.resize(graph.in_offsets.back());
+	auto fill = graph.in_offsets;
+	for (idx_t source = 0; source < files.size(); source++) {
+		for (auto target : out_edges[source]) {
+			graph.in_sources[fill[target]++] = static_cast<uint32_t>(source);
+		}
+	}
+	return graph;
+}
+
+//===--------------------------------------------------------------------===//
+// Table Function
+//===--------------------------------------------------------------------===//
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownPageRankBind(ClientContext &context, TableFunctionBindInput &input,
+                                                              vector<LogicalType> &return_types,
+                                                              vector<string> &names) {
+	auto result = make_uniq<MarkdownPageRankBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("markdown_pagerank requires a path");
+	}
+	if (input.inputs.size() > 1 && !input.inputs[1].IsNull()) {
+		auto iterations = IntegerValue::Get(input.inputs[1]);
+		if (iterations < 0) {
+			throw InvalidInputException("markdown_pagerank iterations must not be negative");
+		}
+		result->iterations = static_cast<idx_t>(iterations);
+	}
+	if (input.inputs.size() > 2 && !input.inputs[2].IsNull()) {
+		result->damping = DoubleValue::Get(input.inputs[2]);
+		if (!(result->damping >= 0 && result->damping <= 1)) {
+			throw InvalidInputException("markdown_pagerank damping must be between 0 and 1");
+		}
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "maximum_file_size") {
+			result->options.maximum_file_size = UBigIntValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for markdown_pagerank: %s", kv.first);
+		}
+	}
+
+	result->files = GetFiles(context, input.inputs[0], false);
+	if (result->files.size() > NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("markdown_pagerank supports at most %llu files", NumericLimits<uint32_t>::Maximum());
+	}
+	MarkdownScanReport::BeginScan(context);
+
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("pagerank");
+	return_types.emplace_back(LogicalType(LogicalTypeId::DOUBLE));
+	names.emplace_back("in_degree");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	names.emplace_back("out_degree");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownPageRankInitGlobal(ClientContext &context,
+                                                                                TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownPageRankBindData>();
+	auto result = make_uniq<MarkdownPageRankGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	result->targets.resize(bind_data.files.size());
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownPageRankInitLocal(ExecutionContext &context,
+                                                                              TableFunctionInitInput &input,
+                                                                              GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownPageRankLocalState>();
+}
+
+// Build the graph and the uniform starting ranks; called once, under the lock
+static void StartPageRank(const MarkdownPageRankBindData &bind_data, MarkdownPageRankGlobalState &gstate) {
+	gstate.graph = BuildLinkGraph(bind_data.files, gstate.targets);
+	gstate.targets.clear();
+
+	auto node_count = bind_data.files.size();
+	gstate.rank.assign(node_count, node_count ? 1.0 / static_cast<double>(node_count) : 0.0);
+	gstate.contrib.assign(node_count, 0.0);
+	for (idx_t node = 0; node < node_count; node++) {
+		if (gstate.graph.out_degree[node] > 0) {
+			gstate.contrib[node] = gstate.rank[node] / static_cast<double>(gstate.graph.out_degree[node]);
+		} else {
+			gstate.dangling += gstate.rank[node];
+		}
+	}
+	gstate.next_rank.resize(node_count);
+	gstate.next_contrib.resize(node_count);
+	gstate.block_count = (node_count + PAGERANK_BLOCK_SIZE - 1) / PAGERANK_BLOCK_SIZE;
+	gstate.graph_ready = true;
+}
+
+// One block of rank' = (1 - d) / N + d * (M * rank + dangling / N); returns the block's dangling rank
+static double PageRankBlock(const MarkdownPageRankBindData &bind_data, MarkdownPageRankGlobalState &gstate,
+                            idx_t block) {
+	auto &graph = gstate.graph;
+	auto node_count = bind_data.files.size();
+	auto damping = bind_data.damping;
+	auto base = (1.0 - damping) / static_cast<double>(node_count) +
+	            damping * gstate.dangling / static_cast<double>(node_count);
+
+	double dangling = 0;
+	auto end = MinValue<idx_t>(node_count, (block + 1) * PAGERANK_BLOCK_SIZE);
+	for (idx_t node = block * PAGERANK_BLOCK_SIZE; node < end; node++) {
+		double sum = 0;
+		for (idx_t edge = graph.in_offsets[node]; edge < graph.in_offsets[node + 1]; edge++) {
+			sum += gstate.contrib[graph.in_sources[edge]];
+		}
+		auto rank = base + damping * sum;
+		gstate.next_rank[node] = rank;
+		if (graph.out_degree[node] > 0) {
+			gstate.next_contrib[node] = rank / static_cast<double>(graph.out_degree[node]);
+		} else {
+			gstate.next_contrib[node] = 0;
+			dangling += rank;
+		}
+	}
+	return dangling;
+}
+
+void MarkdownReader::MarkdownPageRankFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownPageRankBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownPageRankGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownPageRankLocalState>();
+	output.SetCardinality(0);
+
+	// Phase 1: extract link targets, then wait for the graph
+	if (!lstate.scanned) {
+		lstate.scanned = true;
+		while (true) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			const auto &file_path = bind_data.files[file_index];
+
+			MarkdownFileScanStats file_stats;
+			file_stats.file_path = file_path;
+			try {
+				auto content = ReadMarkdownFile(context, file_path, bind_data.options, &file_stats);
+				Profiler extract_timer;
+				extract_timer.Start();
+				auto &targets = gstate.targets[file_index];
+				for (auto &wikilink : markdown_utils::ExtractWikilinks(content)) {
+					targets.wikilinks.push_back(std::move(wikilink.target));
+				}
+				for (auto &link : markdown_utils::ExtractLinks(content)) {
+					targets.urls.push_back(std::move(link.url));
+				}
+				extract_timer.End();
+				file_stats.parse_seconds = extract_timer.Elapsed();
+			} catch (const std::exception &e) {
+				file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(file_stats));
+				{
+					std::lock_guard<std::mutex> guard(gstate.lock);
+					gstate.failed = true;
+				}
+				gstate.state_changed.notify_all();
+				throw InvalidInputException("Error reading links of file %s: %s", file_path, e.what());
+			}
+			MarkdownScanReport::Record(context, std::move(file_stats));
+
+			std::lock_guard<std::mutex> guard(gstate.lock);
+			gstate.files_done++;
+		}
+
+		std::unique_lock<std::mutex> guard(gstate.lock);
+		if (!gstate.graph_ready && gstate.files_done == bind_data.files.size()) {
+			StartPageRank(bind_data, gstate);
+			gstate.state_changed.notify_all();
+		}
+		gstate.state_changed.wait(guard, [&]() { return gstate.graph_ready || gstate.failed; });
+	}
+
+	// Phase 2: claim blocks of the current iteration until all iterations are done
+	{
+		std::unique_lock<std::mutex> guard(gstate.lock);
+		while (!gstate.failed && gstate.iteration < bind_data.iterations && gstate.block_count > 0) {
+			if (gstate.next_block == gstate.block_count) {
+				auto iteration = gstate.iteration;
+				gstate.state_changed.wait(guard,
+				                          [&]() { return gstate.iteration != iteration || gstate.failed; });
+				continue;
+			}
+			auto block = gstate.next_block++;
+			guard.unlock();
+			auto dangling = PageRankBlock(bind_data, gstate, block);
+			guard.lock();
+
+			gstate.next_dangling += dangling;
+			if (++gstate.blocks_done == gstate.block_count) {
+				std::swap(gstate.rank, gstate.next_rank);
+				std::swap(gstate.contrib, gstate.next_contrib);
+				gstate.dangling = gstate.next_dangling;
+				gstate.next_dangling = 0;
+				gstate.next_block = 0;
+				gstate.blocks_done = 0;
+				gstate.iteration++;
+				gstate.state_changed.notify_all();
+			}
+		}
+		if (gstate.failed) {
+			return;
+		}
+	}
+
+	// Phase 3: emit a chunk of rows
+	auto start = gstate.next_row.fetch_add(STANDARD_VECTOR_SIZE);
+	auto end = MinValue<idx_t>(bind_data.files.size(), start + STANDARD_VECTOR_SIZE);
+	auto &graph = gstate.graph;
+	idx_t output_idx = 0;
+	for (idx_t node = start; node < end; node++) {
+		output.data[0].SetValue(output_idx, Value(bind_data.files[node]));
+		output.data[1].SetValue(output_idx, Value::DOUBLE(gstate.rank[node]));
+		output.data[2].SetValue(
+		    output_idx, Value::BIGINT(static_cast<int64_t>(graph.in_offsets[node + 1] - graph.in_offsets[node])));
+		output.data[3].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(graph.out_degree[node])));
+		output_idx++;
+	}
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterPageRankFunction(ExtensionLoader &loader) {
+	TableFunctionSet pagerank_set("markdown_pagerank");
+
+	// iterations defaults to 20 and damping to 0.85
+	vector<vector<LogicalType>> signatures = {
+	    {LogicalType::VARCHAR},
+	    {LogicalType::VARCHAR, LogicalType::INTEGER},
+	    {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::DOUBLE}};
+
+	for (auto &arguments : signatures) {
+		TableFunction pagerank_func("markdown_pagerank", arguments, MarkdownPageRankFunction, MarkdownPageRankBind,
+		                            MarkdownPageRankInitGlobal, MarkdownPageRankInitLocal);
+		pagerank_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+		pagerank_set.AddFunction(pagerank_func);
+	}
+
+	loader.RegisterFunction(pagerank_set);
+}
+
+} // namespace duckdb
@@ -0,0 +1,210 @@
+#include "markdown_reader.hpp"
+#include "markdown_pandoc.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <atomic>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Pandoc JSON Reader (read_pandoc_json)
+//===--------------------------------------------------------------------===//
+// Loads the JSON AST `pandoc -t json` writes as duck_block rows, the shape of
+// read_markdown_blocks. Files are handed out to threads through an atomic cursor.
+// Each thread reads its file in chunks and converts one top-level block at a
+// time, so a huge AST never has to fit in memory as a whole.
+
+struct MarkdownReadPandocBindData : public TableFunctionData {
+	vector<string> files;
+	bool include_filepath = false;
+	bool inlines = false;
+};
+
+struct MarkdownReadPandocGlobalState : public GlobalTableFunctionState {
+	std::atomic<idx_t> next_file {0};
+	idx_t max_threads = 1;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownReadPandocLocalState : public LocalTableFunctionState {
+	string file_path;
+	//! Set while a file is being read
+	unique_ptr<PandocJsonStream> stream;
+	unique_ptr<PandocConverter> converter;
+	MarkdownFileScanStats file_stats;
+	idx_t block_count = 0;
+	//! Rows of the current top-level block
+	vector<PandocRow> rows;
+	idx_t row_index = 0;
+};
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownReadPandocBind(ClientContext &context, TableFunctionBindInput &input,
+                                                                vector<LogicalType> &return_types,
+                                                                vector<string> &names) {
+	auto result = make_uniq<MarkdownReadPandocBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("read_pandoc_json requires a path");
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "include_filepath" || kv.first == "filename") {
+			result->include_filepath = BooleanValue::Get(kv.second);
+		} else if (kv.first == "inlines") {
+			result->inlines = BooleanValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for read_pandoc_json: %s", kv.first);
+		}
+	}
+
+	result->files = GetFiles(context, input.inputs[0], false, 0, 1, {"*.json"});
+	MarkdownScanReport::BeginScan(context);
+
+	// Same columns as read_markdown_blocks
+	if (result->include_filepath) {
+		names.emplace_back("file_path");
+		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	}
+	names.emplace_back("kind");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("element_type");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("content");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("level");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTEGER));
+	names.emplace_back("encoding");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("attributes");
+	return_types.emplace_back(
+	    LogicalType::MAP(LogicalType(LogicalTypeId::VARCHAR), LogicalType(LogicalTypeId::VARCHAR)));
+	names.emplace_back("element_order");
+	return_types.emplace_back(LogicalType(LogicalTypeId::INTEGER));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownReadPandocInitGlobal(ClientContext &context,
+                                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadPandocBindData>();
+	auto result = make_uniq<MarkdownReadPandocGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownReadPandocInitLocal(ExecutionContext &context,
+                                                                                TableFunctionInitInput &input,
+                                                                                GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownReadPandocLocalState>();
+}
+
+void MarkdownReader::MarkdownReadPandocFunction(ClientContext &context, TableFunctionInput &input,
+                                                DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadPandocBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownReadPandocGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownReadPandocLocalState>();
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (lstate.row_index < lstate.rows.size()) {
+			const auto &row = lstate.rows[lstate.row_index++];
+			idx_t column_idx = 0;
+			if (bind_data.include_filepath) {
+				output.data[column_idx++].SetValue(output_idx, Value(lstate.file_path));
+			}
+			output.data[column_idx++].SetValue(output_idx, Value(row.kind));
+			output.data[column_idx++].SetValue(output_idx, Value(row.element_type));
+			output.data[column_idx++].SetValue(output_idx, Value(row.content));
+			output.data[column_idx++].SetValue(output_idx, Value::INTEGER(row.level));
+			output.data[column_idx++].SetValue(output_idx, Value(row.encoding));
+			vector<Value> attr_keys;
+			vector<Value> attr_values;
+			for (const auto &attr : row.attributes) {
+				attr_keys.push_back(Value(attr.first));
+				attr_values.push_back(Value(attr.second));
+			}
+			output.data[column_idx++].SetValue(output_idx,
+			                                   Value::MAP(LogicalType(LogicalTypeId::VARCHAR),
+			                                              LogicalType(LogicalTypeId::VARCHAR), attr_keys, attr_values));
+			output.data[column_idx].SetValue(output_idx, Value::INTEGER(row.element_order));
+			output_idx++;
+			continue;
+		}
+		lstate.rows.clear();
+		lstate.row_index = 0;
+
+		if (!lstate.stream) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			lstate.file_path = bind_data.files[file_index];
+			lstate.file_stats = MarkdownFileScanStats();
+			lstate.file_stats.file_path = lstate.file_path;
+			lstate.block_count = 0;
+			try {
+				auto &fs = FileSystem::GetFileSystem(context);
+				lstate.stream = make_uniq<PandocJsonStream>(
+				    fs.OpenFile(lstate.file_path, FileOpenFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT));
+			} catch (const std::exception &e) {
+				lstate.file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(lstate.file_stats));
+				throw InvalidInputException("Error reading Pandoc JSON file %s: %s", lstate.file_path, e.what());
+			}
+			lstate.converter = make_uniq<PandocConverter>(bind_data.inlines);
+			continue;
+		}
+
+		// Convert the next top-level piece of the current file
+		Profiler parse_timer;
+		parse_timer.Start();
+		bool more;
+		try {
+			PandocJsonStream::ItemType type;
+			string json;
+			more = lstate.stream->Next(type, json);
+			if (more && type == PandocJsonStream::ItemType::META) {
+				lstate.converter->AddMeta(json, lstate.rows);
+			} else if (more) {
+				lstate.converter->AddBlock(json, lstate.rows);
+				lstate.block_count++;
+			}
+		} catch (const std::exception &e) {
+			lstate.file_stats.file_size = lstate.stream->BytesRead();
+			lstate.file_stats.error = e.what();
+			lstate.stream.reset();
+			MarkdownScanReport::Record(context, std::move(lstate.file_stats));
+			throw InvalidInputException("Error reading Pandoc JSON file %s: %s", lstate.file_path, e.what());
+		}
+		parse_timer.End();
+		lstate.file_stats.parse_seconds += parse_timer.Elapsed();
+		if (!more) {
+			lstate.file_stats.file_size = lstate.stream->BytesRead();
+			lstate.file_stats.block_count = lstate.block_count;
+			lstate.stream.reset();
+			MarkdownScanReport::Record(context, std::move(lstate.file_stats));
+		}
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterPandocFunction(ExtensionLoader &loader) {
+	TableFunction pandoc_func("read_pandoc_json", {LogicalType(LogicalTypeId::VARCHAR)}, MarkdownReadPandocFunction,
+	                          MarkdownReadPandocBind, MarkdownReadPandocInitGlobal, MarkdownReadPandocInitLocal);
+
+	pandoc_func.named_parameters["include_filepath"] = LogicalType(LogicalTypeId::BOOLEAN);
+	pandoc_func.named_parameters["filename"] = LogicalType(LogicalTypeId::BOOLEAN); // Alias for include_filepath
+	pandoc_func.named_parameters["inlines"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	loader.RegisterFunction(pandoc_func);
+}
+
+} // namespace duckdb
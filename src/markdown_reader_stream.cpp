@@ -0,0 +1,260 @@
+#include "markdown_reader.hpp"
+#include "markdown_types.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <mutex>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Stream Reader (read_markdown_stream)
+//===--------------------------------------------------------------------===//
+// Reads one stream (regular file, FIFO, /dev/stdin, compressed file) holding many
+// markdown documents separated by a delimiter. The stream is consumed sequentially
+// in fixed-size blocks under a global lock; documents are split off the front of a
+// bounded buffer and handed to threads in small batches, so parsing (metadata,
+// stats) runs in parallel. Nothing is written to disk and the buffer never holds
+// more than one block plus the document currently being assembled.
+
+// Bytes read from the stream per refill
+static constexpr idx_t MARKDOWN_STREAM_BLOCK_SIZE = 1 << 20;
+// A thread claims at most this many documents (or bytes) per trip to the global lock
+static constexpr idx_t MARKDOWN_STREAM_BATCH_DOCS = 64;
+static constexpr idx_t MARKDOWN_STREAM_BATCH_BYTES = 1 << 20;
+
+struct MarkdownReadStreamBindData : public TableFunctionData {
+	string path;
+	MarkdownReader::MarkdownReadOptions options;
+};
+
+struct MarkdownStreamDocument {
+	idx_t doc_index;
+	string content;
+};
+
+struct MarkdownReadStreamGlobalState : public GlobalTableFunctionState {
+	mutex lock;
+	unique_ptr<FileHandle> handle;
+	// Pending bytes; [buffer_pos, buffer.size()) is not yet split into documents
+	string buffer;
+	idx_t buffer_pos = 0;
+	// Where to resume the separator search (avoids rescanning a partial document)
+	idx_t search_pos = 0;
+	bool eof = false;
+	idx_t next_doc_index = 0;
+	idx_t max_threads = 1;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownReadStreamLocalState : public LocalTableFunctionState {
+	vector<MarkdownStreamDocument> batch;
+	idx_t batch_pos = 0;
+};
+
+// Refill the buffer with the next block of the stream. Caller holds the lock.
+static void RefillStreamBuffer(MarkdownReadStreamGlobalState &gstate) {
+	// Compact: drop the already-split prefix before growing the buffer
+	if (gstate.buffer_pos > 0) {
+		gstate.buffer.erase(0, gstate.buffer_pos);
+		gstate.search_pos -= gstate.buffer_pos;
+		gstate.buffer_pos = 0;
+	}
+	auto old_size = gstate.buffer.size();
+	gstate.buffer.resize(old_size + MARKDOWN_STREAM_BLOCK_SIZE);
+	auto bytes_read = gstate.handle->Read(&gstate.buffer[old_size], MARKDOWN_STREAM_BLOCK_SIZE);
+	gstate.buffer.resize(old_size + static_cast<idx_t>(bytes_read));
+	if (bytes_read == 0) {
+		gstate.eof = true;
+	}
+}
+
+// Split the next batch of documents off the stream. Returns false once the stream is drained.
+static bool ClaimStreamBatch(MarkdownReadStreamGlobalState &gstate, const MarkdownReader::MarkdownReadOptions &options,
+                             vector<MarkdownStreamDocument> &batch) {
+	lock_guard<mutex> guard(gstate.lock);
+	const auto &separator = options.separator;
+	idx_t batch_bytes = 0;
+
+	while (batch.size() < MARKDOWN_STREAM_BATCH_DOCS && batch_bytes < MARKDOWN_STREAM_BATCH_BYTES) {
+		if (gstate.buffer_pos >= gstate.buffer.size() && gstate.eof) {
+			break;
+		}
+
+		auto sep_pos = gstate.buffer.find(separator, gstate.search_pos);
+		idx_t doc_end;
+		idx_t next_pos;
+		if (sep_pos != string::npos) {
+			doc_end = sep_pos;
+			next_pos = sep_pos + separator.size();
+		} else if (gstate.eof) {
+			// Trailing document without a closing separator
+			doc_end = gstate.buffer.size();
+			next_pos = doc_end;
+		} else {
+			// Document still incomplete: keep what we have for this batch rather than block
+			// other threads on I/O, unless there is nothing to hand out yet.
+			if (!batch.empty()) {
+				break;
+			}
+			auto pending = gstate.buffer.size() - gstate.buffer_pos;
+			if (options.maximum_file_size > 0 && pending > options.maximum_file_size + separator.size()) {
+				throw InvalidInputException(
+				    "Document %llu in stream %s is too large (more than %llu bytes, maximum is %llu bytes)",
+				    gstate.next_doc_index, gstate.handle->GetPath(), pending, options.maximum_file_size);
+			}
+			// The separator may straddle the refill boundary, so back up by its length
+			auto overlap = separator.size() - 1;
+			auto size = gstate.buffer.size();
+			gstate.search_pos = MaxValue<idx_t>(gstate.buffer_pos, size > overlap ? size - overlap : 0);
+			RefillStreamBuffer(gstate);
+			continue;
+		}
+
+		auto doc_size = doc_end - gstate.buffer_pos;
+		if (options.maximum_file_size > 0 && doc_size > options.maximum_file_size) {
+			throw InvalidInputException("Document %llu in stream %s is too large (%llu bytes, maximum is %llu bytes)",
+			                            gstate.next_doc_index, gstate.handle->GetPath(), doc_size,
+			                            options.maximum_file_size);
+		}
+		// Empty documents (leading/trailing or doubled separators) produce no row
+		if (doc_size > 0) {
+			MarkdownStreamDocument doc;
+			doc.doc_index = gstate.next_doc_index++;
+			doc.content = gstate.buffer.substr(gstate.buffer_pos, doc_size);
+			batch_bytes += doc_size;
+			batch.push_back(std::move(doc));
+		}
+		gstate.buffer_pos = next_pos;
+		gstate.search_pos = next_pos;
+	}
+	return !batch.empty();
+}
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownReadStreamBind(ClientContext &context, TableFunctionBindInput &input,
+                                                                vector<LogicalType> &return_types,
+                                                                vector<string> &names) {
+	auto result = make_uniq<MarkdownReadStreamBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("read_markdown_stream requires a stream path");
+	}
+	result->path = StringValue::Get(input.inputs[0]);
+
+	ParseMarkdownOptions(input, result->options);
+
+	names.emplace_back("doc_index");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	names.emplace_back("content");
+	if (result->options.content_as_varchar) {
+		return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	} else {
+		return_types.emplace_back(MarkdownTypes::MarkdownType());
+	}
+
+	if (result->options.extract_metadata) {
+		names.emplace_back("metadata");
+		return_types.emplace_back(LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR));
+	}
+
+	if (result->options.include_stats) {
+		names.emplace_back("stats");
+		return_types.emplace_back(markdown_utils::StatsStructType());
+	}
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownReadStreamInitGlobal(ClientContext &context,
+                                                                                  TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadStreamBindData>();
+	auto result = make_uniq<MarkdownReadStreamGlobalState>();
+
+	// Sequential reads only (no GetFileSize/seek), so FIFOs and stdin work
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->handle = fs.OpenFile(bind_data.path, FileOpenFlags::FILE_FLAGS_READ | FileCompressionType::AUTO_DETECT);
+	result->max_threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownReadStreamInitLocal(ExecutionContext &context,
+                                                                                TableFunctionInitInput &input,
+                                                                                GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownReadStreamLocalState>();
+}
+
+void MarkdownReader::MarkdownReadStreamFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownReadStreamBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownReadStreamGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownReadStreamLocalState>();
+	const auto &options = bind_data.options;
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE) {
+		if (lstate.batch_pos >= lstate.batch.size()) {
+			lstate.batch.clear();
+			lstate.batch_pos = 0;
+			if (!ClaimStreamBatch(gstate, options, lstate.batch)) {
+				break;
+			}
+		}
+
+		auto &doc = lstate.batch[lstate.batch_pos];
+		if (options.normalize_content) {
+			markdown_utils::NormalizeMarkdownInPlace(doc.content, options.normalize);
+		}
+
+		idx_t column_idx = 0;
+		output.data[column_idx].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(doc.doc_index)));
+		column_idx++;
+
+		output.data[column_idx].SetValue(output_idx, Value(doc.content));
+		column_idx++;
+
+		if (options.extract_metadata) {
+			auto metadata = markdown_utils::ExtractMetadata(doc.content);
+			output.data[column_idx].SetValue(output_idx, markdown_utils::MetadataToMap(metadata));
+			column_idx++;
+		}
+
+		if (options.include_stats) {
+			auto stats = markdown_utils::CalculateStats(doc.content);
+			output.data[column_idx].SetValue(output_idx, markdown_utils::StatsToStruct(stats));
+			column_idx++;
+		}
+
+		// Release the document as soon as it has been emitted
+		doc.content = string();
+		lstate.batch_pos++;
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterStreamFunction(ExtensionLoader &loader) {
+	TableFunction read_stream_func("read_markdown_stream", {LogicalType(LogicalTypeId::VARCHAR)},
+	                               MarkdownReadStreamFunction, MarkdownReadStreamBind, MarkdownReadStreamInitGlobal,
+	                               MarkdownReadStreamInitLocal);
+
+	read_stream_func.named_parameters["separator"] = LogicalType(LogicalTypeId::VARCHAR);
+	read_stream_func.named_parameters["extract_metadata"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_stream_func.named_parameters["include_stats"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_stream_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_stream_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_stream_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+	read_stream_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
+	read_stream_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+	read_stream_func.named_parameters["content_as_varchar"] = LogicalType(LogicalTypeId::BOOLEAN);
+
+	loader.RegisterFunction(read_stream_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,233 @@
+#include "markdown_reader.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Term Statistics (markdown_term_stats)
+//===--------------------------------------------------------------------===//
+// One row per distinct term of the matching files: its total count (tf) and the
+// number of files containing it (df). Threads claim files through an atomic cursor
+// and count into their own hash maps, so the scan takes no lock per file; each map
+// is merged into the global one once, when the files run out, and the thread whose
+// merge completes the set prunes, sorts and emits the result.
+
+struct TermCounts {
+	idx_t tf = 0;
+	idx_t df = 0;
+};
+
+struct TermRow {
+	string term;
+	TermCounts counts;
+};
+
+struct MarkdownTermStatsBindData : public TableFunctionData {
+	vector<string> files;
+	MarkdownReader::MarkdownReadOptions options;
+	markdown_utils::TermScope scope = markdown_utils::TermScope::TEXT;
+	std::unordered_set<string> stopwords;
+	idx_t min_df = 1;
+};
+
+struct MarkdownTermStatsGlobalState : public GlobalTableFunctionState {
+	std::atomic<idx_t> next_file {0};
+	idx_t max_threads = 1;
+
+	std::mutex lock;
+	std::unordered_map<string, TermCounts> terms;
+	idx_t merged_files = 0;
+	bool emitter_claimed = false;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownTermStatsLocalState : public LocalTableFunctionState {
+	std::unordered_map<string, TermCounts> terms;
+	idx_t files_processed = 0;
+	bool merged = false;
+
+	//! Only set on the thread that emits the final result
+	vector<TermRow> rows;
+	idx_t row_index = 0;
+};
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownTermStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                               vector<LogicalType> &return_types,
+                                                               vector<string> &names) {
+	auto result = make_uniq<MarkdownTermStatsBindData>();
+
+	if (input.inputs.empty() || input.inputs[0].IsNull()) {
+		throw InvalidInputException("markdown_term_stats requires a path");
+	}
+
+	for (const auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			continue;
+		}
+		if (kv.first == "scope") {
+			result->scope = markdown_utils::ParseTermScope(kv.second.ToString());
+		} else if (kv.first == "stopwords") {
+			for (auto &word : ListValue::GetChildren(kv.second)) {
+				if (!word.IsNull()) {
+					result->stopwords.insert(StringUtil::Lower(word.ToString()));
+				}
+			}
+		} else if (kv.first == "min_df") {
+			auto min_df = BigIntValue::Get(kv.second);
+			if (min_df < 1) {
+				throw InvalidInputException("min_df must be at least 1");
+			}
+			result->min_df = static_cast<idx_t>(min_df);
+		} else if (kv.first == "maximum_file_size") {
+			result->options.maximum_file_size = UBigIntValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for markdown_term_stats: %s", kv.first);
+		}
+	}
+
+	result->files = GetFiles(context, input.inputs[0], false);
+	MarkdownScanReport::BeginScan(context);
+
+	names.emplace_back("term");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	names.emplace_back("tf");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	names.emplace_back("df");
+	return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownTermStatsInitGlobal(ClientContext &context,
+                                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownTermStatsBindData>();
+	auto result = make_uniq<MarkdownTermStatsGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownTermStatsInitLocal(ExecutionContext &context,
+                                                                               TableFunctionInitInput &input,
+                                                                               GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownTermStatsLocalState>();
+}
+
+// Merge a thread's counts into the global map. When this merge completes the set of files,
+// fills the thread's rows with the pruned, sorted result and returns true.
+static bool MergeTermCounts(const MarkdownTermStatsBindData &bind_data, MarkdownTermStatsGlobalState &gstate,
+                            MarkdownTermStatsLocalState &lstate) {
+	std::lock_guard<std::mutex> guard(gstate.lock);
+	if (gstate.terms.empty()) {
+		gstate.terms = std::move(lstate.terms);
+	} else {
+		for (auto &entry : lstate.terms) {
+			auto &counts = gstate.terms[entry.first];
+			counts.tf += entry.second.tf;
+			counts.df += entry.second.df;
+		}
+	}
+	lstate.terms.clear();
+	gstate.merged_files += lstate.files_processed;
+	if (gstate.merged_files < bind_data.files.size() || gstate.emitter_claimed) {
+		return false;
+	}
+	gstate.emitter_claimed = true;
+
+	lstate.rows.reserve(gstate.terms.size());
+	for (auto &entry : gstate.terms) {
+		if (entry.second.df < bind_data.min_df || bind_data.stopwords.count(entry.first)) {
+			continue;
+		}
+		lstate.rows.push_back(TermRow {entry.first, entry.second});
+	}
+	gstate.terms.clear();
+	std::sort(lstate.rows.begin(), lstate.rows.end(), [](const TermRow &a, const TermRow &b) {
+		if (a.counts.df != b.counts.df) {
+			return a.counts.df > b.counts.df;
+		}
+		if (a.counts.tf != b.counts.tf) {
+			return a.counts.tf > b.counts.tf;
+		}
+		return a.term < b.term;
+	});
+	return true;
+}
+
+void MarkdownReader::MarkdownTermStatsFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownTermStatsBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownTermStatsGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownTermStatsLocalState>();
+
+	if (!lstate.merged) {
+		std::unordered_map<std::string, idx_t> file_terms;
+		while (true) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			const auto &file_path = bind_data.files[file_index];
+
+			MarkdownFileScanStats file_stats;
+			file_stats.file_path = file_path;
+			try {
+				auto content = ReadMarkdownFile(context, file_path, bind_data.options, &file_stats);
+				Profiler count_timer;
+				count_timer.Start();
+				file_terms.clear();
+				markdown_utils::CountTerms(content, bind_data.scope, file_terms);
+				for (auto &entry : file_terms) {
+					auto &counts = lstate.terms[entry.first];
+					counts.tf += entry.second;
+					counts.df++;
+				}
+				count_timer.End();
+				file_stats.parse_seconds = count_timer.Elapsed();
+			} catch (const std::exception &e) {
+				file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(file_stats));
+				throw InvalidInputException("Error counting terms in file %s: %s", file_path, e.what());
+			}
+			MarkdownScanReport::Record(context, std::move(file_stats));
+			lstate.files_processed++;
+		}
+		MergeTermCounts(bind_data, gstate, lstate);
+		lstate.merged = true;
+	}
+
+	idx_t output_idx = 0;
+	while (output_idx < STANDARD_VECTOR_SIZE && lstate.row_index < lstate.rows.size()) {
+		const auto &row = lstate.rows[lstate.row_index++];
+		output.data[0].SetValue(output_idx, Value(row.term));
+		output.data[1].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(row.counts.tf)));
+		output.data[2].SetValue(output_idx, Value::BIGINT(static_cast<int64_t>(row.counts.df)));
+		output_idx++;
+	}
+
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownReader::RegisterTermStatsFunction(ExtensionLoader &loader) {
+	TableFunction terms_func("markdown_term_stats", {LogicalType(LogicalTypeId::VARCHAR)}, MarkdownTermStatsFunction,
+	                         MarkdownTermStatsBind, MarkdownTermStatsInitGlobal, MarkdownTermStatsInitLocal);
+
+	terms_func.named_parameters["scope"] = LogicalType(LogicalTypeId::VARCHAR);
+	terms_func.named_parameters["stopwords"] = LogicalType::LIST(LogicalType(LogicalTypeId::VARCHAR));
+	terms_func.named_parameters["min_df"] = LogicalType(LogicalTypeId::BIGINT);
+	terms_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+
+	loader.RegisterFunction(terms_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,303 @@
+#include "markdown_reader.hpp"
+#include "markdown_trigram_index.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Trigram Index Build (markdown_build_trigram_index)
+//===--------------------------------------------------------------------===//
+// Indexes every matching file on all threads and writes the index once the last
+// thread is done, returning one summary row. An existing index at the same path
+// is maintained incrementally: files whose modification time and size match it
+// keep their postings without being read, changed and new files are re-indexed,
+// and files that no longer match the path drop out.
+
+struct MarkdownTrigramBuildBindData : public TableFunctionData {
+	vector<string> files;
+	MarkdownReader::MarkdownReadOptions options;
+	string index_file;
+	uint64_t options_signature = 0;
+};
+
+// One per input file, filled in by the thread that claims the file
+struct TrigramFileSlot {
+	MarkdownTrigramIndex::IndexedFile file;
+	//! Position of the file in the previous index when its postings are reused
+	idx_t reused_from = DConstants::INVALID_INDEX;
+	//! Trigrams of each segment (document first) of a re-indexed file
+	vector<vector<uint32_t>> segment_trigrams;
+};
+
+struct MarkdownTrigramBuildGlobalState : public GlobalTableFunctionState {
+	std::atomic<idx_t> next_file {0};
+	idx_t max_threads = 1;
+
+	unique_ptr<MarkdownTrigramIndex> previous;
+	//! Path -> position in previous, for files built with the same options
+	unordered_map<string, idx_t> reusable;
+	vector<TrigramFileSlot> slots;
+
+	std::mutex lock;
+	idx_t finished_files = 0;
+	bool writer_claimed = false;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct MarkdownTrigramBuildLocalState : public LocalTableFunctionState {
+	idx_t files_processed = 0;
+	bool finished = false;
+
+	//! Only set on the thread that writes the index
+	vector<Value> summary;
+};
+
+unique_ptr<FunctionData> MarkdownReader::MarkdownTrigramBuildBind(ClientContext &context,
+                                                                  TableFunctionBindInput &input,
+                                                                  vector<LogicalType> &return_types,
+                                                                  vector<string> &names) {
+	auto result = make_uniq<MarkdownTrigramBuildBindData>();
+
+	if (input.inputs.size() < 2 || input.inputs[0].IsNull() || input.inputs[1].IsNull()) {
+		throw InvalidInputException("markdown_build_trigram_index requires a path and an index file");
+	}
+	result->index_file = StringValue::Get(input.inputs[1]);
+	if (result->index_file.empty()) {
+		throw InvalidInputException("markdown_build_trigram_index requires a non-empty index file");
+	}
+
+	auto &options = result->options;
+	for (const auto &kv : input.named_parameters) {
+		if (kv.first == "normalize_content") {
+			options.normalize_content = BooleanValue::Get(kv.second);
+		} else if (kv.first == "trim_trailing_whitespace") {
+			options.normalize.trim_trailing_whitespace = BooleanValue::Get(kv.second);
+		} else if (kv.first == "expand_tabs") {
+			auto tab_width = IntegerValue::Get(kv.second);
+			if (tab_width < 0) {
+				throw InvalidInputException("expand_tabs must be non-negative (0 disables tab expansion)");
+			}
+			options.normalize.expand_tabs = static_cast<idx_t>(tab_width);
+		} else if (kv.first == "unicode_nfc") {
+			options.normalize.unicode_nfc = BooleanValue::Get(kv.second);
+		} else if (kv.first == "maximum_file_size") {
+			options.maximum_file_size = UBigIntValue::Get(kv.second);
+		} else {
+			throw InvalidInputException("Unknown parameter for markdown_build_trigram_index: %s", kv.first);
+		}
+	}
+	result->options_signature =
+	    MarkdownTrigramIndex::OptionsSignature(options.normalize_content, options.normalize.trim_trailing_whitespace,
+	                                           options.normalize.expand_tabs, options.normalize.unicode_nfc);
+
+	result->files = GetFiles(context, input.inputs[0], false);
+	if (result->files.size() > NumericLimits<uint32_t>::Maximum()) {
+		throw InvalidInputException("markdown_build_trigram_index supports at most %llu files",
+		                            NumericLimits<uint32_t>::Maximum());
+	}
+	MarkdownScanReport::BeginScan(context);
+
+	names.emplace_back("index_file");
+	return_types.emplace_back(LogicalType(LogicalTypeId::VARCHAR));
+	for (auto name : {"files", "files_indexed", "files_reused", "files_removed", "trigrams", "postings"}) {
+		names.emplace_back(name);
+		return_types.emplace_back(LogicalType(LogicalTypeId::BIGINT));
+	}
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> MarkdownReader::MarkdownTrigramBuildInitGlobal(ClientContext &context,
+                                                                                    TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<MarkdownTrigramBuildBindData>();
+	auto result = make_uniq<MarkdownTrigramBuildGlobalState>();
+	auto threads = MaxValue<idx_t>(1, TaskScheduler::GetScheduler(context).NumberOfThreads());
+	result->max_threads = MaxValue<idx_t>(1, MinValue<idx_t>(threads, bind_data.files.size()));
+	result->slots.resize(bind_data.files.size());
+
+	if (FileSystem::GetFileSystem(context).FileExists(bind_data.index_file)) {
+		result->previous = MarkdownTrigramIndex::Load(context, bind_data.index_file);
+		if (result->previous->options_signature == bind_data.options_signature) {
+			for (idx_t i = 0; i < result->previous->files.size(); i++) {
+				result->reusable[result->previous->files[i].path] = i;
+			}
+		}
+	}
+	return std::move(result);
+}
+
+unique_ptr<LocalTableFunctionState> MarkdownReader::MarkdownTrigramBuildInitLocal(
+    ExecutionContext &context, TableFunctionInitInput &input, GlobalTableFunctionState *global_state) {
+	return make_uniq<MarkdownTrigramBuildLocalState>();
+}
+
+// Record a file's version in its slot, and point the slot at the file's entry in the
+// previous index if the file is unchanged since. Returns false if the file must be read.
+static bool ReuseTrigramEntry(ClientContext &context, MarkdownTrigramBuildGlobalState &gstate,
+                              const string &file_path, TrigramFileSlot &slot) {
+	auto &file = slot.file;
+	file.path = file_path;
+	// Taken before the content is read, so a concurrent edit leaves the entry stale rather than wrong
+	MarkdownTrigramIndex::FileVersion(context, file_path, file.modified, file.size);
+
+	auto reusable = gstate.reusable.find(file_path);
+	if (reusable == gstate.reusable.end()) {
+		return false;
+	}
+	auto &previous = gstate.previous->files[reusable->second];
+	if (previous.modified != file.modified || previous.size != file.size) {
+		return false;
+	}
+	slot.reused_from = reusable->second;
+	file.section_lines = previous.section_lines;
+	return true;
+}
+
+// Assemble the slots into the new index and write it; called once, under the lock
+static vector<Value> WriteTrigramIndex(ClientContext &context, const MarkdownTrigramBuildBindData &bind_data,
+                                       MarkdownTrigramBuildGlobalState &gstate) {
+	MarkdownTrigramIndex index;
+	index.options_signature = bind_data.options_signature;
+	auto previous_count = gstate.previous ? gstate.previous->files.size() : 0;
+	vector<idx_t> reused_as(previous_count, DConstants::INVALID_INDEX);
+	idx_t files_reused = 0;
+
+	for (idx_t file_id = 0; file_id < gstate.slots.size(); file_id++) {
+		auto &slot = gstate.slots[file_id];
+		if (slot.reused_from != DConstants::INVALID_INDEX) {
+			reused_as[slot.reused_from] = file_id;
+			files_reused++;
+		}
+		for (idx_t segment = 0; segment < slot.segment_trigrams.size(); segment++) {
+			for (auto trigram : slot.segment_trigrams[segment]) {
+				index.postings.push_back({trigram, static_cast<uint32_t>(file_id), static_cast<uint32_t>(segment)});
+			}
+		}
+		slot.segment_trigrams.clear();
+		index.files.push_back(std::move(slot.file));
+	}
+	idx_t files_removed = 0;
+	if (gstate.previous) {
+		for (auto &posting : gstate.previous->postings) {
+			auto file_id = reused_as[posting.file];
+			if (file_id != DConstants::INVALID_INDEX) {
+				index.postings.push_back({posting.trigram, static_cast<uint32_t>(file_id), posting.segment});
+			}
+		}
+		std::unordered_set<string> paths(bind_data.files.begin(), bind_data.files.end());
+		for (auto &file : gstate.previous->files) {
+			files_removed += paths.count(file.path) ? 0 : 1;
+		}
+		gstate.previous.reset();
+	}
+	gstate.slots.clear();
+	std::sort(index.postings.begin(), index.postings.end());
+	index.Write(context, bind_data.index_file);
+
+	auto file_count = index.files.size();
+	return {Value(bind_data.index_file),
+	        Value::BIGINT(static_cast<int64_t>(file_count)),
+	        Value::BIGINT(static_cast<int64_t>(file_count - files_reused)),
+	        Value::BIGINT(static_cast<int64_t>(files_reused)),
+	        Value::BIGINT(static_cast<int64_t>(files_removed)),
+	        Value::BIGINT(static_cast<int64_t>(index.TrigramCount())),
+	        Value::BIGINT(static_cast<int64_t>(index.postings.size()))};
+}
+
+void MarkdownReader::MarkdownTrigramBuildFunction(ClientContext &context, TableFunctionInput &input,
+                                                  DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownTrigramBuildBindData>();
+	auto &gstate = input.global_state->Cast<MarkdownTrigramBuildGlobalState>();
+	auto &lstate = input.local_state->Cast<MarkdownTrigramBuildLocalState>();
+
+	if (!lstate.finished) {
+		while (true) {
+			auto file_index = gstate.next_file.fetch_add(1);
+			if (file_index >= bind_data.files.size()) {
+				break;
+			}
+			const auto &file_path = bind_data.files[file_index];
+			auto &slot = gstate.slots[file_index];
+			lstate.files_processed++;
+
+			MarkdownFileScanStats file_stats;
+			file_stats.file_path = file_path;
+			try {
+				if (ReuseTrigramEntry(context, gstate, file_path, slot)) {
+					continue;
+				}
+				auto content = ReadMarkdownFile(context, file_path, bind_data.options, &file_stats);
+				Profiler index_timer;
+				index_timer.Start();
+				slot.segment_trigrams.emplace_back();
+				MarkdownTrigramIndex::ExtractTrigrams(content, slot.segment_trigrams.back());
+
+				// Sections as read_markdown_sections returns them with its default options
+				markdown_utils::MarkdownSection frontmatter;
+				if (ExtractFrontmatterSection(content, frontmatter)) {
+					slot.file.section_lines.push_back(0);
+					slot.segment_trigrams.emplace_back();
+					MarkdownTrigramIndex::ExtractTrigrams(frontmatter.content, slot.segment_trigrams.back());
+				}
+				for (auto &section : ProcessSections(content, bind_data.options)) {
+					slot.file.section_lines.push_back(section.start_line);
+					slot.segment_trigrams.emplace_back();
+					MarkdownTrigramIndex::ExtractTrigrams(section.content, slot.segment_trigrams.back());
+				}
+				index_timer.End();
+				file_stats.parse_seconds = index_timer.Elapsed();
+				file_stats.section_count = slot.file.section_lines.size();
+			} catch (const std::exception &e) {
+				file_stats.error = e.what();
+				MarkdownScanReport::Record(context, std::move(file_stats));
+				throw InvalidInputException("Error indexing file %s: %s", file_path, e.what());
+			}
+			MarkdownScanReport::Record(context, std::move(file_stats));
+		}
+		lstate.finished = true;
+
+		std::lock_guard<std::mutex> guard(gstate.lock);
+		gstate.finished_files += lstate.files_processed;
+		if (gstate.finished_files == bind_data.files.size() && !gstate.writer_claimed) {
+			gstate.writer_claimed = true;
+			lstate.summary = WriteTrigramIndex(context, bind_data, gstate);
+		}
+	}
+
+	if (lstate.summary.empty()) {
+		output.SetCardinality(0);
+		return;
+	}
+	for (idx_t col = 0; col < lstate.summary.size(); col++) {
+		output.data[col].SetValue(0, lstate.summary[col]);
+	}
+	lstate.summary.clear();
+	output.SetCardinality(1);
+}
+
+void MarkdownReader::RegisterTrigramIndexFunction(ExtensionLoader &loader) {
+	TableFunction build_func("markdown_build_trigram_index",
+	                         {LogicalType(LogicalTypeId::VARCHAR), LogicalType(LogicalTypeId::VARCHAR)},
+	                         MarkdownTrigramBuildFunction, MarkdownTrigramBuildBind, MarkdownTrigramBuildInitGlobal,
+	                         MarkdownTrigramBuildInitLocal);
+
+	build_func.named_parameters["normalize_content"] = LogicalType(LogicalTypeId::BOOLEAN);
+	build_func.named_parameters["trim_trailing_whitespace"] = LogicalType(LogicalTypeId::BOOLEAN);
+	build_func.named_parameters["expand_tabs"] = LogicalType(LogicalTypeId::INTEGER);
+	build_func.named_parameters["unicode_nfc"] = LogicalType(LogicalTypeId::BOOLEAN);
+	build_func.named_parameters["maximum_file_size"] = LogicalType(LogicalTypeId::UBIGINT);
+
+	loader.RegisterFunction(build_func);
+}
+
+} // namespace duckdb
@@ -2,7 +2,11 @@
 #include "duckdb/main/client_context.hpp"
 #include "markdown_types.hpp"
 #include "markdown_utils.hpp"
+#include "markdown_memo_cache.hpp"
+#include "markdown_template.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/function_set.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 
 namespace duckdb {
@@ -40,6 +44,37 @@ void MarkdownFunctions::RegisterValidationFunction(ExtensionLoader &loader) {
 	                            });
 
 	loader.RegisterFunction(md_valid_fun);
+
+	// md_lint function - structural lint issues, all rules or the listed ones
+	ScalarFunctionSet md_lint_set("md_lint");
+	auto lint_list_type = LogicalType::LIST(markdown_utils::LintIssueStructType());
+	auto md_lint = [](DataChunk &args, ExpressionState &state, Vector &result) {
+		for (idx_t i = 0; i < args.size(); i++) {
+			auto md_value = args.data[0].GetValue(i);
+			if (md_value.IsNull()) {
+				result.SetValue(i, Value(result.GetType()));
+				continue;
+			}
+			uint32_t rules = markdown_utils::LINT_ALL_RULES;
+			if (args.ColumnCount() > 1) {
+				auto rules_value = args.data[1].GetValue(i);
+				if (!rules_value.IsNull()) {
+					vector<std::string> names;
+					for (auto &name : ListValue::GetChildren(rules_value)) {
+						names.push_back(name.ToString());
+					}
+					rules = markdown_utils::ParseLintRules(names);
+				}
+			}
+			auto issues = markdown_utils::LintMarkdown(StringValue::Get(md_value), rules);
+			result.SetValue(i, markdown_utils::LintIssuesToList(issues));
+		}
+	};
+	md_lint_set.AddFunction(ScalarFunction({LogicalType::VARCHAR}, lint_list_type, md_lint));
+	md_lint_set.AddFunction(
+	    ScalarFunction({LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR)}, lint_list_type, md_lint));
+
+	loader.RegisterFunction(md_lint_set);
 }
 
 void MarkdownFunctions::RegisterConversionFunctions(ExtensionLoader &loader) {
@@ -49,14 +84,24 @@ void MarkdownFunctions::RegisterConversionFunctions(ExtensionLoader &loader) {
 	ScalarFunction md_to_html_fun(
 	    "md_to_html", {markdown_type}, LogicalType::VARCHAR,
 	    [](DataChunk &args, ExpressionState &state, Vector &result) {
+		    auto memo = MarkdownMemoCache::Get(state.GetContext());
 		    UnaryExecutor::Execute<string_t, string_t>(
 		        args.data[0], result, args.size(), [&](string_t md_str) -> string_t {
 			        if (md_str.GetSize() == 0) {
 				        return string_t();
 			        }
 
+			        MarkdownMemoCache::Key memo_key;
+			        Value cached;
+			        if (memo && memo->Lookup(MarkdownMemoFunction::TO_HTML, md_str, memo_key, cached)) {
+				        return StringVector::AddString(result, StringValue::Get(cached));
+			        }
+
 			        try {
 				        const std::string html_str = markdown_utils::MarkdownToHTML(md_str.GetString());
+				        if (memo) {
+					        memo->Store(memo_key, md_str, Value(html_str));
+				        }
 				        return StringVector::AddString(result, html_str.c_str(), html_str.length());
 			        } catch (const std::exception &e) {
 				        throw InvalidInputException("Error converting Markdown to HTML: %s", e.what());
@@ -83,8 +128,80 @@ void MarkdownFunctions::RegisterConversionFunctions(ExtensionLoader &loader) {
 		        });
 	    });
 
+	// md_to_ast_json function - mdast for JavaScript consumers, parsed once in DuckDB
+	ScalarFunction md_to_ast_json_fun(
+	    "md_to_ast_json", {markdown_type}, LogicalType::JSON(),
+	    [](DataChunk &args, ExpressionState &state, Vector &result) {
+		    UnaryExecutor::Execute<string_t, string_t>(
+		        args.data[0], result, args.size(), [&](string_t md_str) -> string_t {
+			        try {
+				        const std::string json = markdown_utils::MarkdownToMdast(md_str.GetData(), md_str.GetSize());
+				        return StringVector::AddString(result, json.c_str(), json.length());
+			        } catch (const std::exception &e) {
+				        throw InvalidInputException("Error converting Markdown to mdast: %s", e.what());
+			        }
+		        });
+	    });
+
 	loader.RegisterFunction(md_to_html_fun);
 	loader.RegisterFunction(md_to_text_fun);
+	loader.RegisterFunction(md_to_ast_json_fun);
+}
+
+//===--------------------------------------------------------------------===//
+// Template rendering (md_render)
+//===--------------------------------------------------------------------===//
+// The template must be a constant: it is compiled once at bind time against the
+// row's STRUCT type, and the row is cast so every leaf arrives as VARCHAR.
+
+struct MarkdownRenderBindData : public FunctionData {
+	string source;
+	LogicalType row_type;
+	//! Null when the template is NULL
+	shared_ptr<MarkdownTemplate> compiled;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<MarkdownRenderBindData>(*this);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<MarkdownRenderBindData>();
+		return source == other.source && row_type == other.row_type && !compiled == !other.compiled;
+	}
+};
+
+static unique_ptr<FunctionData> MarkdownRenderBind(ClientContext &context, ScalarFunction &bound_function,
+                                                   vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[0]->IsFoldable()) {
+		throw InvalidInputException("md_render requires a constant template");
+	}
+	auto &row_type = arguments[1]->return_type;
+	if (row_type.id() != LogicalTypeId::STRUCT) {
+		throw InvalidInputException("md_render requires a STRUCT row, e.g. md_render(template, t) or "
+		                            "md_render(template, {'name': name})");
+	}
+
+	auto result = make_uniq<MarkdownRenderBindData>();
+	result->row_type = row_type;
+	auto source = ExpressionExecutor::EvaluateScalar(context, *arguments[0]);
+	if (!source.IsNull()) {
+		result->source = StringValue::Get(source.DefaultCastAs(LogicalType::VARCHAR));
+		result->compiled = make_shared_ptr<MarkdownTemplate>(result->source, row_type);
+		bound_function.arguments[1] = result->compiled->RenderType();
+	} else {
+		bound_function.arguments[1] = row_type;
+	}
+	return std::move(result);
+}
+
+static void MarkdownRenderFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<MarkdownRenderBindData>();
+	if (!bind_data.compiled) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	bind_data.compiled->Render(args.data[1], args.size(), result);
 }
 
 void MarkdownFunctions::RegisterMarkdownTypeFunctions(ExtensionLoader &loader) {
@@ -118,26 +235,188 @@ void MarkdownFunctions::RegisterMarkdownTypeFunctions(ExtensionLoader &loader) {
 	                               });
 
 	loader.RegisterFunction(value_to_md_fun);
+
+	// md_render function (a template filled from a STRUCT row); compiled once in MarkdownRenderBind
+	ScalarFunction md_render_fun("md_render", {LogicalType::VARCHAR, LogicalType::ANY}, markdown_type,
+	                             MarkdownRenderFunction, MarkdownRenderBind);
+	loader.RegisterFunction(md_render_fun);
+}
+
+//===--------------------------------------------------------------------===//
+// Section lookup (md_extract_section, md_section_breadcrumb)
+//===--------------------------------------------------------------------===//
+// The section id (and include_subsections) are nearly always literals, so they
+// are folded at bind time and the kernel is chosen once: the constant kernels
+// only walk the markdown column, the varying ones read every argument per row.
+
+struct SectionLookupBindData : public FunctionData {
+	bool section_id_constant = false;
+	bool section_id_null = false;
+	string section_id;
+	bool include_subsections_constant = true;
+	bool include_subsections = false;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<SectionLookupBindData>(*this);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SectionLookupBindData>();
+		return section_id_constant == other.section_id_constant && section_id_null == other.section_id_null &&
+		       section_id == other.section_id && include_subsections_constant == other.include_subsections_constant &&
+		       include_subsections == other.include_subsections;
+	}
+};
+
+static unique_ptr<SectionLookupBindData> BindSectionLookup(ClientContext &context,
+                                                           vector<unique_ptr<Expression>> &arguments) {
+	auto result = make_uniq<SectionLookupBindData>();
+	if (arguments[1]->IsFoldable()) {
+		auto section_id = ExpressionExecutor::EvaluateScalar(context, *arguments[1]);
+		result->section_id_constant = true;
+		result->section_id_null = section_id.IsNull();
+		if (!section_id.IsNull()) {
+			result->section_id = StringValue::Get(section_id.DefaultCastAs(LogicalType::VARCHAR));
+		}
+	}
+	if (arguments.size() > 2) {
+		result->include_subsections_constant = arguments[2]->IsFoldable();
+		if (result->include_subsections_constant) {
+			auto include = ExpressionExecutor::EvaluateScalar(context, *arguments[2]);
+			result->include_subsections = include.IsNull() ? false : BooleanValue::Get(include);
+		}
+	}
+	return result;
+}
+
+static string_t ExtractSectionOrEmpty(Vector &result, const string_t &markdown_str, const string &section_id,
+                                      bool include_subsections) {
+	if (markdown_str.GetSize() == 0 || section_id.empty()) {
+		return string_t();
+	}
+	try {
+		const std::string section_content =
+		    markdown_utils::ExtractSection(markdown_str.GetString(), section_id, include_subsections);
+		return StringVector::AddString(result, section_content);
+	} catch (const std::exception &e) {
+		return string_t();
+	}
+}
+
+// md_extract_section(md, <constant id>, <constant include_subsections>)
+static void ExtractSectionConstantFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<SectionLookupBindData>();
+	if (bind_data.section_id_null) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	UnaryExecutor::Execute<string_t, string_t>(args.data[0], result, args.size(), [&](string_t markdown_str) {
+		return ExtractSectionOrEmpty(result, markdown_str, bind_data.section_id, bind_data.include_subsections);
+	});
+}
+
+// md_extract_section(md, id, include_subsections) with at least one varying option
+static void ExtractSectionVaryingFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<SectionLookupBindData>();
+	auto count = args.size();
+
+	UnifiedVectorFormat markdown_data;
+	UnifiedVectorFormat section_id_data;
+	UnifiedVectorFormat include_data;
+	args.data[0].ToUnifiedFormat(count, markdown_data);
+	args.data[1].ToUnifiedFormat(count, section_id_data);
+	if (!bind_data.include_subsections_constant) {
+		args.data[2].ToUnifiedFormat(count, include_data);
+	}
+	auto markdown_strs = UnifiedVectorFormat::GetData<string_t>(markdown_data);
+	auto section_ids = UnifiedVectorFormat::GetData<string_t>(section_id_data);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	for (idx_t i = 0; i < count; i++) {
+		auto md_idx = markdown_data.sel->get_index(i);
+		auto id_idx = section_id_data.sel->get_index(i);
+		if (!markdown_data.validity.RowIsValid(md_idx) || !section_id_data.validity.RowIsValid(id_idx)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		string varying_id;
+		const string *section_id = &bind_data.section_id;
+		if (!bind_data.section_id_constant) {
+			varying_id = section_ids[id_idx].GetString();
+			section_id = &varying_id;
+		}
+		bool include_subsections = bind_data.include_subsections;
+		if (!bind_data.include_subsections_constant) {
+			auto include_idx = include_data.sel->get_index(i);
+			include_subsections = include_data.validity.RowIsValid(include_idx) &&
+			                      UnifiedVectorFormat::GetData<bool>(include_data)[include_idx];
+		}
+		result_data[i] = ExtractSectionOrEmpty(result, markdown_strs[md_idx], *section_id, include_subsections);
+	}
+	if (count == 1 && args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+static unique_ptr<FunctionData> ExtractSectionBind(ClientContext &context, ScalarFunction &bound_function,
+                                                   vector<unique_ptr<Expression>> &arguments) {
+	auto result = BindSectionLookup(context, arguments);
+	if (result->section_id_constant && result->include_subsections_constant) {
+		bound_function.function = ExtractSectionConstantFunction;
+	} else {
+		bound_function.function = ExtractSectionVaryingFunction;
+	}
+	return std::move(result);
+}
+
+static string_t BreadcrumbOrEmpty(Vector &result, const string_t &markdown_str, const string &section_id) {
+	if (markdown_str.GetSize() == 0 || section_id.empty()) {
+		return string_t();
+	}
+	const std::string breadcrumb = markdown_utils::GenerateBreadcrumb(markdown_str.GetString(), section_id);
+	return StringVector::AddString(result, breadcrumb);
+}
+
+// md_section_breadcrumb(md, <constant id>)
+static void BreadcrumbConstantFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &bind_data = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<SectionLookupBindData>();
+	if (bind_data.section_id_null) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+	UnaryExecutor::Execute<string_t, string_t>(args.data[0], result, args.size(), [&](string_t markdown_str) {
+		return BreadcrumbOrEmpty(result, markdown_str, bind_data.section_id);
+	});
+}
+
+static void BreadcrumbVaryingFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	BinaryExecutor::Execute<string_t, string_t, string_t>(
+	    args.data[0], args.data[1], result, args.size(), [&](string_t markdown_str, string_t section_id_str) {
+		    return BreadcrumbOrEmpty(result, markdown_str, section_id_str.GetString());
+	    });
+}
+
+static unique_ptr<FunctionData> BreadcrumbBind(ClientContext &context, ScalarFunction &bound_function,
+                                               vector<unique_ptr<Expression>> &arguments) {
+	auto result = BindSectionLookup(context, arguments);
+	bound_function.function = result->section_id_constant ? BreadcrumbConstantFunction : BreadcrumbVaryingFunction;
+	return std::move(result);
 }
 
 void MarkdownFunctions::RegisterStatsFunctions(ExtensionLoader &loader) {
 	auto markdown_type = MarkdownTypes::MarkdownType();
 
 	// md_stats function - returns a struct with document statistics
-	child_list_t<LogicalType> stats_struct_types;
-	stats_struct_types.push_back(std::make_pair("word_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("char_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("line_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("heading_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("code_block_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("link_count", LogicalType::BIGINT));
-	stats_struct_types.push_back(std::make_pair("reading_time_minutes", LogicalType::DOUBLE));
-
-	auto stats_struct_type = LogicalType::STRUCT(stats_struct_types);
-
 	ScalarFunction md_stats_fun(
-	    "md_stats", {markdown_type}, stats_struct_type, [](DataChunk &args, ExpressionState &state, Vector &result) {
+	    "md_stats", {markdown_type}, markdown_utils::StatsStructType(),
+	    [](DataChunk &args, ExpressionState &state, Vector &result) {
 		    auto &markdown_vector = args.data[0];
+		    auto memo = MarkdownMemoCache::Get(state.GetContext());
 
 		    for (idx_t row_idx = 0; row_idx < args.size(); row_idx++) {
 			    try {
@@ -152,46 +431,27 @@ void MarkdownFunctions::RegisterStatsFunctions(ExtensionLoader &loader) {
 
 				    if (md_str.empty()) {
 					    // Return empty stats struct
-					    child_list_t<Value> struct_values;
-					    struct_values.push_back(std::make_pair("word_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("char_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("line_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("heading_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("code_block_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("link_count", Value::BIGINT(0)));
-					    struct_values.push_back(std::make_pair("reading_time_minutes", Value::DOUBLE(0.0)));
-
-					    result.SetValue(row_idx, Value::STRUCT(struct_values));
+					    result.SetValue(row_idx, markdown_utils::StatsToStruct(markdown_utils::MarkdownStats {}));
 					    continue;
 				    }
 
-				    auto stats = markdown_utils::CalculateStats(md_str);
-
-				    // Create struct value
-				    child_list_t<Value> struct_values;
-				    struct_values.push_back(std::make_pair("word_count", Value::BIGINT(stats.word_count)));
-				    struct_values.push_back(std::make_pair("char_count", Value::BIGINT(stats.char_count)));
-				    struct_values.push_back(std::make_pair("line_count", Value::BIGINT(stats.line_count)));
-				    struct_values.push_back(std::make_pair("heading_count", Value::BIGINT(stats.heading_count)));
-				    struct_values.push_back(std::make_pair("code_block_count", Value::BIGINT(stats.code_block_count)));
-				    struct_values.push_back(std::make_pair("link_count", Value::BIGINT(stats.link_count)));
-				    struct_values.push_back(
-				        std::make_pair("reading_time_minutes", Value::DOUBLE(stats.reading_time_minutes)));
+				    string_t md_key(md_str);
+				    MarkdownMemoCache::Key memo_key;
+				    Value stats_value;
+				    if (memo && memo->Lookup(MarkdownMemoFunction::STATS, md_key, memo_key, stats_value)) {
+					    result.SetValue(row_idx, stats_value);
+					    continue;
+				    }
 
-				    result.SetValue(row_idx, Value::STRUCT(struct_values));
+				    stats_value = markdown_utils::StatsToStruct(markdown_utils::CalculateStats(md_str));
+				    if (memo) {
+					    memo->Store(memo_key, md_key, stats_value);
+				    }
+				    result.SetValue(row_idx, stats_value);
 
 			    } catch (const std::exception &e) {
 				    // Return empty stats on error
-				    child_list_t<Value> struct_values;
-				    struct_values.push_back(std::make_pair("word_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("char_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("line_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("heading_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("code_block_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("link_count", Value::BIGINT(0)));
-				    struct_values.push_back(std::make_pair("reading_time_minutes", Value::DOUBLE(0.0)));
-
-				    result.SetValue(row_idx, Value::STRUCT(struct_values));
+				    result.SetValue(row_idx, markdown_utils::StatsToStruct(markdown_utils::MarkdownStats {}));
 			    }
 		    }
 	    });
@@ -228,62 +488,13 @@ void MarkdownFunctions::RegisterStatsFunctions(ExtensionLoader &loader) {
 	// include_subsections=true uses 'full' mode, false uses 'minimal' mode
 	ScalarFunction md_extract_section_with_subsections(
 	    "md_extract_section", {markdown_type, LogicalType::VARCHAR, LogicalType::BOOLEAN}, markdown_type,
-	    [](DataChunk &args, ExpressionState &state, Vector &result) {
-		    auto &markdown_vector = args.data[0];
-		    auto &section_id_vector = args.data[1];
-		    auto &include_subsections_vector = args.data[2];
-
-		    for (idx_t i = 0; i < args.size(); i++) {
-			    auto md_value = markdown_vector.GetValue(i);
-			    auto section_id_value = section_id_vector.GetValue(i);
-			    auto include_subsections_value = include_subsections_vector.GetValue(i);
-
-			    if (md_value.IsNull() || section_id_value.IsNull()) {
-				    result.SetValue(i, Value());
-				    continue;
-			    }
-
-			    std::string markdown_str = md_value.ToString();
-			    std::string section_id_str = section_id_value.ToString();
-			    bool include_subsections =
-			        include_subsections_value.IsNull() ? false : include_subsections_value.GetValue<bool>();
-
-			    if (markdown_str.empty() || section_id_str.empty()) {
-				    result.SetValue(i, Value(""));
-				    continue;
-			    }
-
-			    try {
-				    const std::string section_content =
-				        markdown_utils::ExtractSection(markdown_str, section_id_str, include_subsections);
-				    result.SetValue(i, Value(section_content));
-			    } catch (const std::exception &e) {
-				    result.SetValue(i, Value(""));
-			    }
-		    }
-	    });
+	    ExtractSectionVaryingFunction, ExtractSectionBind);
 
 	loader.RegisterFunction(md_extract_section_with_subsections);
 
 	// Register md_section_breadcrumb function
-	ScalarFunction md_section_breadcrumb(
-	    "md_section_breadcrumb", {LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
-	    [](DataChunk &args, ExpressionState &state, Vector &result) {
-		    auto &file_path_vector = args.data[0];
-		    auto &section_id_vector = args.data[1];
-
-		    BinaryExecutor::Execute<string_t, string_t, string_t>(
-		        file_path_vector, section_id_vector, result, args.size(),
-		        [&](string_t file_path_str, string_t section_id_str) -> string_t {
-			        if (file_path_str.GetSize() == 0 || section_id_str.GetSize() == 0) {
-				        return string_t();
-			        }
-
-			        const std::string breadcrumb =
-			            markdown_utils::GenerateBreadcrumb(file_path_str.GetString(), section_id_str.GetString());
-			        return StringVector::AddString(result, breadcrumb);
-		        });
-	    });
+	ScalarFunction md_section_breadcrumb("md_section_breadcrumb", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                                     LogicalType::VARCHAR, BreadcrumbVaryingFunction, BreadcrumbBind);
 
 	loader.RegisterFunction(md_section_breadcrumb);
 }
@@ -324,6 +535,34 @@ void MarkdownFunctions::RegisterMetadataFunctions(ExtensionLoader &loader) {
 
 	loader.RegisterFunction(md_extract_metadata_fun);
 
+	// md_lead - title (frontmatter title or first H1) and lead paragraph for listings; parsing
+	// stops at the end of the lead paragraph instead of covering the whole document
+	ScalarFunction md_lead_fun(
+	    "md_lead", {markdown_type}, markdown_utils::LeadStructType(),
+	    [](DataChunk &args, ExpressionState &state, Vector &result) {
+		    auto &input = args.data[0];
+		    auto count = args.size();
+
+		    for (idx_t i = 0; i < count; i++) {
+			    auto md_value = input.GetValue(i);
+			    if (md_value.IsNull()) {
+				    result.SetValue(i, Value());
+				    continue;
+			    }
+
+			    auto md_str = StringValue::Get(md_value);
+			    markdown_utils::MarkdownLead lead;
+			    try {
+				    markdown_utils::ExtractLead(md_str.data(), md_str.size(), true, lead);
+			    } catch (const std::exception &e) {
+				    throw InvalidInputException("Error extracting Markdown lead: %s", e.what());
+			    }
+			    result.SetValue(i, markdown_utils::LeadToStruct(lead));
+		    }
+	    });
+
+	loader.RegisterFunction(md_lead_fun);
+
 	// md_extract_frontmatter - the RAW frontmatter block (text between the --- fences) as VARCHAR,
 	// NULL when there is no frontmatter. This is the lightweight-markdown / real-YAML seam: pair it
 	// with duckdb_yaml (yaml(...) / read_yaml_frontmatter) when you need full YAML fidelity, without
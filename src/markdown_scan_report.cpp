@@ -0,0 +1,157 @@
+#include "markdown_scan_report.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include <algorithm>
+
+namespace duckdb {
+
+static constexpr const char *MARKDOWN_SCAN_REPORT_KEY = "markdown_scan_report";
+
+// As a heap comparator this keeps the fastest retained file at the front
+static bool SlowerThan(const MarkdownFileScanStats &a, const MarkdownFileScanStats &b) {
+	return a.TotalSeconds() > b.TotalSeconds();
+}
+
+idx_t MarkdownScanReport::Capacity(ClientContext &context) {
+	Value setting;
+	if (!context.TryGetCurrentSetting(SETTING_NAME, setting) || setting.IsNull()) {
+		return 0;
+	}
+	return UBigIntValue::Get(setting.DefaultCastAs(LogicalType::UBIGINT));
+}
+
+void MarkdownScanReport::BeginScan(ClientContext &context) {
+	auto capacity = Capacity(context);
+	auto report = context.registered_state->GetOrCreate<MarkdownScanReport>(MARKDOWN_SCAN_REPORT_KEY);
+	std::lock_guard<std::mutex> guard(report->lock);
+	if (!report->new_query) {
+		return; // Another reader of the same query already started this report
+	}
+	report->new_query = false;
+	report->capacity = capacity;
+	report->slowest.clear();
+	report->errors.clear();
+}
+
+void MarkdownScanReport::Record(ClientContext &context, MarkdownFileScanStats stats) {
+	auto report = context.registered_state->Get<MarkdownScanReport>(MARKDOWN_SCAN_REPORT_KEY);
+	if (!report) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(report->lock);
+	if (report->capacity == 0) {
+		return;
+	}
+	if (!stats.error.empty()) {
+		if (report->errors.size() < report->capacity) {
+			report->errors.push_back(std::move(stats));
+		}
+		return;
+	}
+	auto &slowest = report->slowest;
+	if (slowest.size() < report->capacity) {
+		slowest.push_back(std::move(stats));
+		std::push_heap(slowest.begin(), slowest.end(), SlowerThan);
+	} else if (stats.TotalSeconds() > slowest.front().TotalSeconds()) {
+		std::pop_heap(slowest.begin(), slowest.end(), SlowerThan);
+		slowest.back() = std::move(stats);
+		std::push_heap(slowest.begin(), slowest.end(), SlowerThan);
+	}
+}
+
+vector<MarkdownFileScanStats> MarkdownScanReport::Snapshot() {
+	std::lock_guard<std::mutex> guard(lock);
+	vector<MarkdownFileScanStats> result(slowest.begin(), slowest.end());
+	result.insert(result.end(), errors.begin(), errors.end());
+	std::stable_sort(result.begin(), result.end(), SlowerThan);
+	return result;
+}
+
+void MarkdownScanReport::QueryBegin(ClientContext &context) {
+	std::lock_guard<std::mutex> guard(lock);
+	new_query = true;
+}
+
+//===--------------------------------------------------------------------===//
+// markdown_last_scan_report()
+//===--------------------------------------------------------------------===//
+
+struct MarkdownScanReportBindData : public TableFunctionData {
+	vector<MarkdownFileScanStats> files;
+};
+
+struct MarkdownScanReportState : public GlobalTableFunctionState {
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> MarkdownScanReportBind(ClientContext &context, TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<MarkdownScanReportBindData>();
+	auto report = context.registered_state->Get<MarkdownScanReport>(MARKDOWN_SCAN_REPORT_KEY);
+	if (report) {
+		result->files = report->Snapshot();
+	}
+
+	names.emplace_back("file_path");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("file_size");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("read_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("parse_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("total_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("section_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("block_count");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("error");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> MarkdownScanReportInit(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	return make_uniq<MarkdownScanReportState>();
+}
+
+static Value CountValue(const optional_idx &count) {
+	return count.IsValid() ? Value::BIGINT(static_cast<int64_t>(count.GetIndex())) : Value(LogicalType::BIGINT);
+}
+
+static void MarkdownScanReportFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &bind_data = input.bind_data->Cast<MarkdownScanReportBindData>();
+	auto &state = input.global_state->Cast<MarkdownScanReportState>();
+
+	idx_t output_idx = 0;
+	while (state.offset < bind_data.files.size() && output_idx < STANDARD_VECTOR_SIZE) {
+		const auto &file = bind_data.files[state.offset++];
+		output.data[0].SetValue(output_idx, Value(file.file_path));
+		output.data[1].SetValue(output_idx, Value::UBIGINT(file.file_size));
+		output.data[2].SetValue(output_idx, Value::DOUBLE(file.read_seconds * 1000.0));
+		output.data[3].SetValue(output_idx, Value::DOUBLE(file.parse_seconds * 1000.0));
+		output.data[4].SetValue(output_idx, Value::DOUBLE(file.TotalSeconds() * 1000.0));
+		output.data[5].SetValue(output_idx, CountValue(file.section_count));
+		output.data[6].SetValue(output_idx, CountValue(file.block_count));
+		output.data[7].SetValue(output_idx, file.error.empty() ? Value(LogicalType::VARCHAR) : Value(file.error));
+		output_idx++;
+	}
+	output.SetCardinality(output_idx);
+}
+
+void MarkdownScanReport::Register(ExtensionLoader &loader) {
+	TableFunction report_func("markdown_last_scan_report", {}, MarkdownScanReportFunction, MarkdownScanReportBind,
+	                          MarkdownScanReportInit);
+	loader.RegisterFunction(report_func);
+
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(SETTING_NAME,
+	                          "Number of slowest (and of failed) files kept per read_markdown* scan for "
+	                          "markdown_last_scan_report() (0 disables the report)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(100));
+}
+
+} // namespace duckdb
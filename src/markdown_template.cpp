@@ -0,0 +1,446 @@
+#include "markdown_template.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Compilation
+//===--------------------------------------------------------------------===//
+
+// The row type with every leaf replaced by VARCHAR; structs and lists keep their shape
+static LogicalType TemplateRenderType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::STRUCT: {
+		child_list_t<LogicalType> children;
+		for (auto &child : StructType::GetChildTypes(type)) {
+			children.emplace_back(child.first, TemplateRenderType(child.second));
+		}
+		return LogicalType::STRUCT(std::move(children));
+	}
+	case LogicalTypeId::LIST:
+		return LogicalType::LIST(TemplateRenderType(ListType::GetChildType(type)));
+	default:
+		return LogicalType::VARCHAR;
+	}
+}
+
+static bool ContainsStruct(const LogicalType &type) {
+	if (type.id() == LogicalTypeId::STRUCT) {
+		return true;
+	}
+	return type.id() == LogicalTypeId::LIST && ContainsStruct(ListType::GetChildType(type));
+}
+
+struct MarkdownTemplate::Parser {
+	enum class TokenType : uint8_t { TEXT, VALUE, TAG };
+	struct Token {
+		TokenType type;
+		string text;
+		idx_t line;
+	};
+
+	Parser(const string &source, const LogicalType &row_type_p) : row_type(row_type_p) {
+		Tokenize(source);
+	}
+
+	[[noreturn]] static void Error(idx_t line, const string &message) {
+		throw InvalidInputException("md_render template, line %llu: %s", line, message);
+	}
+
+	void Tokenize(const string &source) {
+		string text;
+		idx_t line = 1;
+		idx_t i = 0;
+		while (i < source.size()) {
+			auto open = source.find('{', i);
+			while (open != string::npos && open + 1 < source.size() && source[open + 1] != '{' &&
+			       source[open + 1] != '%' && source[open + 1] != '#') {
+				open = source.find('{', open + 1);
+			}
+			if (open == string::npos || open + 1 >= source.size()) {
+				text += source.substr(i);
+				break;
+			}
+			text += source.substr(i, open - i);
+			auto tag_line = line + static_cast<idx_t>(std::count(source.begin() + static_cast<std::ptrdiff_t>(i),
+			                                                     source.begin() + static_cast<std::ptrdiff_t>(open), '\n'));
+			auto kind = source[open + 1];
+			auto close = source.find(kind == '{' ? "}}" : kind == '%' ? "%}" : "#}", open + 2);
+			if (close == string::npos) {
+				Error(tag_line, "'" + source.substr(open, 2) + "' is never closed");
+			}
+			auto inner = source.substr(open + 2, close - open - 2);
+			StringUtil::Trim(inner);
+			auto next = close + 2;
+
+			if (kind != '{') {
+				// A block tag or comment alone on its line takes the whole line with it
+				auto line_start = source.rfind('\n', open);
+				line_start = line_start == string::npos ? 0 : line_start + 1;
+				auto after = source.find_first_not_of(" \t\r", next);
+				bool blank_before = source.find_first_not_of(" \t", line_start) >= open;
+				if (blank_before && (after == string::npos || source[after] == '\n')) {
+					text.resize(text.size() - (open - line_start));
+					next = after == string::npos ? source.size() : after + 1;
+				}
+			}
+
+			if (!text.empty()) {
+				tokens.push_back(Token {TokenType::TEXT, std::move(text), line});
+				text.clear();
+			}
+			if (kind == '{') {
+				tokens.push_back(Token {TokenType::VALUE, std::move(inner), tag_line});
+			} else if (kind == '%') {
+				tokens.push_back(Token {TokenType::TAG, std::move(inner), tag_line});
+			}
+			line = tag_line + static_cast<idx_t>(std::count(source.begin() + static_cast<std::ptrdiff_t>(open),
+			                                                source.begin() + static_cast<std::ptrdiff_t>(next), '\n'));
+			i = next;
+		}
+		if (!text.empty()) {
+			tokens.push_back(Token {TokenType::TEXT, std::move(text), line});
+		}
+	}
+
+	// Resolve a dotted name against the enclosing loop variables, then the row's fields
+	Path ResolvePath(const string &name, idx_t line) {
+		vector<string> segments {""};
+		for (auto c : name) {
+			if (c == '.') {
+				segments.emplace_back();
+			} else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+				segments.back() += c;
+			} else {
+				Error(line, StringUtil::Format("'%s' is not a field name", name));
+			}
+		}
+		for (auto &segment : segments) {
+			if (segment.empty() || std::isdigit(static_cast<unsigned char>(segment[0]))) {
+				Error(line, StringUtil::Format("'%s' is not a field name", name));
+			}
+		}
+		auto prefix = [&](idx_t count) {
+			string result = segments[0];
+			for (idx_t i = 1; i < count; i++) {
+				result += "." + segments[i];
+			}
+			return result;
+		};
+
+		Path path;
+		LogicalType type = row_type;
+		idx_t first_field = 0;
+		if (segments[0] == "loop" && !loops.empty()) {
+			static const std::pair<const char *, LoopAttribute> ATTRIBUTES[] = {
+			    {"index", LoopAttribute::INDEX}, {"index0", LoopAttribute::INDEX0}, {"first", LoopAttribute::FIRST},
+			    {"last", LoopAttribute::LAST},   {"length", LoopAttribute::LENGTH}};
+			for (auto &attribute : ATTRIBUTES) {
+				if (segments.size() == 2 && segments[1] == attribute.first) {
+					path.scope = loops.size();
+					path.loop_attribute = attribute.second;
+					path.type = attribute.second == LoopAttribute::FIRST || attribute.second == LoopAttribute::LAST
+					                ? LogicalType::BOOLEAN
+					                : LogicalType::BIGINT;
+					return path;
+				}
+			}
+			Error(line, StringUtil::Format("unknown loop attribute '%s' (expected loop.index, loop.index0, "
+			                               "loop.first, loop.last or loop.length)",
+			                               name));
+		}
+		for (idx_t depth = loops.size(); depth > 0; depth--) {
+			if (loops[depth - 1].first == segments[0]) {
+				path.scope = depth;
+				type = loops[depth - 1].second;
+				first_field = 1;
+				break;
+			}
+		}
+		for (idx_t i = first_field; i < segments.size(); i++) {
+			if (type.id() != LogicalTypeId::STRUCT) {
+				Error(line, StringUtil::Format("'%s' has no field '%s'", prefix(i), segments[i]));
+			}
+			auto &children = StructType::GetChildTypes(type);
+			idx_t field = 0;
+			while (field < children.size() && !StringUtil::CIEquals(children[field].first, segments[i])) {
+				field++;
+			}
+			if (field == children.size()) {
+				Error(line, StringUtil::Format("unknown field '%s'", prefix(i + 1)));
+			}
+			path.fields.push_back(field);
+			type = children[field].second;
+		}
+		path.type = type;
+		return path;
+	}
+
+	// {% if [not] name %} / {% elif [not] name %}, from its words
+	Node ParseIf(const vector<string> &words, idx_t line) {
+		Node node;
+		node.type = NodeType::IF;
+		node.negate = words.size() == 3 && words[1] == "not";
+		if (words.size() != (node.negate ? 3 : 2)) {
+			Error(line, StringUtil::Format("expected '{%% %s [not] field %%}'", words[0]));
+		}
+		node.path = ResolvePath(words.back(), line);
+
+		vector<string> end_words;
+		node.body = ParseBlock({"elif", "else", "endif"}, "{% if %}", line, end_words);
+		if (end_words[0] == "elif") {
+			node.else_body.push_back(ParseIf(end_words, end_line));
+		} else if (end_words[0] == "else") {
+			node.else_body = ParseBlock({"endif"}, "{% if %}", line, end_words);
+		}
+		return node;
+	}
+
+	// Nodes up to one of the end tags (the end of the template when there are none)
+	vector<Node> ParseBlock(const vector<string> &end_tags, const char *opener, idx_t opener_line,
+	                        vector<string> &end_words) {
+		vector<Node> result;
+		while (position < tokens.size()) {
+			auto &token = tokens[position++];
+			if (token.type == TokenType::TEXT) {
+				Node node;
+				node.type = NodeType::TEXT;
+				node.text = token.text;
+				result.push_back(std::move(node));
+				continue;
+			}
+			if (token.type == TokenType::VALUE) {
+				Node node;
+				node.type = NodeType::VALUE;
+				node.path = ResolvePath(token.text, token.line);
+				if (ContainsStruct(node.path.type)) {
+					Error(token.line, StringUtil::Format("'%s' is a struct; name one of its fields", token.text));
+				}
+				result.push_back(std::move(node));
+				continue;
+			}
+
+			vector<string> words;
+			for (auto &word : StringUtil::Split(StringUtil::Replace(token.text, "\t", " "), ' ')) {
+				if (!word.empty()) {
+					words.push_back(word);
+				}
+			}
+			if (words.empty()) {
+				Error(token.line, "empty '{% %}' tag");
+			}
+			if (std::find(end_tags.begin(), end_tags.end(), words[0]) != end_tags.end()) {
+				end_words = std::move(words);
+				end_line = token.line;
+				return result;
+			}
+			if (words[0] == "for") {
+				if (words.size() != 4 || words[2] != "in") {
+					Error(token.line, "expected '{% for item in list_field %}'");
+				}
+				Node node;
+				node.type = NodeType::FOR;
+				node.path = ResolvePath(words[3], token.line);
+				if (node.path.type.id() != LogicalTypeId::LIST) {
+					Error(token.line, StringUtil::Format("'%s' is not a list", words[3]));
+				}
+				loops.emplace_back(words[1], ListType::GetChildType(node.path.type));
+				vector<string> endfor;
+				node.body = ParseBlock({"endfor"}, "{% for %}", token.line, endfor);
+				loops.pop_back();
+				result.push_back(std::move(node));
+			} else if (words[0] == "if") {
+				result.push_back(ParseIf(words, token.line));
+			} else {
+				Error(token.line, StringUtil::Format("unexpected '{%% %s %%}'", words[0]));
+			}
+		}
+		if (!end_tags.empty()) {
+			Error(opener_line, StringUtil::Format("'%s' is never closed", opener));
+		}
+		return result;
+	}
+
+	LogicalType row_type;
+	vector<Token> tokens;
+	idx_t position = 0;
+	idx_t end_line = 0;
+	//! Enclosing loop variables and their element types, outermost first
+	vector<std::pair<string, LogicalType>> loops;
+};
+
+MarkdownTemplate::MarkdownTemplate(const string &source, const LogicalType &row_type)
+    : render_type(TemplateRenderType(row_type)) {
+	Parser parser(source, row_type);
+	vector<string> end_words;
+	nodes = parser.ParseBlock({}, "", 0, end_words);
+}
+
+//===--------------------------------------------------------------------===//
+// Rendering
+//===--------------------------------------------------------------------===//
+
+bool MarkdownTemplate::Resolve(const Path &path, const vector<Frame> &frames,
+                               const RecursiveUnifiedVectorFormat *&format, idx_t &index) {
+	auto &frame = frames[path.scope];
+	format = frame.format;
+	auto row = frame.row;
+	for (auto field : path.fields) {
+		auto struct_index = format->unified.sel->get_index(row);
+		if (!format->unified.validity.RowIsValid(struct_index)) {
+			return false;
+		}
+		// Struct children are indexed like their parent's data
+		format = &format->children[field];
+		row = struct_index;
+	}
+	index = format->unified.sel->get_index(row);
+	return format->unified.validity.RowIsValid(index);
+}
+
+bool MarkdownTemplate::IsTruthy(const Path &path, const vector<Frame> &frames) {
+	auto &frame = frames[path.scope];
+	switch (path.loop_attribute) {
+	case LoopAttribute::INDEX0:
+		return frame.index > 0;
+	case LoopAttribute::FIRST:
+		return frame.index == 0;
+	case LoopAttribute::LAST:
+		return frame.index + 1 == frame.length;
+	case LoopAttribute::INDEX:
+	case LoopAttribute::LENGTH:
+		return true;
+	case LoopAttribute::NONE:
+		break;
+	}
+
+	const RecursiveUnifiedVectorFormat *format;
+	idx_t index;
+	if (!Resolve(path, frames, format, index)) {
+		return false;
+	}
+	if (path.type.id() == LogicalTypeId::STRUCT) {
+		return true;
+	}
+	if (path.type.id() == LogicalTypeId::LIST) {
+		return UnifiedVectorFormat::GetData<list_entry_t>(format->unified)[index].length > 0;
+	}
+	// Leaves are cast to VARCHAR: false, 0 and '' are false
+	auto value = UnifiedVectorFormat::GetData<string_t>(format->unified)[index];
+	if (path.type.id() == LogicalTypeId::BOOLEAN) {
+		return value.GetString() == "true";
+	}
+	if (path.type.IsNumeric()) {
+		auto data = value.GetData();
+		return std::any_of(data, data + value.GetSize(), [](char c) { return c != '0' && c != '.' && c != '-'; });
+	}
+	return value.GetSize() > 0;
+}
+
+// Append a leaf, or a list's elements separated by ", "
+static void AppendTemplateValue(const RecursiveUnifiedVectorFormat &format, idx_t index, string &out) {
+	if (format.logical_type.id() == LogicalTypeId::LIST) {
+		auto entry = UnifiedVectorFormat::GetData<list_entry_t>(format.unified)[index];
+		auto &child = format.children[0];
+		for (idx_t i = 0; i < entry.length; i++) {
+			if (i > 0) {
+				out += ", ";
+			}
+			auto child_index = child.unified.sel->get_index(entry.offset + i);
+			if (child.unified.validity.RowIsValid(child_index)) {
+				AppendTemplateValue(child, child_index, out);
+			}
+		}
+		return;
+	}
+	auto value = UnifiedVectorFormat::GetData<string_t>(format.unified)[index];
+	out.append(value.GetData(), value.GetSize());
+}
+
+void MarkdownTemplate::RenderNodes(const vector<Node> &nodes, vector<Frame> &frames, string &out) {
+	for (auto &node : nodes) {
+		switch (node.type) {
+		case NodeType::TEXT:
+			out += node.text;
+			break;
+		case NodeType::VALUE: {
+			auto &frame = frames[node.path.scope];
+			switch (node.path.loop_attribute) {
+			case LoopAttribute::INDEX:
+				out += std::to_string(frame.index + 1);
+				continue;
+			case LoopAttribute::INDEX0:
+				out += std::to_string(frame.index);
+				continue;
+			case LoopAttribute::LENGTH:
+				out += std::to_string(frame.length);
+				continue;
+			case LoopAttribute::FIRST:
+			case LoopAttribute::LAST:
+				out += IsTruthy(node.path, frames) ? "true" : "false";
+				continue;
+			case LoopAttribute::NONE:
+				break;
+			}
+			const RecursiveUnifiedVectorFormat *format;
+			idx_t index;
+			if (Resolve(node.path, frames, format, index)) {
+				AppendTemplateValue(*format, index, out);
+			}
+			break;
+		}
+		case NodeType::IF:
+			RenderNodes(IsTruthy(node.path, frames) != node.negate ? node.body : node.else_body, frames, out);
+			break;
+		case NodeType::FOR: {
+			const RecursiveUnifiedVectorFormat *format;
+			idx_t index;
+			if (!Resolve(node.path, frames, format, index)) {
+				break;
+			}
+			auto entry = UnifiedVectorFormat::GetData<list_entry_t>(format->unified)[index];
+			for (idx_t i = 0; i < entry.length; i++) {
+				frames.push_back(Frame {&format->children[0], entry.offset + i, i, entry.length});
+				RenderNodes(node.body, frames, out);
+				frames.pop_back();
+			}
+			break;
+		}
+		}
+	}
+}
+
+void MarkdownTemplate::Render(Vector &rows, idx_t count, Vector &result) const {
+	// A constant row renders once
+	bool constant = rows.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	auto render_count = constant ? MinValue<idx_t>(count, 1) : count;
+
+	RecursiveUnifiedVectorFormat format;
+	Vector::RecursiveToUnifiedFormat(rows, render_count, format);
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	string buffer;
+	vector<Frame> frames;
+	for (idx_t row = 0; row < render_count; row++) {
+		if (!format.unified.validity.RowIsValid(format.unified.sel->get_index(row))) {
+			result_validity.SetInvalid(row);
+			continue;
+		}
+		buffer.clear();
+		frames.assign(1, Frame {&format, row, 0, 1});
+		RenderNodes(nodes, frames, buffer);
+		result_data[row] = StringVector::AddString(result, buffer);
+	}
+	if (constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,464 @@
+#include "markdown_trigram_index.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/expression_filter.hpp"
+#include "duckdb/planner/filter/optional_filter.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Trigrams
+//===--------------------------------------------------------------------===//
+
+// Lower-case ASCII letters, and the Kelvin sign and dotted capital I, which are the only
+// code points whose Unicode lower case (what ILIKE compares) is an ASCII letter. Other
+// bytes are kept, and folding maps code point to code point, so a literal found in the
+// text is also found in the folded text and one index serves LIKE and ILIKE.
+static string FoldCase(const string &text) {
+	string folded;
+	folded.reserve(text.size());
+	for (idx_t i = 0; i < text.size(); i++) {
+		auto c = static_cast<unsigned char>(text[i]);
+		if (c >= 'A' && c <= 'Z') {
+			folded += static_cast<char>(c + ('a' - 'A'));
+		} else if (c == 0xE2 && i + 2 < text.size() && static_cast<unsigned char>(text[i + 1]) == 0x84 &&
+		           static_cast<unsigned char>(text[i + 2]) == 0xAA) {
+			folded += 'k'; // U+212A KELVIN SIGN
+			i += 2;
+		} else if (c == 0xC4 && i + 1 < text.size() && static_cast<unsigned char>(text[i + 1]) == 0xB0) {
+			folded += 'i'; // U+0130 LATIN CAPITAL LETTER I WITH DOT ABOVE
+			i++;
+		} else {
+			folded += static_cast<char>(c);
+		}
+	}
+	return folded;
+}
+
+void MarkdownTrigramIndex::ExtractTrigrams(const string &text, vector<uint32_t> &out) {
+	if (text.size() < 3) {
+		return;
+	}
+	auto folded = FoldCase(text);
+	auto start = out.size();
+	auto data = reinterpret_cast<const unsigned char *>(folded.data());
+	for (idx_t i = 0; i + 2 < folded.size(); i++) {
+		out.push_back(static_cast<uint32_t>(data[i]) << 16 | static_cast<uint32_t>(data[i + 1]) << 8 | data[i + 2]);
+	}
+	std::sort(out.begin() + static_cast<std::ptrdiff_t>(start), out.end());
+	out.erase(std::unique(out.begin() + static_cast<std::ptrdiff_t>(start), out.end()), out.end());
+}
+
+//===--------------------------------------------------------------------===//
+// Query Extraction
+//===--------------------------------------------------------------------===//
+
+static TrigramQuery AllOf(vector<TrigramQuery> operands) {
+	TrigramQuery result;
+	TrigramQuery required;
+	required.type = TrigramQuery::Type::TRIGRAMS;
+	for (auto &operand : operands) {
+		if (operand.type == TrigramQuery::Type::TRIGRAMS) {
+			required.trigrams.insert(required.trigrams.end(), operand.trigrams.begin(), operand.trigrams.end());
+		} else if (operand.type != TrigramQuery::Type::ALL) {
+			result.children.push_back(std::move(operand));
+		}
+	}
+	if (!required.trigrams.empty()) {
+		std::sort(required.trigrams.begin(), required.trigrams.end());
+		required.trigrams.erase(std::unique(required.trigrams.begin(), required.trigrams.end()),
+		                        required.trigrams.end());
+		result.children.push_back(std::move(required));
+	}
+	if (result.children.size() == 1) {
+		return std::move(result.children[0]);
+	}
+	if (!result.children.empty()) {
+		result.type = TrigramQuery::Type::AND;
+	}
+	return result;
+}
+
+static TrigramQuery AnyOf(vector<TrigramQuery> operands) {
+	TrigramQuery result;
+	for (auto &operand : operands) {
+		if (!operand.CanPrune()) {
+			return TrigramQuery();
+		}
+	}
+	if (operands.size() == 1) {
+		return std::move(operands[0]);
+	}
+	result.type = TrigramQuery::Type::OR;
+	result.children = std::move(operands);
+	return result;
+}
+
+// ILIKE lower-cases with the Unicode tables, which the index does not reproduce, so a
+// case-insensitive literal only contributes the trigrams of its ASCII runs
+static TrigramQuery LiteralQuery(const vector<string> &literals, bool case_insensitive) {
+	TrigramQuery result;
+	for (auto &literal : literals) {
+		if (!case_insensitive) {
+			MarkdownTrigramIndex::ExtractTrigrams(literal, result.trigrams);
+			continue;
+		}
+		idx_t run_start = 0;
+		for (idx_t i = 0; i <= literal.size(); i++) {
+			if (i == literal.size() || static_cast<unsigned char>(literal[i]) >= 0x80) {
+				MarkdownTrigramIndex::ExtractTrigrams(literal.substr(run_start, i - run_start), result.trigrams);
+				run_start = i + 1;
+			}
+		}
+	}
+	if (result.trigrams.empty()) {
+		return result;
+	}
+	std::sort(result.trigrams.begin(), result.trigrams.end());
+	result.trigrams.erase(std::unique(result.trigrams.begin(), result.trigrams.end()), result.trigrams.end());
+	result.type = TrigramQuery::Type::TRIGRAMS;
+	return result;
+}
+
+// Literal runs of a LIKE pattern: the text between % and _ wildcards
+static vector<string> LikeLiterals(const string &pattern, char escape, bool has_escape) {
+	vector<string> literals;
+	string current;
+	for (idx_t i = 0; i < pattern.size(); i++) {
+		char c = pattern[i];
+		if (has_escape && c == escape && i + 1 < pattern.size()) {
+			current += pattern[++i];
+		} else if (c == '%' || c == '_') {
+			literals.push_back(std::move(current));
+			current.clear();
+		} else {
+			current += c;
+		}
+	}
+	literals.push_back(std::move(current));
+	return literals;
+}
+
+static bool IsContentColumn(const Expression &expr) {
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_CAST) {
+		return IsContentColumn(*expr.Cast<BoundCastExpression>().child);
+	}
+	return expr.GetExpressionClass() == ExpressionClass::BOUND_REF;
+}
+
+static bool GetConstantString(const Expression &expr, string &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+		return false;
+	}
+	auto &value = expr.Cast<BoundConstantExpression>().value;
+	if (value.IsNull() || value.type().InternalType() != PhysicalType::VARCHAR) {
+		return false;
+	}
+	result = StringValue::Get(value);
+	return true;
+}
+
+static TrigramQuery QueryFromFunction(const BoundFunctionExpression &function) {
+	auto &name = function.function.name;
+	bool like = name == "~~" || name == "like_escape";
+	bool ilike = name == "~~*" || name == "ilike_escape";
+	bool substring = name == "contains" || name == "prefix" || name == "starts_with" || name == "suffix" ||
+	                 name == "ends_with";
+	if ((!like && !ilike && !substring) || function.children.size() < 2 || !IsContentColumn(*function.children[0])) {
+		return TrigramQuery();
+	}
+	string pattern;
+	if (!GetConstantString(*function.children[1], pattern)) {
+		return TrigramQuery();
+	}
+	if (substring) {
+		return LiteralQuery({pattern}, false);
+	}
+	string escape;
+	if (function.children.size() > 2 && (!GetConstantString(*function.children[2], escape) || escape.size() > 1)) {
+		return TrigramQuery();
+	}
+	return LiteralQuery(LikeLiterals(pattern, escape.empty() ? '\0' : escape[0], !escape.empty()), ilike);
+}
+
+static TrigramQuery QueryFromExpression(const Expression &expr) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		auto &conjunction = expr.Cast<BoundConjunctionExpression>();
+		vector<TrigramQuery> operands;
+		for (auto &child : conjunction.children) {
+			operands.push_back(QueryFromExpression(*child));
+		}
+		return expr.GetExpressionType() == ExpressionType::CONJUNCTION_AND ? AllOf(std::move(operands))
+		                                                                   : AnyOf(std::move(operands));
+	}
+	case ExpressionClass::BOUND_FUNCTION:
+		return QueryFromFunction(expr.Cast<BoundFunctionExpression>());
+	default:
+		return TrigramQuery();
+	}
+}
+
+TrigramQuery TrigramQuery::FromFilter(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant = filter.Cast<ConstantFilter>();
+		if (constant.comparison_type != ExpressionType::COMPARE_EQUAL || constant.constant.IsNull() ||
+		    constant.constant.type().InternalType() != PhysicalType::VARCHAR) {
+			return TrigramQuery();
+		}
+		return LiteralQuery({StringValue::Get(constant.constant)}, false);
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		vector<TrigramQuery> operands;
+		for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+			operands.push_back(FromFilter(*child));
+		}
+		return AllOf(std::move(operands));
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		vector<TrigramQuery> operands;
+		for (auto &child : filter.Cast<ConjunctionOrFilter>().child_filters) {
+			operands.push_back(FromFilter(*child));
+		}
+		return AnyOf(std::move(operands));
+	}
+	case TableFilterType::OPTIONAL_FILTER: {
+		auto &optional = filter.Cast<OptionalFilter>();
+		return optional.child_filter ? FromFilter(*optional.child_filter) : TrigramQuery();
+	}
+	case TableFilterType::EXPRESSION_FILTER:
+		return QueryFromExpression(*filter.Cast<ExpressionFilter>().expr);
+	default:
+		return TrigramQuery();
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Matching
+//===--------------------------------------------------------------------===//
+
+uint64_t MarkdownTrigramIndex::OptionsSignature(bool normalize_content, bool trim_trailing_whitespace,
+                                                idx_t expand_tabs, bool unicode_nfc) {
+	if (!normalize_content) {
+		return 0;
+	}
+	// The optional steps only run while normalize_content is on
+	return 1 | (trim_trailing_whitespace ? 2 : 0) | (unicode_nfc ? 4 : 0) | static_cast<uint64_t>(expand_tabs) << 8;
+}
+
+void MarkdownTrigramIndex::FileVersion(ClientContext &context, const string &path, int64_t &modified, idx_t &size) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	modified = fs.GetLastModifiedTime(*handle).value;
+	size = fs.GetFileSize(*handle);
+}
+
+idx_t MarkdownTrigramIndex::TrigramCount() const {
+	idx_t count = 0;
+	for (idx_t i = 0; i < postings.size(); i++) {
+		if (i == 0 || postings[i].trigram != postings[i - 1].trigram) {
+			count++;
+		}
+	}
+	return count;
+}
+
+idx_t MarkdownTrigramIndex::SectionSegment(const IndexedFile &file, idx_t start_line) {
+	auto it = std::lower_bound(file.section_lines.begin(), file.section_lines.end(), start_line);
+	if (it == file.section_lines.end() || *it != start_line) {
+		return DConstants::INVALID_INDEX;
+	}
+	return static_cast<idx_t>(it - file.section_lines.begin()) + 1;
+}
+
+void MarkdownTrigramIndex::MatchQuery(uint32_t file_id, const TrigramQuery &query, vector<bool> &segments) const {
+	switch (query.type) {
+	case TrigramQuery::Type::ALL:
+		return;
+	case TrigramQuery::Type::TRIGRAMS:
+		for (auto trigram : query.trigrams) {
+			vector<bool> present(segments.size(), false);
+			auto begin = std::lower_bound(postings.begin(), postings.end(), Posting {trigram, file_id, 0});
+			auto end = std::lower_bound(begin, postings.end(), Posting {trigram, file_id + 1, 0});
+			for (auto it = begin; it != end; ++it) {
+				if (it->segment < present.size()) {
+					present[it->segment] = true;
+				}
+			}
+			for (idx_t i = 0; i < segments.size(); i++) {
+				segments[i] = segments[i] && present[i];
+			}
+		}
+		return;
+	case TrigramQuery::Type::AND:
+		for (auto &child : query.children) {
+			MatchQuery(file_id, child, segments);
+		}
+		return;
+	case TrigramQuery::Type::OR: {
+		vector<bool> any(segments.size(), false);
+		for (auto &child : query.children) {
+			auto child_segments = segments;
+			MatchQuery(file_id, child, child_segments);
+			for (idx_t i = 0; i < any.size(); i++) {
+				any[i] = any[i] || child_segments[i];
+			}
+		}
+		segments = std::move(any);
+		return;
+	}
+	}
+}
+
+bool MarkdownTrigramIndex::MatchSegments(ClientContext &context, const string &path, const TrigramQuery &query,
+                                         const IndexedFile *&file, vector<bool> &segments) const {
+	auto entry = file_ids.find(path);
+	if (entry == file_ids.end()) {
+		return false;
+	}
+	file = &files[entry->second];
+	int64_t modified;
+	idx_t size;
+	try {
+		FileVersion(context, path, modified, size);
+	} catch (const std::exception &) {
+		// Let the reader report the file as it would without an index
+		return false;
+	}
+	if (modified != file->modified || size != file->size) {
+		return false;
+	}
+	segments.assign(file->section_lines.size() + 1, true);
+	MatchQuery(static_cast<uint32_t>(entry->second), query, segments);
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Serialization
+//===--------------------------------------------------------------------===//
+// "MDTRIGR1", the options signature, the files (path, modification time, size and
+// section start lines) and the postings as (trigram, file, segment) triples, all
+// fixed-width integers in host byte order.
+
+static constexpr const char *TRIGRAM_INDEX_MAGIC = "MDTRIGR1";
+static constexpr idx_t TRIGRAM_INDEX_MAGIC_SIZE = 8;
+
+template <class T>
+static void WriteInteger(string &out, T value) {
+	out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+struct TrigramIndexReader {
+	const string &data;
+	const string &path;
+	idx_t offset = 0;
+
+	void Require(idx_t size) {
+		if (size > data.size() - offset) {
+			throw InvalidInputException("Trigram index %s is truncated or corrupt", path);
+		}
+	}
+	template <class T>
+	T ReadInteger() {
+		Require(sizeof(T));
+		T value;
+		memcpy(&value, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+	string ReadString() {
+		auto size = ReadInteger<uint64_t>();
+		Require(size);
+		string value = data.substr(offset, size);
+		offset += size;
+		return value;
+	}
+};
+
+void MarkdownTrigramIndex::Write(ClientContext &context, const string &path) const {
+	string out(TRIGRAM_INDEX_MAGIC, TRIGRAM_INDEX_MAGIC_SIZE);
+	WriteInteger<uint64_t>(out, options_signature);
+	WriteInteger<uint64_t>(out, files.size());
+	for (auto &file : files) {
+		WriteInteger<uint64_t>(out, file.path.size());
+		out += file.path;
+		WriteInteger<int64_t>(out, file.modified);
+		WriteInteger<uint64_t>(out, file.size);
+		WriteInteger<uint64_t>(out, file.section_lines.size());
+		for (auto line : file.section_lines) {
+			WriteInteger<uint64_t>(out, line);
+		}
+	}
+	WriteInteger<uint64_t>(out, postings.size());
+	for (auto &posting : postings) {
+		WriteInteger<uint32_t>(out, posting.trigram);
+		WriteInteger<uint32_t>(out, posting.file);
+		WriteInteger<uint32_t>(out, posting.segment);
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto temp_path = path + ".tmp";
+	{
+		auto handle = fs.OpenFile(temp_path, FileOpenFlags::FILE_FLAGS_WRITE | FileOpenFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(reinterpret_cast<void *>(out.data()), out.size());
+		handle->Sync();
+	}
+	fs.MoveFile(temp_path, path);
+}
+
+unique_ptr<MarkdownTrigramIndex> MarkdownTrigramIndex::Load(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	auto file_size = fs.GetFileSize(*handle);
+	string data;
+	data.resize(file_size);
+	fs.Read(*handle, reinterpret_cast<void *>(data.data()), file_size);
+
+	if (data.compare(0, TRIGRAM_INDEX_MAGIC_SIZE, TRIGRAM_INDEX_MAGIC) != 0) {
+		throw InvalidInputException("%s is not a markdown trigram index", path);
+	}
+	TrigramIndexReader reader {data, path, TRIGRAM_INDEX_MAGIC_SIZE};
+	auto result = make_uniq<MarkdownTrigramIndex>();
+	result->options_signature = reader.ReadInteger<uint64_t>();
+	auto file_count = reader.ReadInteger<uint64_t>();
+	for (uint64_t i = 0; i < file_count; i++) {
+		IndexedFile file;
+		file.path = reader.ReadString();
+		file.modified = reader.ReadInteger<int64_t>();
+		file.size = reader.ReadInteger<uint64_t>();
+		auto section_count = reader.ReadInteger<uint64_t>();
+		reader.Require(section_count * sizeof(uint64_t));
+		file.section_lines.reserve(section_count);
+		for (uint64_t s = 0; s < section_count; s++) {
+			file.section_lines.push_back(reader.ReadInteger<uint64_t>());
+		}
+		result->file_ids[file.path] = result->files.size();
+		result->files.push_back(std::move(file));
+	}
+	auto posting_count = reader.ReadInteger<uint64_t>();
+	reader.Require(posting_count * 3 * sizeof(uint32_t));
+	result->postings.reserve(posting_count);
+	for (uint64_t i = 0; i < posting_count; i++) {
+		Posting posting;
+		posting.trigram = reader.ReadInteger<uint32_t>();
+		posting.file = reader.ReadInteger<uint32_t>();
+		posting.segment = reader.ReadInteger<uint32_t>();
+		if (posting.file >= result->files.size() || (i > 0 && posting < result->postings.back())) {
+			throw InvalidInputException("Trigram index %s is truncated or corrupt", path);
+		}
+		result->postings.push_back(posting);
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -1,6 +1,7 @@
 #include "markdown_types.hpp"
 #include "markdown_utils.hpp"
 #include "duck_block_functions.hpp"
+#include "duckdb/function/cast/default_casts.hpp"
 
 namespace duckdb {
 
@@ -78,20 +79,14 @@ static bool MarkdownToTextCast(Vector &source, Vector &result, idx_t count, Cast
 	return true;
 }
 
+// markdown is an alias of VARCHAR, so these share the source's data, validity and
+// string heap instead of copying every row
 static bool VarcharToMarkdownCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnaryExecutor::Execute<string_t, string_t>(source, result, count, [&](string_t str) -> string_t {
-		return StringVector::AddString(result, str);
-	});
-
-	return true;
+	return DefaultCasts::ReinterpretCast(source, result, count, parameters);
 }
 
 static bool MarkdownToVarcharCast(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	UnaryExecutor::Execute<string_t, string_t>(source, result, count, [&](string_t md_str) -> string_t {
-		return StringVector::AddString(result, md_str);
-	});
-
-	return true;
+	return DefaultCasts::ReinterpretCast(source, result, count, parameters);
 }
 
 //===--------------------------------------------------------------------===//
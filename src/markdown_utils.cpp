@@ -1,11 +1,18 @@
 #include "markdown_utils.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/exception.hpp"
+#include "markdown_index.hpp"
+#include "markdown_md4c.hpp"
+#include "markdown_simd.hpp"
+#include "utf8proc_wrapper.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <set>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 
 // Include actual Markdown parser headers
@@ -29,53 +36,6 @@ namespace markdown_utils {
 // not help. Every scanner below runs in O(n) with bounded stack usage.
 //===--------------------------------------------------------------------===//
 
-// Result of locating a leading YAML-style frontmatter block.
-struct FrontmatterMatch {
-	bool found = false;
-	size_t body_start = 0; // offset of first byte of the frontmatter body
-	size_t body_len = 0;   // length of the body (delimiters excluded)
-	size_t after_close = 0; // offset just past the closing "---"
-};
-
-// Faithful linear replacement for R"(^---\r?\n([\s\S]*?)\r?\n---)".
-// Requires the string to begin with "---" then \r?\n, then finds the earliest
-// following "\r?\n---". Returns the body between the delimiters. O(n), no
-// recursion.
-static FrontmatterMatch FindFrontmatter(const std::string &s) {
-	FrontmatterMatch m;
-	// Opening delimiter: "---" then \r?\n
-	if (s.size() < 4 || s[0] != '-' || s[1] != '-' || s[2] != '-') {
-		return m;
-	}
-	size_t p = 3;
-	if (p < s.size() && s[p] == '\r') {
-		p++;
-	}
-	if (p >= s.size() || s[p] != '\n') {
-		return m;
-	}
-	p++; // start of body
-	size_t body_start = p;
-
-	// Closing delimiter: earliest '\n' immediately followed by "---".
-	while (p < s.size()) {
-		if (s[p] == '\n' && p + 4 <= s.size() && s[p + 1] == '-' && s[p + 2] == '-' && s[p + 3] == '-') {
-			size_t body_end = p; // at the '\n'
-			// The delimiter is \r?\n, so drop a trailing '\r' from the body.
-			if (body_end > body_start && s[body_end - 1] == '\r') {
-				body_end--;
-			}
-			m.found = true;
-			m.body_start = body_start;
-			m.body_len = body_end - body_start;
-			m.after_close = p + 4; // just past the closing "---"
-			return m;
-		}
-		p++;
-	}
-	return m;
-}
-
 // JSON-escape a string per RFC 8259 for `encoding='json'` block content: the named short
 // escapes plus \u00XX for any remaining control character (< 0x20). Previously two divergent
 // copies existed — the table-cell path escaped only " \ \n, so a literal tab/CR in a cell
@@ -120,30 +80,6 @@ static std::string EscapeJSONString(const std::string &s) {
 	return out;
 }
 
-// True if a single line (without its trailing '\n') is a GFM pipe-table row:
-// starts with '|', has at least two '|', and only spaces/tabs after the last
-// '|'. Faithful to R"(\|[^\n]*\|[ \t]*)" applied per line. A trailing '\r'
-// (CRLF input) is tolerated, matching the original regex behaviour.
-static bool IsPipeTableLine(const std::string &line_in) {
-	std::string line = line_in;
-	if (!line.empty() && line.back() == '\r') {
-		line.pop_back();
-	}
-	if (line.empty() || line[0] != '|') {
-		return false;
-	}
-	size_t last = line.rfind('|');
-	if (last == 0) {
-		return false; // only one '|'
-	}
-	for (size_t i = last + 1; i < line.size(); i++) {
-		if (line[i] != ' ' && line[i] != '\t') {
-			return false;
-		}
-	}
-	return true;
-}
-
 // True if a (trimmed, non-empty) table line is an alignment/separator row:
 // contains only '-', '|', ':', and whitespace, with at least one of '-|:'.
 // Linear replacement for R"(^\s*\|?\s*[-|:\s]+\s*\|?\s*$)" restricted to the
@@ -186,6 +122,21 @@ static std::vector<std::string> SplitTableCells(const std::string &line) {
 	return cells;
 }
 
+//===--------------------------------------------------------------------===//
+// Parser Backends
+//===--------------------------------------------------------------------===//
+
+MarkdownParser ParseMarkdownParser(const std::string &name) {
+	auto lower = StringUtil::Lower(name);
+	if (lower == "cmark" || lower == "cmark-gfm") {
+		return MarkdownParser::CMARK;
+	}
+	if (lower == "md4c") {
+		return MarkdownParser::MD4C;
+	}
+	throw InvalidInputException("Unknown markdown parser: %s (expected 'cmark' or 'md4c')", name);
+}
+
 //===--------------------------------------------------------------------===//
 // Core Conversion Functions
 //===--------------------------------------------------------------------===//
@@ -345,7 +296,35 @@ Value MetadataToMap(const MarkdownMetadata &metadata) {
 	return Value::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR, std::move(keys), std::move(values));
 }
 
+LogicalType StatsStructType() {
+	child_list_t<LogicalType> stats_struct;
+	stats_struct.push_back(make_pair("word_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("char_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("line_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("heading_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("code_block_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("link_count", LogicalType(LogicalTypeId::BIGINT)));
+	stats_struct.push_back(make_pair("reading_time_minutes", LogicalType(LogicalTypeId::DOUBLE)));
+	return LogicalType::STRUCT(stats_struct);
+}
+
+Value StatsToStruct(const MarkdownStats &stats) {
+	child_list_t<Value> struct_values;
+	struct_values.push_back(std::make_pair("word_count", Value::BIGINT(stats.word_count)));
+	struct_values.push_back(std::make_pair("char_count", Value::BIGINT(stats.char_count)));
+	struct_values.push_back(std::make_pair("line_count", Value::BIGINT(stats.line_count)));
+	struct_values.push_back(std::make_pair("heading_count", Value::BIGINT(stats.heading_count)));
+	struct_values.push_back(std::make_pair("code_block_count", Value::BIGINT(stats.code_block_count)));
+	struct_values.push_back(std::make_pair("link_count", Value::BIGINT(stats.link_count)));
+	struct_values.push_back(std::make_pair("reading_time_minutes", Value::DOUBLE(stats.reading_time_minutes)));
+	return Value::STRUCT(struct_values);
+}
+
 MarkdownStats CalculateStats(const std::string &markdown_str) {
+	return CalculateStats(markdown_str, StructuralIndex(markdown_str));
+}
+
+MarkdownStats CalculateStats(const std::string &markdown_str, const StructuralIndex &index) {
 	MarkdownStats stats = {};
 
 	// Word count (approximate)
@@ -356,51 +335,20 @@ MarkdownStats CalculateStats(const std::string &markdown_str) {
 	}
 
 	stats.char_count = markdown_str.length();
-	stats.line_count = static_cast<idx_t>(std::count(markdown_str.begin(), markdown_str.end(), '\n')) + 1;
 
-	// Count headings (#17: this previously returned 0 unless the document *opened* with a
-	// heading — a single-pass `^#{1,6}` only anchors at string start). Scan line-by-line,
-	// skipping fenced code blocks. Regex-free, matching this file's linear-scanning
-	// convention (#22, ReDoS hardening).
+	// Lines, headings and fenced blocks come from the structural index. Headings (#17:
+	// this previously returned 0 unless the document *opened* with a heading) are ATX
+	// lines outside fenced code blocks; code blocks are counted by their opening fence.
+	stats.line_count = index.LineCount();
 	stats.heading_count = 0;
-	{
-		std::istringstream heading_stream(markdown_str);
-		std::string heading_line;
-		bool in_fence = false;
-		while (std::getline(heading_stream, heading_line)) {
-			// Fence toggle: optional leading whitespace then ``` or ~~~.
-			size_t p = 0;
-			while (p < heading_line.size() && (heading_line[p] == ' ' || heading_line[p] == '\t')) {
-				p++;
-			}
-			if (heading_line.compare(p, 3, "```") == 0 || heading_line.compare(p, 3, "~~~") == 0) {
-				in_fence = !in_fence;
-				continue;
-			}
-			if (in_fence) {
-				continue;
-			}
-			// Heading line: 1-6 '#' at column 0 then a space or tab.
-			size_t h = 0;
-			while (h < heading_line.size() && heading_line[h] == '#') {
-				h++;
-			}
-			if (h >= 1 && h <= 6 && h < heading_line.size() &&
-			    (heading_line[h] == ' ' || heading_line[h] == '\t')) {
-				stats.heading_count++;
-			}
-		}
-	}
-
-	// Count code fences ("```"); pairs of fences == code blocks.
-	{
-		idx_t fence_count = 0;
-		size_t pos = 0;
-		while ((pos = markdown_str.find("```", pos)) != std::string::npos) {
-			fence_count++;
-			pos += 3;
+	stats.code_block_count = 0;
+	for (idx_t line = 0; line < index.LineCount(); line++) {
+		auto flags = index.Flags(line);
+		if (flags & LINE_FENCE_OPEN) {
+			stats.code_block_count++;
+		} else if (flags & LINE_ATX_HEADING) {
+			stats.heading_count++;
 		}
-		stats.code_block_count = fence_count / 2; // Opening and closing
 	}
 
 	// Count inline links. Linear replacement for R"(\[([^\]]+)\]\([^)]+\))":
@@ -446,6 +394,109 @@ MarkdownStats CalculateStats(const std::string &markdown_str) {
 	return stats;
 }
 
+// Blank out inline code spans (`...`) so '#' inside them doesn't produce tags. Equivalent
+// to std::regex_replace on `[^`]*` : each backtick-delimited span becomes a single space.
+static std::string ScrubInlineCode(const std::string &line) {
+	std::string scrubbed;
+	scrubbed.reserve(line.size());
+	size_t k = 0;
+	while (k < line.size()) {
+		if (line[k] == '`') {
+			size_t close = line.find('`', k + 1);
+			if (close != std::string::npos) {
+				scrubbed += ' '; // replace `...` span with a single space
+				k = close + 1;
+				continue;
+			}
+			// no closing backtick: not a code span, keep the char literally
+		}
+		scrubbed += line[k];
+		k++;
+	}
+	return scrubbed;
+}
+
+TermScope ParseTermScope(const std::string &name) {
+	auto lower = StringUtil::Lower(name);
+	if (lower == "text") {
+		return TermScope::TEXT;
+	}
+	if (lower == "code") {
+		return TermScope::CODE;
+	}
+	if (lower == "headings") {
+		return TermScope::HEADINGS;
+	}
+	throw InvalidInputException("Unknown term scope: %s (expected 'text', 'code' or 'headings')", name);
+}
+
+// Blank out the parts of a prose line that are not words: link and image targets, autolinks
+// and HTML tags. Code spans are handled by ScrubInlineCode.
+static void BlankNonProse(std::string &line) {
+	size_t i = 0;
+	while (i < line.size()) {
+		size_t close = std::string::npos;
+		if (line[i] == ']' && i + 1 < line.size() && line[i + 1] == '(') {
+			close = line.find(')', i + 2);
+		} else if (line[i] == '<' && i + 1 < line.size() &&
+		           (std::isalpha(static_cast<unsigned char>(line[i + 1])) || line[i + 1] == '/')) {
+			close = line.find('>', i + 1);
+		}
+		if (close == std::string::npos) {
+			i++;
+			continue;
+		}
+		std::fill(line.begin() + static_cast<std::ptrdiff_t>(i), line.begin() + static_cast<std::ptrdiff_t>(close) + 1,
+		          ' ');
+		i = close + 1;
+	}
+}
+
+static void CountLineTerms(const char *data, size_t size, bool keep_underscore,
+                           std::unordered_map<std::string, idx_t> &term_counts) {
+	std::string term;
+	for (size_t i = 0; i < size; i++) {
+		auto c = static_cast<unsigned char>(data[i]);
+		// Multi-byte UTF-8 sequences are kept whole, so non-ASCII words stay intact
+		if (std::isalnum(c) || c >= 0x80 || (keep_underscore && c == '_')) {
+			term += static_cast<char>(c < 0x80 ? std::tolower(c) : c);
+		} else if (c == '\'' && !term.empty() && i + 1 < size && std::isalnum(static_cast<unsigned char>(data[i + 1]))) {
+			term += '\''; // don't, O'Brien
+		} else if (!term.empty()) {
+			term_counts[term]++;
+			term.clear();
+		}
+	}
+	if (!term.empty()) {
+		term_counts[term]++;
+	}
+}
+
+void CountTerms(const std::string &markdown_str, TermScope scope, std::unordered_map<std::string, idx_t> &term_counts) {
+	if (markdown_str.empty()) {
+		return;
+	}
+	StructuralIndex index(markdown_str);
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		auto flags = index.Flags(line_idx);
+		if (flags & (LINE_FRONTMATTER | LINE_FENCE)) {
+			continue;
+		}
+		if (scope == TermScope::CODE) {
+			if (flags & LINE_IN_FENCE) {
+				CountLineTerms(index.LineData(line_idx), index.LineLength(line_idx), true, term_counts);
+			}
+			continue;
+		}
+		if ((flags & LINE_IN_FENCE) || ((flags & LINE_ATX_HEADING) != 0) != (scope == TermScope::HEADINGS)) {
+			continue;
+		}
+		auto line = ScrubInlineCode(index.Line(line_idx));
+		BlankNonProse(line);
+		CountLineTerms(line.data(), line.size(), false, term_counts);
+	}
+}
+
 //===--------------------------------------------------------------------===//
 // Section Parsing
 //===--------------------------------------------------------------------===//
@@ -527,7 +578,12 @@ std::string ExtractSection(const std::string &markdown_str, const std::string &s
 // Content Extraction
 //===--------------------------------------------------------------------===//
 
-std::vector<CodeBlock> ExtractCodeBlocks(const std::string &markdown_str, const std::string &language_filter) {
+std::vector<CodeBlock> ExtractCodeBlocks(const std::string &markdown_str, const std::string &language_filter,
+                                         MarkdownParser parser) {
+	if (parser == MarkdownParser::MD4C) {
+		return markdown_md4c::ExtractCodeBlocks(markdown_str, language_filter);
+	}
+
 	std::vector<CodeBlock> code_blocks;
 
 	if (markdown_str.empty()) {
@@ -587,6 +643,70 @@ std::vector<CodeBlock> ExtractCodeBlocks(const std::string &markdown_str, const
 	return code_blocks;
 }
 
+// Whitespace-separated words per line, as prefix sums: words_before[l] counts lines 1..l
+// (same notion of a word as CalculateStats). On heading lines (0-based) the ATX marker
+// and closing sequence are not words.
+static std::vector<idx_t> LineWordPrefixSums(const std::string &text, const NewlineIndex &lines,
+                                             const std::vector<idx_t> &heading_lines) {
+	std::vector<idx_t> words_before(lines.LineCount() + 1, 0);
+	auto next_heading = heading_lines.begin();
+	for (idx_t line = 0; line < lines.LineCount(); line++) {
+		size_t start = lines.LineStart(line);
+		size_t end = lines.LineEnd(line);
+		while (next_heading != heading_lines.end() && *next_heading < line) {
+			next_heading++;
+		}
+		if (next_heading != heading_lines.end() && *next_heading == line) {
+			size_t first = start;
+			while (first < end && first - start < 3 && text[first] == ' ') {
+				first++;
+			}
+			if (first < end && text[first] == '#') {
+				start = first;
+				while (start < end && text[start] == '#') {
+					start++;
+				}
+				while (end > start && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+					end--;
+				}
+				size_t closing = end;
+				while (closing > start && text[closing - 1] == '#') {
+					closing--;
+				}
+				if (closing == start || text[closing - 1] == ' ' || text[closing - 1] == '\t') {
+					end = closing;
+				}
+			}
+		}
+		idx_t words = 0;
+		bool in_word = false;
+		for (size_t pos = start; pos < end; pos++) {
+			bool is_space = std::isspace(static_cast<unsigned char>(text[pos]));
+			words += !is_space && !in_word;
+			in_word = !is_space;
+		}
+		words_before[line + 1] = words_before[line] + words;
+	}
+	return words_before;
+}
+
+// Nested-set numbering; the parent of a section is the closest earlier one with a lower level
+static void AssignSectionTree(std::vector<MarkdownSection> &sections) {
+	std::vector<idx_t> open_sections;
+	for (idx_t i = 0; i < sections.size(); i++) {
+		while (!open_sections.empty() && sections[open_sections.back()].level >= sections[i].level) {
+			sections[open_sections.back()].tree_hi = i;
+			open_sections.pop_back();
+		}
+		sections[i].tree_lo = i + 1;
+		sections[i].depth = static_cast<int32_t>(open_sections.size()) + 1;
+		open_sections.push_back(i);
+	}
+	for (auto section_idx : open_sections) {
+		sections[section_idx].tree_hi = sections.size();
+	}
+}
+
 std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, int32_t min_level, int32_t max_level,
                                              bool include_content, const std::string &content_mode,
                                              idx_t max_content_length) {
@@ -659,6 +779,26 @@ std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, in
 		}
 	}
 
+	// Each heading's subtree runs to the next same-or-higher heading, whatever the content_mode
+	std::vector<idx_t> heading_lines;
+	std::vector<idx_t> subtree_end_lines(heading_nodes.size());
+	std::vector<size_t> open_headings;
+	for (size_t i = 0; i < heading_nodes.size(); ++i) {
+		idx_t start_line = cmark_node_get_start_line(heading_nodes[i]);
+		heading_lines.push_back(start_line - 1);
+		while (!open_headings.empty() && heading_levels[open_headings.back()] >= heading_levels[i]) {
+			subtree_end_lines[open_headings.back()] = start_line - 1;
+			open_headings.pop_back();
+		}
+		open_headings.push_back(i);
+	}
+
+	NewlineIndex lines(content);
+	for (auto i : open_headings) {
+		subtree_end_lines[i] = lines.LineCount();
+	}
+	auto words_before = LineWordPrefixSums(content, lines, heading_lines);
+
 	// Second pass: process headings and extract content
 	for (size_t i = 0; i < heading_nodes.size(); ++i) {
 		cmark_node *heading = heading_nodes[i];
@@ -729,6 +869,11 @@ std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, in
 			}
 		}
 
+		auto subtree_end_line = std::min<idx_t>(subtree_end_lines[i], lines.LineCount());
+		if (section.start_line >= 1 && section.start_line <= subtree_end_line) {
+			section.subtree_word_count = words_before[subtree_end_line] - words_before[section.start_line - 1];
+		}
+
 		// Update end_line based on stop point or document end for last section
 		if (stop_line > 0) {
 			section.end_line = stop_line;
@@ -831,6 +976,7 @@ std::vector<MarkdownSection> ExtractSections(const std::string &markdown_str, in
 		sections.push_back(section);
 	}
 
+	AssignSectionTree(sections);
 	return sections;
 }
 
@@ -1174,21 +1320,21 @@ std::vector<MarkdownBlock> ParseBlocks(const std::string &markdown_str) {
 	return blocks;
 }
 
-std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str) {
-	std::vector<MarkdownLink> links;
-
-	if (markdown_str.empty()) {
-		return links;
-	}
+std::set<std::string> ExtractReferenceUrls(const std::string &markdown_str) {
+	return ExtractReferenceUrls(markdown_str, StructuralIndex(markdown_str));
+}
 
-	// Pre-scan for reference link definitions to detect reference-style links.
+std::set<std::string> ExtractReferenceUrls(const std::string &markdown_str, const StructuralIndex &index) {
 	// Reference definitions look like: [id]: url "optional title".
 	// Linear per-line parser replacing R"(^\s*\[([^\]]+)\]:\s+<?([^\s>]+)>?)"
 	// (a single unterminated "[" line could otherwise overflow the stack).
+	// Only lines whose first non-blank byte is '[' outside fenced code can hold one.
 	std::set<std::string> reference_urls;
-	std::istringstream stream(markdown_str);
-	std::string line;
-	while (std::getline(stream, line)) {
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		if (!index.HasFlag(line_idx, LINE_BRACKET)) {
+			continue;
+		}
+		std::string line = index.Line(line_idx);
 		std::string url;
 		size_t i = 0;
 		size_t n = line.size();
@@ -1235,6 +1381,22 @@ std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str) {
 		url = line.substr(url_start, i - url_start);
 		reference_urls.insert(url);
 	}
+	return reference_urls;
+}
+
+std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str, MarkdownParser parser) {
+	if (parser == MarkdownParser::MD4C) {
+		return markdown_md4c::ExtractLinks(markdown_str);
+	}
+
+	std::vector<MarkdownLink> links;
+
+	if (markdown_str.empty()) {
+		return links;
+	}
+
+	// Pre-scan for reference link definitions to detect reference-style links.
+	auto reference_urls = ExtractReferenceUrls(markdown_str);
 
 	// Parse with cmark-gfm
 	cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
@@ -1292,7 +1454,11 @@ std::vector<MarkdownLink> ExtractLinks(const std::string &markdown_str) {
 	return links;
 }
 
-std::vector<MarkdownImage> ExtractImages(const std::string &markdown_str) {
+std::vector<MarkdownImage> ExtractImages(const std::string &markdown_str, MarkdownParser parser) {
+	if (parser == MarkdownParser::MD4C) {
+		return markdown_md4c::ExtractImages(markdown_str);
+	}
+
 	std::vector<MarkdownImage> images;
 
 	if (markdown_str.empty()) {
@@ -1348,59 +1514,44 @@ std::vector<MarkdownImage> ExtractImages(const std::string &markdown_str) {
 }
 
 std::vector<MarkdownTable> ExtractTables(const std::string &markdown_str) {
+	return ExtractTables(markdown_str, StructuralIndex(markdown_str));
+}
+
+std::vector<MarkdownTable> ExtractTables(const std::string &markdown_str, const StructuralIndex &index) {
 	std::vector<MarkdownTable> tables;
 
 	if (markdown_str.empty()) {
 		return tables;
 	}
 
-	// Locate GFM pipe-table blocks with a linear line scanner instead of a
-	// backtracking std::regex. A block is a maximal run of consecutive pipe
-	// table lines (see IsPipeTableLine); this replaces
+	// Locate GFM pipe-table blocks from the structural index: a block is a maximal
+	// run of consecutive pipe-table lines (see LINE_PIPE_TABLE). This replaces
 	// R"((?:^|\n)((?:\|[^\n]*\|[ \t]*\n?)+))" which could overflow the stack on
 	// a very long table line or many rows.
-	const std::string &s = markdown_str;
-	size_t n = s.size();
-	size_t i = 0;
-
-	while (i < n) {
-		// Current line spans [line_start, line_end); nl is the '\n' index or npos.
-		size_t line_start = i;
-		size_t nl = s.find('\n', i);
-		size_t line_end = (nl == std::string::npos) ? n : nl;
-		std::string line = s.substr(line_start, line_end - line_start);
+	idx_t line_count = index.LineCount();
+	idx_t i = 0;
 
-		if (!IsPipeTableLine(line)) {
-			i = (nl == std::string::npos) ? n : nl + 1;
+	while (i < line_count) {
+		if (!index.HasFlag(i, LINE_PIPE_TABLE)) {
+			i++;
 			continue;
 		}
 
 		// Faithful to the old regex's line_number: the match began at the '\n'
 		// preceding the block (or at offset 0), and newlines strictly before
 		// that position were counted.
-		idx_t line_number;
-		if (line_start == 0) {
-			line_number = 1;
-		} else {
-			line_number = 1 + static_cast<idx_t>(std::count(s.begin(), s.begin() + (line_start - 1), '\n'));
-		}
+		idx_t line_number = i == 0 ? 1 : i;
 
 		// Gather the maximal run of consecutive pipe-table lines.
 		std::vector<std::string> table_lines;
-		size_t j = i;
-		while (j < n) {
-			size_t ls = j;
-			size_t jnl = s.find('\n', j);
-			size_t le = (jnl == std::string::npos) ? n : jnl;
-			std::string l = s.substr(ls, le - ls);
-			if (!IsPipeTableLine(l)) {
-				break;
-			}
+		idx_t j = i;
+		while (j < line_count && index.HasFlag(j, LINE_PIPE_TABLE)) {
+			std::string l = index.Line(j);
 			StringUtil::Trim(l);
 			if (!l.empty()) {
 				table_lines.push_back(l);
 			}
-			j = (jnl == std::string::npos) ? n : jnl + 1;
+			j++;
 		}
 		i = j; // continue scanning after the block
 
@@ -1521,21 +1672,169 @@ bool ValidateInternalLink(const std::string &markdown_str, const std::string &li
 	return false;
 }
 
-std::string NormalizeMarkdown(const std::string &markdown_str) {
-	// Basic normalization - could be more sophisticated
-	std::string normalized = markdown_str;
+// Track fenced code blocks line by line (``` or ~~~, up to 3 spaces of indent).
+// Returns true if the line is itself an opening or closing fence.
+static bool UpdateFenceState(const char *line, size_t len, bool &in_fence, char &fence_char, size_t &fence_len) {
+	size_t pos = 0;
+	while (pos < len && pos < 3 && line[pos] == ' ') {
+		pos++;
+	}
+	if (pos >= len || (line[pos] != '`' && line[pos] != '~')) {
+		return false;
+	}
+	char c = line[pos];
+	size_t run = 0;
+	while (pos + run < len && line[pos + run] == c) {
+		run++;
+	}
+	if (run < 3) {
+		return false;
+	}
+	if (!in_fence) {
+		in_fence = true;
+		fence_char = c;
+		fence_len = run;
+		return true;
+	}
+	if (c == fence_char && run >= fence_len) {
+		in_fence = false;
+		return true;
+	}
+	return false;
+}
+
+// ATX heading line (up to 3 spaces of indent, then '#'); trailing spaces on it are never a hard break
+static bool IsHeadingLine(const char *line, size_t len) {
+	size_t pos = 0;
+	while (pos < len && pos < 3 && line[pos] == ' ') {
+		pos++;
+	}
+	return pos < len && line[pos] == '#';
+}
+
+// Expand tabs to the next multiple of tab_width (columns count UTF-8 code points).
+// Tabs grow the text, so unlike the other steps this one builds a new buffer.
+static void ExpandTabs(std::string &str, idx_t tab_width) {
+	std::string out;
+	out.reserve(str.size() + str.size() / 8);
+	const char *data = str.data();
+	size_t size = str.size();
+	size_t column = 0;
+	size_t pos = 0;
+	while (pos < size) {
+		auto tab = static_cast<const char *>(memchr(data + pos, '\t', size - pos));
+		size_t run_end = tab ? static_cast<size_t>(tab - data) : size;
+		// Copy the tab-free run, then recompute the column from its last line break
+		out.append(data + pos, run_end - pos);
+		size_t line_start = pos;
+		for (size_t i = run_end; i > pos; i--) {
+			if (data[i - 1] == '\n') {
+				line_start = i;
+				column = 0;
+				break;
+			}
+		}
+		for (size_t i = line_start; i < run_end; i++) {
+			column += (static_cast<uint8_t>(data[i]) & 0xC0) != 0x80;
+		}
+		if (!tab) {
+			break;
+		}
+		size_t spaces = tab_width - column % tab_width;
+		out.append(spaces, ' ');
+		column += spaces;
+		pos = run_end + 1;
+	}
+	str = std::move(out);
+}
+
+void NormalizeMarkdownInPlace(std::string &markdown_str, const NormalizeOptions &options) {
+	size_t size = markdown_str.size();
+	char *data = &markdown_str[0];
+
+	// Fast path: a clean file (no BOM, no CR, no trailing blanks when trimming) is left untouched
+	bool has_bom = size >= 3 && static_cast<uint8_t>(data[0]) == 0xEF && static_cast<uint8_t>(data[1]) == 0xBB &&
+	               static_cast<uint8_t>(data[2]) == 0xBF;
+	bool needs_pass = has_bom || markdown_simd::ContainsByte(data, size, '\r') ||
+	                  (options.trim_trailing_whitespace && markdown_simd::HasTrailingWhitespace(data, size));
+
+	if (needs_pass) {
+		// Single pass, line by line: the write cursor never passes the read cursor, so lines
+		// are compacted in place. CRLF/CR become LF; with trimming, trailing blanks are cut
+		// outside fenced code, keeping a two-space hard break where one was written.
+		size_t read = has_bom ? 3 : 0;
+		size_t write = 0;
+		bool in_fence = false;
+		char fence_char = 0;
+		size_t fence_len = 0;
+		while (read < size) {
+			size_t eol = markdown_simd::FindLineBreak(data, size, read);
+			size_t line_len = eol - read;
+			char line_break = eol < size ? data[eol] : '\0';
+			if (write != read) {
+				memmove(data + write, data + read, line_len);
+			}
+			size_t line_start = write;
+			write += line_len;
+
+			if (options.trim_trailing_whitespace) {
+				bool is_fence = UpdateFenceState(data + line_start, line_len, in_fence, fence_char, fence_len);
+				if (!in_fence || is_fence) {
+					size_t end = write;
+					while (end > line_start && (data[end - 1] == ' ' || data[end - 1] == '\t')) {
+						end--;
+					}
+					size_t spaces = 0;
+					while (write - spaces > end && data[write - spaces - 1] == ' ') {
+						spaces++;
+					}
+					bool hard_break = !is_fence && end > line_start && spaces >= 2 && eol < size &&
+					                  !IsHeadingLine(data + line_start, end - line_start);
+					write = end;
+					if (hard_break) {
+						data[write++] = ' ';
+						data[write++] = ' ';
+					}
+				}
+			}
+
+			if (eol >= size) {
+				break;
+			}
+			data[write++] = '\n';
+			read = eol + 1;
+			if (line_break == '\r' && read < size && data[read] == '\n') {
+				read++;
+			}
+		}
+		markdown_str.resize(write);
+	}
 
-	// Normalize line endings using StringUtil
-	StringUtil::Replace(normalized, "\r\n", "\n");
-	StringUtil::Replace(normalized, "\r", "\n");
+	if (options.expand_tabs > 0 && markdown_simd::ContainsByte(markdown_str.data(), markdown_str.size(), '\t')) {
+		ExpandTabs(markdown_str, options.expand_tabs);
+	}
 
-	// Note: Skip trailing whitespace removal for now as it requires regex
-	// This can be implemented later if needed
+	if (options.unicode_nfc && !markdown_simd::IsASCII(markdown_str.data(), markdown_str.size()) &&
+	    Utf8Proc::Analyze(markdown_str.data(), markdown_str.size()) == UnicodeType::UNICODE) {
+		auto normalized = Utf8Proc::Normalize(markdown_str.data(), markdown_str.size());
+		if (normalized) {
+			markdown_str.assign(normalized);
+			free(normalized);
+		}
+	}
+}
 
+std::string NormalizeMarkdown(const std::string &markdown_str, const NormalizeOptions &options) {
+	std::string normalized = markdown_str;
+	NormalizeMarkdownInPlace(normalized, options);
 	return normalized;
 }
 
 std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str) {
+	return ExtractWikilinks(markdown_str, StructuralIndex(markdown_str));
+}
+
+std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str, const StructuralIndex &index) {
 	std::vector<MarkdownWikilink> wikilinks;
 	if (markdown_str.empty()) {
 		return wikilinks;
@@ -1547,11 +1846,12 @@ std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str)
 	// optional |alias (up to ]), then require a closing "]]". cmark-gfm does not parse
 	// wiki links, so this is a lightweight standalone pass. Equivalent to the previous
 	// regex (!?)\[\[([^\]\|#\^]+)((?:#|\^)[^\]\|]+)?(?:\|([^\]]*))?\]\].
-	std::istringstream stream(markdown_str);
-	std::string line;
-	idx_t line_number = 0;
-	while (std::getline(stream, line)) {
-		line_number++;
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		if (!index.HasFlag(line_idx, LINE_HAS_WIKILINK)) {
+			continue;
+		}
+		const std::string line = index.Line(line_idx);
+		const idx_t line_number = line_idx + 1;
 		const size_t len = line.size();
 		size_t i = 0;
 		while (i + 1 < len) {
@@ -1623,29 +1923,11 @@ std::vector<MarkdownWikilink> ExtractWikilinks(const std::string &markdown_str)
 	return wikilinks;
 }
 
-// Blank out inline code spans (`...`) so '#' inside them doesn't produce tags. Equivalent
-// to std::regex_replace on `[^`]*` : each backtick-delimited span becomes a single space.
-static std::string ScrubInlineCode(const std::string &line) {
-	std::string scrubbed;
-	scrubbed.reserve(line.size());
-	size_t k = 0;
-	while (k < line.size()) {
-		if (line[k] == '`') {
-			size_t close = line.find('`', k + 1);
-			if (close != std::string::npos) {
-				scrubbed += ' '; // replace `...` span with a single space
-				k = close + 1;
-				continue;
-			}
-			// no closing backtick: not a code span, keep the char literally
-		}
-		scrubbed += line[k];
-		k++;
-	}
-	return scrubbed;
+std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str) {
+	return ExtractTags(markdown_str, StructuralIndex(markdown_str));
 }
 
-std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str) {
+std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str, const StructuralIndex &index) {
 	std::vector<MarkdownTag> tags;
 	if (markdown_str.empty()) {
 		return tags;
@@ -1656,25 +1938,13 @@ std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str) {
 	// Linear scan (no std::regex — see #22 ReDoS hardening). A tag is '#' preceded by
 	// start-of-line or whitespace, then a letter/_ and tag chars (allowing nested '/'),
 	// excluding pure-numeric (#123) to avoid issue/anchor false positives.
-	std::istringstream stream(markdown_str);
-	std::string line;
-	idx_t line_number = 0;
-	bool in_fence = false;
-	while (std::getline(stream, line)) {
-		line_number++;
-		// Fence toggle: optional leading whitespace then ``` or ~~~.
-		size_t f = 0;
-		while (f < line.size() && std::isspace(static_cast<unsigned char>(line[f]))) {
-			f++;
-		}
-		if (line.compare(f, 3, "```") == 0 || line.compare(f, 3, "~~~") == 0) {
-			in_fence = !in_fence;
-			continue;
-		}
-		if (in_fence) {
+	// Fenced code (see LINE_FENCE) and lines without '#' are skipped.
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		if (index.InCode(line_idx) || !index.HasFlag(line_idx, LINE_HAS_HASH)) {
 			continue;
 		}
-		const std::string scrubbed = ScrubInlineCode(line);
+		const idx_t line_number = line_idx + 1;
+		const std::string scrubbed = ScrubInlineCode(index.Line(line_idx));
 		for (size_t k = 0; k < scrubbed.size(); k++) {
 			if (scrubbed[k] != '#') {
 				continue;
@@ -1710,6 +1980,846 @@ std::vector<MarkdownTag> ExtractTags(const std::string &markdown_str) {
 	return tags;
 }
 
+//===--------------------------------------------------------------------===//
+// Linting
+//===--------------------------------------------------------------------===//
+
+static const struct {
+	const char *name;
+	MarkdownLintRule rule;
+} LINT_RULES[] = {{"heading-increment", LINT_HEADING_INCREMENT},
+                  {"duplicate-heading", LINT_DUPLICATE_HEADING},
+                  {"unclosed-fence", LINT_UNCLOSED_FENCE},
+                  {"broken-reference", LINT_BROKEN_REFERENCE},
+                  {"broken-anchor", LINT_BROKEN_ANCHOR},
+                  {"trailing-whitespace", LINT_TRAILING_WHITESPACE}};
+
+static const char *LintRuleName(MarkdownLintRule rule) {
+	for (const auto &entry : LINT_RULES) {
+		if (entry.rule == rule) {
+			return entry.name;
+		}
+	}
+	return "";
+}
+
+uint32_t ParseLintRules(const std::vector<std::string> &names) {
+	uint32_t rules = 0;
+	for (const auto &name : names) {
+		auto lower = StringUtil::Lower(name);
+		bool known = false;
+		for (const auto &entry : LINT_RULES) {
+			if (lower == entry.name) {
+				rules |= entry.rule;
+				known = true;
+				break;
+			}
+		}
+		if (!known) {
+			throw InvalidInputException("Unknown lint rule: '%s'. Known: 'heading-increment', 'duplicate-heading', "
+			                            "'unclosed-fence', 'broken-reference', 'broken-anchor', 'trailing-whitespace'",
+			                            name);
+		}
+	}
+	return rules;
+}
+
+static inline bool IsLineBlank(char c) {
+	return c == ' ' || c == '\t';
+}
+
+// Heading text in line[start, end) without emphasis / code / link syntax
+static std::string HeadingPlainText(const char *line, size_t start, size_t end) {
+	std::string text;
+	text.reserve(end - start);
+	for (size_t i = start; i < end; i++) {
+		char c = line[i];
+		if (c == '*' || c == '`' || c == '[') {
+			continue;
+		}
+		// '_' delimits emphasis at a word boundary only (read_data keeps it)
+		if (c == '_' && (i == start || i + 1 == end || !std::isalnum(static_cast<unsigned char>(line[i - 1])) ||
+		                 !std::isalnum(static_cast<unsigned char>(line[i + 1])))) {
+			continue;
+		}
+		if (c == ']' && i + 1 < end && line[i + 1] == '(') {
+			auto url_end = static_cast<const char *>(memchr(line + i + 2, ')', end - i - 2));
+			if (url_end) {
+				i = static_cast<size_t>(url_end - line);
+				continue;
+			}
+		}
+		text += c;
+	}
+	return text;
+}
+
+// Title of an ATX heading line without the markers, the optional closing sequence and the
+// emphasis / code / link syntax, so that its ID matches the one of the rendered title
+static std::string AtxHeadingText(const char *line, size_t len) {
+	size_t start = 0;
+	while (start < len && line[start] == '#') {
+		start++;
+	}
+	size_t end = len;
+	while (end > start && IsLineBlank(line[end - 1])) {
+		end--;
+	}
+	size_t closing = end;
+	while (closing > start && line[closing - 1] == '#') {
+		closing--;
+	}
+	if (closing < end && (closing == start || IsLineBlank(line[closing - 1]))) {
+		end = closing;
+	}
+	return HeadingPlainText(line, start, end);
+}
+
+// Reference labels match case-insensitively with runs of whitespace collapsed
+static std::string NormalizeReferenceLabel(const std::string &label) {
+	std::string normalized;
+	bool pending_space = false;
+	for (char c : label) {
+		if (std::isspace(static_cast<unsigned char>(c))) {
+			pending_space = !normalized.empty();
+			continue;
+		}
+		if (pending_space) {
+			normalized += ' ';
+			pending_space = false;
+		}
+		normalized += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	}
+	return normalized;
+}
+
+// [label]: url — same grammar as ExtractReferenceUrls, but an empty URL still matches
+static bool ParseReferenceDefinition(const char *line, size_t len, std::string &label, std::string &url) {
+	size_t i = 0;
+	while (i < len && std::isspace(static_cast<unsigned char>(line[i]))) {
+		i++;
+	}
+	if (i >= len || line[i] != '[') {
+		return false;
+	}
+	size_t label_start = ++i;
+	while (i < len && line[i] != ']') {
+		i++;
+	}
+	if (i >= len || i == label_start || i + 1 >= len || line[i + 1] != ':') {
+		return false;
+	}
+	label.assign(line + label_start, i - label_start);
+	i += 2;
+	while (i < len && std::isspace(static_cast<unsigned char>(line[i]))) {
+		i++;
+	}
+	if (i < len && line[i] == '<') {
+		i++;
+	}
+	size_t url_start = i;
+	while (i < len && !std::isspace(static_cast<unsigned char>(line[i])) && line[i] != '>') {
+		i++;
+	}
+	url.assign(line + url_start, i - url_start);
+	return true;
+}
+
+// A heading found by the anchor scan (see Heading Anchors below): its plain text, level and 0-based line
+struct HeadingLine {
+	std::string text;
+	int32_t level;
+	idx_t line_idx;
+};
+static std::vector<HeadingLine> ScanHeadings(const StructuralIndex &index);
+static std::vector<MarkdownAnchor> AssignAnchorIds(const std::vector<HeadingLine> &headings);
+
+std::vector<MarkdownLintIssue> LintMarkdown(const std::string &markdown_str, uint32_t rules) {
+	std::vector<MarkdownLintIssue> issues;
+	if (markdown_str.empty() || rules == 0) {
+		return issues;
+	}
+
+	StructuralIndex index(markdown_str);
+	auto report = [&](MarkdownLintRule rule, idx_t line_idx, std::string message) {
+		if (rules & rule) {
+			issues.push_back({LintRuleName(rule), line_idx + 1, std::move(message)});
+		}
+	};
+	auto line_text = [&](idx_t line_idx, size_t &len) {
+		len = index.LineLength(line_idx);
+		auto data = index.LineData(line_idx);
+		if (len > 0 && data[len - 1] == '\r') {
+			len--;
+		}
+		return data;
+	};
+
+	// Headings and definitions may come after the links that use them, so links are
+	// collected during the pass and resolved at the end
+	struct LinkUse {
+		idx_t line_idx;
+		std::string target;
+	};
+	std::vector<LinkUse> reference_uses;
+	std::vector<LinkUse> anchor_uses;
+	std::set<std::string> definitions;
+
+	// Headings come from the same scan as read_markdown_anchors: ATX (indented up to three
+	// spaces) and setext, outside frontmatter, code and containers
+	auto headings = ScanHeadings(index);
+	std::set<std::string> anchors;
+	for (auto &anchor : AssignAnchorIds(headings)) {
+		anchors.insert(std::move(anchor.id));
+	}
+	std::unordered_set<idx_t> heading_lines;
+	std::unordered_map<std::string, idx_t> first_heading_line; // Base ID -> line index
+	const std::unordered_map<std::string, int32_t> no_counts;
+	int32_t previous_level = 0;
+	for (const auto &heading : headings) {
+		heading_lines.insert(heading.line_idx);
+		if (previous_level > 0 && heading.level > previous_level + 1) {
+			report(LINT_HEADING_INCREMENT, heading.line_idx,
+			       "Heading level " + std::to_string(heading.level) + " follows level " +
+			           std::to_string(previous_level));
+		}
+		previous_level = heading.level;
+
+		auto base_id = GenerateSectionId(heading.text, no_counts);
+		auto first = first_heading_line.emplace(base_id, heading.line_idx);
+		if (!first.second) {
+			report(LINT_DUPLICATE_HEADING, heading.line_idx,
+			       "Heading ID '" + base_id + "' is already used on line " + std::to_string(first.first->second + 1));
+		}
+	}
+
+	bool fence_open = false;
+	idx_t last_fence = 0;
+
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		auto flags = index.Flags(line_idx);
+		if (flags & LINE_FRONTMATTER) {
+			continue;
+		}
+		if (flags & LINE_FENCE) {
+			fence_open = (flags & LINE_FENCE_OPEN) != 0;
+			last_fence = line_idx;
+			continue;
+		}
+		if (flags & LINE_IN_FENCE) {
+			continue;
+		}
+		size_t len;
+		const char *line = line_text(line_idx, len);
+
+		if (rules & LINT_TRAILING_WHITESPACE) {
+			size_t content_end = len;
+			while (content_end > 0 && IsLineBlank(line[content_end - 1])) {
+				content_end--;
+			}
+			auto trailing = len - content_end;
+			// Two spaces after text is a hard line break, except on a heading
+			bool hard_break = trailing == 2 && content_end > 0 && line[len - 1] == ' ' && line[len - 2] == ' ' &&
+			                  heading_lines.find(line_idx) == heading_lines.end();
+			if (trailing > 0 && !hard_break) {
+				auto unit = trailing == 1 ? " character)" : " characters)";
+				report(LINT_TRAILING_WHITESPACE, line_idx, "Trailing whitespace (" + std::to_string(trailing) + unit);
+			}
+		}
+
+		if (!(rules & (LINT_BROKEN_REFERENCE | LINT_BROKEN_ANCHOR)) || !memchr(line, '[', len)) {
+			continue;
+		}
+
+		std::string label, url;
+		if ((flags & LINE_BRACKET) && ParseReferenceDefinition(line, len, label, url)) {
+			definitions.insert(NormalizeReferenceLabel(label));
+			if (label[0] == '^') {
+				continue; // Footnote definition: the rest of the line is text
+			}
+			if (url.empty()) {
+				// The destination may start on the next line
+				size_t next_len = 0;
+				bool next_has_text = false;
+				if (line_idx + 1 < index.LineCount() && !index.InCode(line_idx + 1)) {
+					const char *next = line_text(line_idx + 1, next_len);
+					for (size_t i = 0; i < next_len && !next_has_text; i++) {
+						next_has_text = !std::isspace(static_cast<unsigned char>(next[i]));
+					}
+				}
+				if (!next_has_text) {
+					report(LINT_BROKEN_REFERENCE, line_idx, "Reference definition [" + label + "] has no URL");
+				}
+			} else if (url[0] == '#') {
+				anchor_uses.push_back({line_idx, url.substr(1)});
+			}
+			continue;
+		}
+
+		// Links inside code spans are text, so they are scrubbed first
+		const std::string text = ScrubInlineCode(std::string(line, len));
+		const size_t size = text.size();
+		for (size_t i = 0; i < size; i++) {
+			if (text[i] != '[') {
+				continue;
+			}
+			if (i + 1 < size && text[i + 1] == '[') {
+				auto wikilink_end = text.find("]]", i + 2); // [[wikilinks]] resolve across documents
+				if (wikilink_end == std::string::npos) {
+					break;
+				}
+				i = wikilink_end + 1;
+				continue;
+			}
+			auto close = text.find(']', i + 1);
+			if (close == std::string::npos) {
+				break;
+			}
+			size_t next = close + 1;
+			if (next < size && text[next] == '(') {
+				size_t url_start = next + 1;
+				while (url_start < size && IsLineBlank(text[url_start])) {
+					url_start++;
+				}
+				if (url_start < size && text[url_start] == '<') {
+					url_start++;
+				}
+				size_t url_end = url_start;
+				while (url_end < size && !std::isspace(static_cast<unsigned char>(text[url_end])) &&
+				       text[url_end] != ')' && text[url_end] != '>') {
+					url_end++;
+				}
+				if (url_end > url_start && text[url_start] == '#') {
+					anchor_uses.push_back({line_idx, text.substr(url_start + 1, url_end - url_start - 1)});
+				}
+			} else if (next < size && text[next] == '[') {
+				auto label_close = text.find(']', next + 1);
+				if (label_close != std::string::npos) {
+					// [text][] is a collapsed reference: the text is the label
+					auto reference = label_close == next + 1 ? text.substr(i + 1, close - i - 1)
+					                                         : text.substr(next + 1, label_close - next - 1);
+					if (!reference.empty() && reference[0] != '^') {
+						reference_uses.push_back({line_idx, reference});
+					}
+					close = label_close;
+				}
+			}
+			i = close;
+		}
+	}
+
+	if (fence_open) {
+		report(LINT_UNCLOSED_FENCE, last_fence, "Code fence is never closed");
+	}
+	for (const auto &use : reference_uses) {
+		if (definitions.find(NormalizeReferenceLabel(use.target)) == definitions.end()) {
+			report(LINT_BROKEN_REFERENCE, use.line_idx, "No definition for reference [" + use.target + "]");
+		}
+	}
+	for (const auto &use : anchor_uses) {
+		if (!use.target.empty() && anchors.find(StringUtil::Lower(use.target)) == anchors.end()) {
+			report(LINT_BROKEN_ANCHOR, use.line_idx, "No heading with anchor '#" + use.target + "'");
+		}
+	}
+
+	std::stable_sort(issues.begin(), issues.end(),
+	                 [](const MarkdownLintIssue &a, const MarkdownLintIssue &b) { return a.line < b.line; });
+	return issues;
+}
+
+LogicalType LintIssueStructType() {
+	child_list_t<LogicalType> issue_struct;
+	issue_struct.push_back(make_pair("rule", LogicalType(LogicalTypeId::VARCHAR)));
+	issue_struct.push_back(make_pair("line", LogicalType(LogicalTypeId::BIGINT)));
+	issue_struct.push_back(make_pair("message", LogicalType(LogicalTypeId::VARCHAR)));
+	return LogicalType::STRUCT(issue_struct);
+}
+
+Value LintIssuesToList(const std::vector<MarkdownLintIssue> &issues) {
+	vector<Value> values;
+	values.reserve(issues.size());
+	for (const auto &issue : issues) {
+		child_list_t<Value> struct_values;
+		struct_values.push_back(std::make_pair("rule", Value(issue.rule)));
+		struct_values.push_back(std::make_pair("line", Value::BIGINT(static_cast<int64_t>(issue.line))));
+		struct_values.push_back(std::make_pair("message", Value(issue.message)));
+		values.push_back(Value::STRUCT(struct_values));
+	}
+	return Value::LIST(LintIssueStructType(), std::move(values));
+}
+
+//===--------------------------------------------------------------------===//
+// Lead Extraction
+//===--------------------------------------------------------------------===//
+
+// Inline text for a listing: breaks become spaces, images and raw HTML are dropped
+static void AppendLeadText(cmark_node *node, std::string &out, int depth) {
+	if (depth > MAX_INLINE_DEPTH) {
+		throw InvalidInputException("Markdown inline nesting exceeds maximum supported depth (%d)", MAX_INLINE_DEPTH);
+	}
+	for (cmark_node *child = cmark_node_first_child(node); child; child = cmark_node_next(child)) {
+		switch (cmark_node_get_type(child)) {
+		case CMARK_NODE_TEXT:
+		case CMARK_NODE_CODE: {
+			const char *literal = cmark_node_get_literal(child);
+			if (literal) {
+				out += literal;
+			}
+			break;
+		}
+		case CMARK_NODE_SOFTBREAK:
+		case CMARK_NODE_LINEBREAK:
+			out += ' ';
+			break;
+		case CMARK_NODE_IMAGE:
+		case CMARK_NODE_HTML_INLINE:
+			break;
+		default:
+			AppendLeadText(child, out, depth + 1);
+			break;
+		}
+	}
+}
+
+// Text of the first block of a heading or paragraph's source lines, with runs of
+// whitespace collapsed; empty if the block has no text (e.g. only images or link definitions)
+static std::string RenderLeadBlock(const std::string &block) {
+	cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+	cmark_parser_feed(parser, block.c_str(), block.length());
+	cmark_node *doc = cmark_parser_finish(parser);
+
+	std::string text;
+	cmark_node *first = cmark_node_first_child(doc);
+	if (first) {
+		try {
+			AppendLeadText(first, text, 0);
+		} catch (...) {
+			cmark_node_free(doc);
+			cmark_parser_free(parser);
+			throw;
+		}
+	}
+	cmark_node_free(doc);
+	cmark_parser_free(parser);
+
+	std::string result;
+	result.reserve(text.size());
+	for (char c : text) {
+		bool space = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+		if (!space) {
+			result += c;
+		} else if (!result.empty() && result.back() != ' ') {
+			result += ' ';
+		}
+	}
+	if (!result.empty() && result.back() == ' ') {
+		result.pop_back();
+	}
+	return result;
+}
+
+// ATX heading level (1-6) of a line without its indent, or 0
+static int32_t AtxHeadingLevel(const char *p, size_t len) {
+	size_t level = 0;
+	while (level < len && p[level] == '#') {
+		level++;
+	}
+	if (level == 0 || level > 6 || (level < len && !IsLineBlank(p[level]))) {
+		return 0;
+	}
+	return static_cast<int32_t>(level);
+}
+
+// Setext underline (=== or ---, trailing blanks allowed): 1 or 2, or 0
+static int32_t SetextUnderlineLevel(const char *p, size_t len) {
+	if (len == 0 || (p[0] != '=' && p[0] != '-')) {
+		return 0;
+	}
+	size_t pos = 0;
+	while (pos < len && p[pos] == p[0]) {
+		pos++;
+	}
+	while (pos < len && IsLineBlank(p[pos])) {
+		pos++;
+	}
+	if (pos < len) {
+		return 0;
+	}
+	return p[0] == '=' ? 1 : 2;
+}
+
+// Thematic break: three or more of the same '-', '*' or '_', blanks in between
+static bool IsThematicBreak(const char *p, size_t len) {
+	if (len == 0 || (p[0] != '-' && p[0] != '*' && p[0] != '_')) {
+		return false;
+	}
+	size_t marks = 0;
+	for (size_t i = 0; i < len; i++) {
+		if (p[i] == p[0]) {
+			marks++;
+		} else if (!IsLineBlank(p[i])) {
+			return false;
+		}
+	}
+	return marks >= 3;
+}
+
+// List item marker. An item interrupting a paragraph must have content, and an ordered one must start at 1.
+static bool IsListItemStart(const char *p, size_t len, bool interrupting) {
+	size_t pos = 0;
+	bool ordered = false;
+	if (len > 0 && (p[0] == '-' || p[0] == '+' || p[0] == '*')) {
+		pos = 1;
+	} else {
+		while (pos < len && pos < 9 && isdigit(static_cast<unsigned char>(p[pos]))) {
+			pos++;
+		}
+		if (pos == 0 || pos >= len || (p[pos] != '.' && p[pos] != ')')) {
+			return false;
+		}
+		ordered = true;
+		pos++;
+	}
+	if (pos < len && !IsLineBlank(p[pos])) {
+		return false;
+	}
+	if (!interrupting) {
+		return true;
+	}
+	if (ordered && !(pos == 2 && p[0] == '1')) {
+		return false;
+	}
+	while (pos < len && IsLineBlank(p[pos])) {
+		pos++;
+	}
+	return pos < len;
+}
+
+bool ExtractLead(const char *data, size_t size, bool at_eof, MarkdownLead &lead) {
+	lead = MarkdownLead();
+	size_t pos = 0;
+	if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+		pos = 3;
+	}
+
+	// Frontmatter title; the body starts on the line after the closing delimiter
+	const char *doc = data + pos;
+	size_t doc_size = size - pos;
+	if (doc_size >= 4 && memcmp(doc, "---", 3) == 0 &&
+	    (doc[3] == '\n' || (doc[3] == '\r' && doc_size >= 5 && doc[4] == '\n'))) {
+		auto fm = FindFrontmatter(doc, doc_size);
+		if (fm.found) {
+			auto metadata = ExtractMetadata(std::string(doc, fm.after_close));
+			auto title = metadata.custom_fields.find("title");
+			if (title != metadata.custom_fields.end() && !title->second.empty()) {
+				lead.has_title = true;
+				lead.title = title->second;
+			}
+			auto line_end = static_cast<const char *>(memchr(doc + fm.after_close, '\n', doc_size - fm.after_close));
+			if (!line_end && !at_eof) {
+				return false;
+			}
+			pos = line_end ? static_cast<size_t>(line_end - data) + 1 : size;
+		} else if (!at_eof) {
+			return false;
+		}
+	}
+
+	enum class Container { NONE, LIST, QUOTE, HTML };
+	Container container = Container::NONE;
+	bool after_blank = false;
+	bool in_fence = false;
+	char fence_char = 0;
+	size_t fence_len = 0;
+	std::string paragraph; // Source lines of the open paragraph
+	idx_t paragraph_lines = 0;
+	bool table = false; // The open paragraph is a pipe table
+	bool seen_heading = false;
+
+	// Settle the open paragraph; true once nothing after it can change the lead: it is
+	// the first paragraph after the first heading, or the title is already known
+	auto close_paragraph = [&]() {
+		bool has_text = false;
+		if (!paragraph.empty() && !table) {
+			auto text = RenderLeadBlock(paragraph);
+			if (!text.empty()) {
+				has_text = true;
+				if (!lead.has_summary) {
+					lead.has_summary = true;
+					lead.summary = std::move(text);
+				}
+			}
+		}
+		paragraph.clear();
+		paragraph_lines = 0;
+		table = false;
+		return has_text && (seen_heading || lead.has_title);
+	};
+	auto take_title = [&](const std::string &heading) {
+		if (!lead.has_title) {
+			lead.title = RenderLeadBlock(heading);
+			lead.has_title = !lead.title.empty();
+		}
+	};
+
+	while (pos < size) {
+		auto newline = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+		if (!newline && !at_eof) {
+			return false;
+		}
+		const char *line = data + pos;
+		size_t len = newline ? static_cast<size_t>(newline - line) : size - pos;
+		pos = newline ? pos + len + 1 : size;
+		if (len > 0 && line[len - 1] == '\r') {
+			len--;
+		}
+
+		if (in_fence) {
+			UpdateFenceState(line, len, in_fence, fence_char, fence_len);
+			continue;
+		}
+
+		size_t indent = 0;
+		size_t column = 0;
+		while (indent < len && IsLineBlank(line[indent])) {
+			column += line[indent] == '\t' ? 4 - column % 4 : 1;
+			indent++;
+		}
+		const bool blank = indent == len;
+		const char *p = line + indent;
+		const size_t rest = len - indent;
+
+		if (!paragraph.empty()) {
+			bool ends = blank;
+			if (!ends && column < 4) {
+				auto setext = SetextUnderlineLevel(p, rest);
+				if (setext > 0 && !table) {
+					// The paragraph was a heading
+					seen_heading = true;
+					if (setext == 1) {
+						take_title(paragraph + "\n" + std::string(line, len));
+					}
+					paragraph.clear();
+					paragraph_lines = 0;
+					if (lead.has_title && lead.has_summary) {
+						return true;
+					}
+					continue;
+				}
+				ends = AtxHeadingLevel(p, rest) > 0 || IsThematicBreak(p, rest) || *p == '>' ||
+				       IsListItemStart(p, rest, true) || (rest >= 3 && (memcmp(p, "```", 3) == 0 || memcmp(p, "~~~", 3) == 0));
+			}
+			if (!ends) {
+				if (paragraph_lines == 1 && paragraph.find('|') != std::string::npos &&
+				    std::string(p, rest).find('-') != std::string::npos && IsSeparatorLine(std::string(p, rest))) {
+					table = true;
+				}
+				paragraph += '\n';
+				paragraph.append(line, len);
+				paragraph_lines++;
+				continue;
+			}
+			if (close_paragraph()) {
+				return true;
+			}
+			// The line that ended the paragraph starts the next block
+		}
+
+		if (blank) {
+			after_blank = container != Container::NONE;
+			continue;
+		}
+
+		if (container != Container::NONE) {
+			bool inside = !after_blank;
+			if (after_blank) {
+				inside = (container == Container::LIST && (column >= 2 || IsListItemStart(p, rest, false))) ||
+				         (container == Container::QUOTE && *p == '>');
+			}
+			after_blank = false;
+			if (inside) {
+				UpdateFenceState(line, len, in_fence, fence_char, fence_len);
+				continue;
+			}
+			container = Container::NONE;
+		}
+
+		if (column >= 4) {
+			continue; // Indented code
+		}
+		if (UpdateFenceState(line, len, in_fence, fence_char, fence_len)) {
+			continue;
+		}
+		auto level = AtxHeadingLevel(p, rest);
+		if (level > 0) {
+			seen_heading = true;
+			if (level == 1) {
+				take_title(std::string(line, len));
+			}
+			if (lead.has_title && lead.has_summary) {
+				return true;
+			}
+			continue;
+		}
+		if (IsThematicBreak(p, rest)) {
+			continue;
+		}
+		if (*p == '>') {
+			container = Container::QUOTE;
+		} else if (IsListItemStart(p, rest, false)) {
+			container = Container::LIST;
+		} else if (*p == '<' && rest > 1 &&
+		           (isalpha(static_cast<unsigned char>(p[1])) || p[1] == '/' || p[1] == '!' || p[1] == '?')) {
+			container = Container::HTML;
+		} else {
+			paragraph.assign(line, len);
+			paragraph_lines = 1;
+		}
+	}
+
+	if (!at_eof) {
+		return false;
+	}
+	close_paragraph();
+	return true;
+}
+
+LogicalType LeadStructType() {
+	child_list_t<LogicalType> lead_struct;
+	lead_struct.push_back(make_pair("title", LogicalType(LogicalTypeId::VARCHAR)));
+	lead_struct.push_back(make_pair("summary", LogicalType(LogicalTypeId::VARCHAR)));
+	return LogicalType::STRUCT(lead_struct);
+}
+
+Value LeadToStruct(const MarkdownLead &lead) {
+	child_list_t<Value> struct_values;
+	struct_values.push_back(std::make_pair("title", lead.has_title ? Value(lead.title) : Value(LogicalType::VARCHAR)));
+	struct_values.push_back(
+	    std::make_pair("summary", lead.has_summary ? Value(lead.summary) : Value(LogicalType::VARCHAR)));
+	return Value::STRUCT(struct_values);
+}
+
+//===--------------------------------------------------------------------===//
+// Heading Anchors
+//===--------------------------------------------------------------------===//
+
+// ATX and setext headings in document order, from one pass over the index's lines
+static std::vector<HeadingLine> ScanHeadings(const StructuralIndex &index) {
+	std::vector<HeadingLine> headings;
+	auto line_text = [&](idx_t line_idx, size_t &len) {
+		len = index.LineLength(line_idx);
+		auto data = index.LineData(line_idx);
+		if (len > 0 && data[len - 1] == '\r') {
+			len--;
+		}
+		return data;
+	};
+
+	// Lines of the paragraph a setext underline would turn into a heading
+	idx_t paragraph_start = 0;
+	bool in_paragraph = false;
+	bool in_container = false;
+
+	for (idx_t line_idx = 0; line_idx < index.LineCount(); line_idx++) {
+		auto flags = index.Flags(line_idx);
+		if (flags & (LINE_FRONTMATTER | LINE_FENCE | LINE_IN_FENCE)) {
+			in_paragraph = false;
+			in_container = false;
+			continue;
+		}
+		size_t len;
+		const char *line = line_text(line_idx, len);
+		size_t column = 0;
+		while (column < len && IsLineBlank(line[column])) {
+			column++;
+		}
+		if (column == len) {
+			in_paragraph = false;
+			in_container = false;
+			continue;
+		}
+		const char *p = line + column;
+		size_t rest = len - column;
+		// ATX headings may be indented by up to three spaces, which the structural
+		// index (column 0 only) does not flag
+		auto atx_level = column < 4 ? AtxHeadingLevel(p, rest) : 0;
+		if (atx_level > 0) {
+			headings.push_back({AtxHeadingText(p, rest), atx_level, line_idx});
+			in_paragraph = false;
+			in_container = false;
+			continue;
+		}
+
+		if (in_paragraph) {
+			auto level = column < 4 ? SetextUnderlineLevel(p, rest) : 0;
+			if (level > 0) {
+				std::string text;
+				for (idx_t i = paragraph_start; i < line_idx; i++) {
+					size_t text_len;
+					const char *text_line = line_text(i, text_len);
+					size_t start = 0;
+					while (start < text_len && IsLineBlank(text_line[start])) {
+						start++;
+					}
+					while (text_len > start && IsLineBlank(text_line[text_len - 1])) {
+						text_len--;
+					}
+					if (!text.empty()) {
+						text += ' ';
+					}
+					text += HeadingPlainText(text_line, start, text_len);
+				}
+				headings.push_back({std::move(text), level, paragraph_start});
+				in_paragraph = false;
+				continue;
+			}
+		}
+		// Quotes, list items and HTML run to the next blank line (their lazy lines are not
+		// paragraphs of the document); other block starts end the paragraph
+		if (column < 4 && (*p == '>' || *p == '<' || IsListItemStart(p, rest, in_paragraph))) {
+			in_container = true;
+			in_paragraph = false;
+		} else if (in_container) {
+			continue;
+		} else if ((column < 4 && IsThematicBreak(p, rest)) || (flags & LINE_PIPE_TABLE) ||
+		           (!in_paragraph && column >= 4)) {
+			in_paragraph = false;
+		} else if (!in_paragraph) {
+			in_paragraph = true;
+			paragraph_start = line_idx;
+		}
+	}
+	return headings;
+}
+
+static std::vector<MarkdownAnchor> AssignAnchorIds(const std::vector<HeadingLine> &headings) {
+	// github-slugger: a repeated ID takes the next free -N suffix of its base, and the
+	// suffixed ID is itself taken, so "a", "a", "a-1" become a, a-1, a-1-1
+	std::vector<MarkdownAnchor> anchors;
+	std::unordered_map<std::string, int32_t> occurrences;
+	const std::unordered_map<std::string, int32_t> no_counts;
+	for (const auto &heading : headings) {
+		auto base_id = GenerateSectionId(heading.text, no_counts);
+		auto id = base_id;
+		while (occurrences.find(id) != occurrences.end()) {
+			id = base_id + "-" + std::to_string(++occurrences[base_id]);
+		}
+		occurrences[id] = 0;
+		if (!id.empty()) {
+			anchors.push_back({std::move(id), heading.level, heading.line_idx + 1});
+		}
+	}
+	return anchors;
+}
+
+std::vector<MarkdownAnchor> ExtractAnchors(const std::string &markdown_str) {
+	if (markdown_str.empty()) {
+		return {};
+	}
+	StructuralIndex index(markdown_str);
+	return AssignAnchorIds(ScanHeadings(index));
+}
+
 } // namespace markdown_utils
 
 } // namespace duckdb